@@ -0,0 +1,64 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef ANALYZERPOOL_HPP_
+#define ANALYZERPOOL_HPP_
+
+#include "LexicalAnalyzer.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Hands out warm analyzers to servers and batch workers. A released
+// analyzer is cleared, which keeps its buffers, and is handed out again;
+// at most maximumIdle analyzers are kept.
+class AnalyzerPool
+{
+public:
+	typedef std::function<void(LexicalAnalyzer&)> Configurator;
+
+	AnalyzerPool(std::size_t maximumIdle, const Configurator& configure = Configurator());
+	~AnalyzerPool();
+
+	LexicalAnalyzer* Acquire();
+	void Release(LexicalAnalyzer* lex);
+
+	std::size_t GetNumberOfCreated() const;
+	std::size_t GetNumberOfIdle() const;
+
+private:
+	AnalyzerPool(const AnalyzerPool&);
+	AnalyzerPool& operator=(const AnalyzerPool&);
+
+private:
+	std::size_t m_maximumIdle;
+	Configurator m_configure;
+	mutable std::mutex m_mutex;
+	std::vector<LexicalAnalyzer*> m_idle;
+	std::size_t m_numberOfCreated;
+};
+
+// Analyzer borrowed from a pool for the lifetime of the object.
+class PooledAnalyzer
+{
+public:
+	explicit PooledAnalyzer(AnalyzerPool& pool);
+	~PooledAnalyzer();
+
+	LexicalAnalyzer& operator*() const;
+	LexicalAnalyzer* operator->() const;
+
+private:
+	PooledAnalyzer(const PooledAnalyzer&);
+	PooledAnalyzer& operator=(const PooledAnalyzer&);
+
+private:
+	AnalyzerPool& m_pool;
+	LexicalAnalyzer* m_analyzer;
+};
+
+#endif /* ANALYZERPOOL_HPP_ */
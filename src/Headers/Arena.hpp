@@ -0,0 +1,41 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef ARENA_HPP_
+#define ARENA_HPP_
+
+#include <cstddef>
+#include <vector>
+
+// Bump allocator for byte buffers that share one lifetime. Memory is only
+// released all at once by Clear or the destructor; Reset rewinds to the
+// first block and keeps every block for reuse.
+class Arena
+{
+public:
+	explicit Arena(std::size_t blockSize = 64 * 1024);
+	~Arena();
+
+	char* Allocate(std::size_t length);
+	void Clear();
+	void Reset();
+
+	std::size_t GetMemoryUsage() const;
+
+private:
+	Arena(const Arena&);
+	Arena& operator=(const Arena&);
+
+private:
+	std::size_t m_blockSize;
+	std::vector<char*> m_blocks;
+	std::vector<std::size_t> m_blockSizes;
+	std::size_t m_nextBlock;
+	char* m_current;
+	std::size_t m_remaining;
+	std::size_t m_memoryUsage;
+};
+
+#endif /* ARENA_HPP_ */
@@ -0,0 +1,136 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef BATCHPIPELINE_HPP_
+#define BATCHPIPELINE_HPP_
+
+#include "LexicalAnalyzer.hpp"
+#include "BoundedQueue.hpp"
+#include "IoUring.hpp"
+#include "LatencyHistogram.hpp"
+#include "TraceRecorder.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Three-stage batch lexer: readers prefetch whole files into pooled buffers
+// (io_uring when available, a thread pool otherwise), workers lex the ready
+// buffers and a single writer emits the results. Stages are connected by
+// bounded queues; each stage records how long it was busy and how long it
+// waited on its neighbours. With profiling enabled every thread also records
+// per-file phase durations into its own histograms, merged after the run,
+// and optionally spans for a Chrome trace.
+class BatchPipeline
+{
+public:
+	BatchPipeline(std::size_t numberOfReaders, std::size_t numberOfWorkers, std::size_t queueDepth);
+
+	void SetLexemeFilter(LexicalAnalyzer::LexemeTypeMask filteredTypes);
+	void SetAsyncReads(bool enabled);
+	void SetTokenDictionary(bool enabled);
+	void SetProfiling(bool enabled);
+	void SetTraceFile(const std::string& traceFileName);
+
+	bool Run(const std::vector<std::string>& fileNames, std::ostream& output);
+	void DisplayUtilization(std::ostream& output);
+	void DisplayLatencies(std::ostream& output);
+
+private:
+	struct Buffer
+	{
+		std::size_t fileIndex;
+		bool success;
+		std::string data;
+	};
+
+	// A result keeps its input buffer until the writer has emitted it, so the
+	// buffer pool also bounds how many results can wait out of order.
+	struct Result
+	{
+		bool ready;
+		bool success;
+		long long formatTime;
+		Buffer* buffer;
+		std::string data;
+	};
+
+	struct StageStatistics
+	{
+		std::size_t numberOfThreads;
+		std::atomic<long long> busyTime;
+		std::atomic<long long> inputWaitTime;
+		std::atomic<long long> outputWaitTime;
+	};
+
+	enum Stage {
+		READ_STAGE,
+		LEX_STAGE,
+		WRITE_STAGE,
+		NUMBER_OF_STAGES
+	};
+
+	enum Phase {
+		READ_PHASE,
+		LEX_PHASE,
+		CLASSIFY_PHASE,
+		DICTIONARY_PHASE,
+		OUTPUT_PHASE,
+		NUMBER_OF_PHASES
+	};
+
+	struct ThreadProfile
+	{
+		LatencyHistogram latencies[NUMBER_OF_PHASES];
+		std::size_t slowestFiles[NUMBER_OF_PHASES];
+		TraceRecorder trace;
+	};
+
+	void ReadFiles(ThreadProfile* profile);
+	void ReadFilesAsync(IoUring* ring, ThreadProfile* profile);
+	void LexBuffers(ThreadProfile* profile);
+	void WriteResults(std::ostream& output, ThreadProfile* profile);
+
+	Buffer* AcquireBuffer(bool wait, ThreadProfile* profile);
+	long long PushBuffer(Buffer* buffer, ThreadProfile* profile);
+
+	void RecordPhase(ThreadProfile* profile, Phase phase, std::size_t fileIndex, long long duration);
+	void RecordSpan(ThreadProfile* profile, const char* name, long long begin, long long end, std::size_t fileIndex);
+	void RecordWait(ThreadProfile* profile, const char* name, long long begin, long long end);
+	void MergeProfiles();
+
+private:
+	std::size_t m_numberOfReaders;
+	std::size_t m_numberOfWorkers;
+	std::size_t m_queueDepth;
+	LexicalAnalyzer::LexemeTypeMask m_filteredTypes;
+	bool m_asyncReads;
+	bool m_usedAsyncReads;
+	bool m_tokenDictionary;
+	bool m_profiling;
+	std::string m_traceFileName;
+
+	std::vector<std::string> m_typeNames;
+	const std::vector<std::string>* m_fileNames;
+	std::atomic<std::size_t> m_nextFile;
+	std::vector<Buffer> m_buffers;
+	BoundedQueue<Buffer*>* m_freeBuffers;
+	BoundedQueue<Buffer*>* m_readyBuffers;
+	BoundedQueue<Result*>* m_results;
+	std::vector<Result> m_resultStorage;
+	bool m_success;
+
+	StageStatistics m_statistics[NUMBER_OF_STAGES];
+	long long m_wallTime;
+
+	std::vector<ThreadProfile> m_profiles;
+	LatencyHistogram m_latencies[NUMBER_OF_PHASES];
+	long long m_slowestDurations[NUMBER_OF_PHASES];
+	std::string m_slowestFiles[NUMBER_OF_PHASES];
+};
+
+#endif /* BATCHPIPELINE_HPP_ */
@@ -0,0 +1,112 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef BINARYSTREAM_HPP_
+#define BINARYSTREAM_HPP_
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+// Native-endian writer and bounds-checked reader for the binary formats
+// (token cache entries, index segments, wire frames).
+class BinaryWriter
+{
+public:
+	explicit BinaryWriter(std::string& data)
+		: m_data(data)
+	{
+	}
+
+	template<typename T>
+	void Write(T value)
+	{
+		m_data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	void WriteBytes(const char* bytes, std::size_t length)
+	{
+		m_data.append(bytes, length);
+	}
+
+	void WriteVarint(unsigned long long value)
+	{
+		while (value >= 0x80)
+		{
+			m_data.push_back(static_cast<char>((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+		m_data.push_back(static_cast<char>(value));
+	}
+
+private:
+	std::string& m_data;
+};
+
+class BinaryReader
+{
+public:
+	BinaryReader(const char* data, std::size_t length)
+		: m_data(data)
+		, m_length(length)
+		, m_position(0)
+	{
+	}
+
+	template<typename T>
+	bool Read(T& value)
+	{
+		if (m_length - m_position < sizeof(value))
+		{
+			return false;
+		}
+		std::memcpy(&value, m_data + m_position, sizeof(value));
+		m_position += sizeof(value);
+		return true;
+	}
+
+	bool ReadBytes(const char*& bytes, std::size_t length)
+	{
+		if (m_length - m_position < length)
+		{
+			return false;
+		}
+		bytes = m_data + m_position;
+		m_position += length;
+		return true;
+	}
+
+	bool ReadVarint(unsigned long long& value)
+	{
+		value = 0;
+		for (int shift = 0; shift < 64 && m_position < m_length; shift += 7)
+		{
+			unsigned char byte = static_cast<unsigned char>(m_data[m_position++]);
+			value |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	std::size_t GetPosition() const
+	{
+		return m_position;
+	}
+
+	std::size_t GetRemaining() const
+	{
+		return m_length - m_position;
+	}
+
+private:
+	const char* m_data;
+	std::size_t m_length;
+	std::size_t m_position;
+};
+
+#endif /* BINARYSTREAM_HPP_ */
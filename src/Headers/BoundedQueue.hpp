@@ -0,0 +1,83 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef BOUNDEDQUEUE_HPP_
+#define BOUNDEDQUEUE_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+// Blocking multi-producer multi-consumer queue. Push waits while the queue is
+// full, which is how the pipeline stages apply backpressure on each other.
+template<typename T>
+class BoundedQueue
+{
+public:
+	explicit BoundedQueue(std::size_t capacity)
+		: m_capacity(capacity == 0 ? 1 : capacity)
+		, m_closed(false)
+	{
+	}
+
+	void Push(const T& item)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (m_items.size() >= m_capacity)
+		{
+			m_notFull.wait(lock);
+		}
+		m_items.push_back(item);
+		m_notEmpty.notify_one();
+	}
+
+	bool Pop(T& item)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (m_items.empty() && !m_closed)
+		{
+			m_notEmpty.wait(lock);
+		}
+		if (m_items.empty())
+		{
+			return false;
+		}
+		item = m_items.front();
+		m_items.pop_front();
+		m_notFull.notify_one();
+		return true;
+	}
+
+	bool TryPop(T& item)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_items.empty())
+		{
+			return false;
+		}
+		item = m_items.front();
+		m_items.pop_front();
+		m_notFull.notify_one();
+		return true;
+	}
+
+	void Close()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_closed = true;
+		m_notEmpty.notify_all();
+	}
+
+private:
+	std::size_t m_capacity;
+	bool m_closed;
+	std::deque<T> m_items;
+	std::mutex m_mutex;
+	std::condition_variable m_notEmpty;
+	std::condition_variable m_notFull;
+};
+
+#endif /* BOUNDEDQUEUE_HPP_ */
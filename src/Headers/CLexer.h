@@ -0,0 +1,124 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 19.10.2026
+**************************************************************************/
+
+#ifndef CLEXER_H_
+#define CLEXER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * C interface of the lexer for embedding from other languages (ctypes, cgo).
+ * Only opaque handles, fixed-size structs and plain integers cross the
+ * boundary, and no memory is allocated per token: tokens are delivered in
+ * batches through a callback or copied into an array owned by the caller.
+ *
+ * A table holds the compiled automaton; it is immutable and can be shared by
+ * any number of analyzers on any thread. An analyzer must be used by one
+ * thread at a time.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__GNUC__)
+#define CLEXER_API __attribute__((visibility("default")))
+#else
+#define CLEXER_API
+#endif
+
+#define CLEXER_ABI_VERSION 1
+#define CLEXER_CALLBACK_BATCH_SIZE 1024
+
+typedef struct clexer_table clexer_table;
+typedef struct clexer clexer;
+
+/*
+ * offset and length locate the lexeme in the caller's buffer (a lexeme that
+ * contains line splices includes them). Equal lexemes get equal ids within
+ * an analysis and across analyses until the analyzer's id table, which is
+ * reset once it holds more than 65536 lexemes, is cleared.
+ */
+typedef struct clexer_token
+{
+	uint32_t type;
+	uint32_t length;
+	uint64_t offset;
+	uint64_t id;
+} clexer_token;
+
+enum clexer_status
+{
+	CLEXER_OK = 0,
+	CLEXER_MORE_TOKENS = 1,
+	CLEXER_STOPPED = 2,
+	CLEXER_LEXICAL_ERROR = -1,
+	CLEXER_INVALID_ARGUMENT = -2,
+	CLEXER_OUT_OF_MEMORY = -3,
+	CLEXER_INTERNAL_ERROR = -4
+};
+
+enum clexer_option
+{
+	CLEXER_OPTION_ERROR_RECOVERY = 0,
+	CLEXER_OPTION_SKIP_COMMENTS = 1,
+	CLEXER_OPTION_VALIDATE_UTF8 = 2
+};
+
+/* Receives up to CLEXER_CALLBACK_BATCH_SIZE tokens; valid during the call
+ * only. A nonzero return value stops the analysis with CLEXER_STOPPED. */
+typedef int (*clexer_token_callback)(void* context, const clexer_token* tokens, size_t count);
+
+CLEXER_API int clexer_abi_version(void);
+CLEXER_API int clexer_type_count(void);
+CLEXER_API const char* clexer_type_name(int type);
+
+CLEXER_API clexer_table* clexer_table_create(void);
+CLEXER_API const clexer_table* clexer_table_shared(void);
+CLEXER_API void clexer_table_destroy(clexer_table* table);
+
+/* table may be NULL for the process-wide shared table. Error recovery is
+ * enabled by default.
+ *
+ * With CLEXER_OPTION_VALIDATE_UTF8, ill-formed UTF-8 fails the analysis with
+ * CLEXER_LEXICAL_ERROR, or with error recovery adds one error per ill-formed
+ * sequence that no error token covers to clexer_error_count; the
+ * tokens are unchanged. */
+CLEXER_API clexer* clexer_create(const clexer_table* table);
+CLEXER_API void clexer_destroy(clexer* lexer);
+CLEXER_API int clexer_set_option(clexer* lexer, int option, int value);
+
+/* Lexes text and delivers every token through callback. */
+CLEXER_API int clexer_lex(
+	clexer* lexer,
+	const char* text,
+	size_t length,
+	clexer_token_callback callback,
+	void* context
+	);
+
+/* Lexes text and copies up to capacity tokens into tokens. When more are
+ * left, returns CLEXER_MORE_TOKENS and clexer_next_tokens continues from
+ * there; text must stay valid until the last token has been fetched. */
+CLEXER_API int clexer_lex_into(
+	clexer* lexer,
+	const char* text,
+	size_t length,
+	clexer_token* tokens,
+	size_t capacity,
+	size_t* count
+	);
+CLEXER_API int clexer_next_tokens(clexer* lexer, clexer_token* tokens, size_t capacity, size_t* count);
+
+/* Number of tokens and lexical errors of the last analysis. */
+CLEXER_API size_t clexer_token_count(const clexer* lexer);
+CLEXER_API size_t clexer_error_count(const clexer* lexer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLEXER_H_ */
@@ -0,0 +1,50 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 19.10.2026
+**************************************************************************/
+
+#ifndef CHECKPOINTINDEX_HPP_
+#define CHECKPOINTINDEX_HPP_
+
+#include "LexicalAnalyzer.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Scanner checkpoints of one input, taken during a full scan, for random
+// access into large files: the lexemes around an offset are scanned from
+// the nearest checkpoint before it instead of from the start. The side file
+// is tied to the content hash and length of the input and to the
+// configuration hash of the analyzer, and is rejected when any of them
+// changes.
+class CheckpointIndex
+{
+public:
+	static const std::size_t DEFAULT_INTERVAL = 64 * 1024;
+
+	CheckpointIndex();
+
+	void Assign(const LexicalAnalyzer& lex, const char* text, std::size_t length);
+	bool Write(const std::string& indexFileName) const;
+	bool Read(const std::string& indexFileName, const LexicalAnalyzer& lex, const char* text, std::size_t length);
+
+	bool ScanRange(
+		LexicalAnalyzer& lex,
+		const char* text,
+		std::size_t length,
+		std::size_t begin,
+		std::size_t end,
+		const LexicalAnalyzer::LexemeHandler& handler
+		) const;
+
+	std::size_t GetNumberOfCheckpoints() const;
+
+private:
+	unsigned long long m_contentHash;
+	unsigned long long m_configurationHash;
+	unsigned long long m_inputLength;
+	std::vector<LexicalAnalyzer::ScanCheckpoint> m_checkpoints;
+};
+
+#endif /* CHECKPOINTINDEX_HPP_ */
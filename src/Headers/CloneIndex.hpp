@@ -0,0 +1,100 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef CLONEINDEX_HPP_
+#define CLONEINDEX_HPP_
+
+#include "LexicalAnalyzer.hpp"
+#include "FileUtilities.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct Fingerprint
+{
+	unsigned long long hash;
+	unsigned int fileId;
+	unsigned int offset;
+};
+
+struct ClonePair
+{
+	unsigned int firstFileId;
+	unsigned int secondFileId;
+	unsigned int firstOffset;
+	unsigned int secondOffset;
+	std::size_t sharedFingerprints;
+};
+
+// Token n-gram fingerprints for clone detection. Every file is lexed
+// without comments, each window of k normalized tokens is hashed with a
+// rolling hash and the hashes are winnowed (the minimum of every window of
+// w consecutive hashes is kept), so any clone of at least k + w - 1 tokens
+// shares a fingerprint. The index file holds the file table followed by
+// the fingerprints sorted by hash.
+class CloneIndexBuilder
+{
+public:
+	CloneIndexBuilder(std::size_t gramLength, std::size_t windowLength, bool abstractIdentifiers);
+
+	bool Build(const std::vector<std::string>& fileNames, std::size_t numberOfThreads);
+	bool Write(const std::string& indexFileName) const;
+
+	std::size_t GetNumberOfTokens() const;
+	std::size_t GetNumberOfFingerprints() const;
+
+	static void FingerprintTokens(
+		const std::vector<unsigned long long>& tokenHashes,
+		const std::vector<unsigned int>& tokenOffsets,
+		unsigned int fileId,
+		std::size_t gramLength,
+		std::size_t windowLength,
+		std::vector<Fingerprint>& fingerprints
+		);
+
+private:
+	void FingerprintFiles(std::atomic<std::size_t>& nextFile, std::vector<Fingerprint>& fingerprints);
+
+private:
+	std::size_t m_gramLength;
+	std::size_t m_windowLength;
+	bool m_abstractIdentifiers;
+	std::vector<std::string> m_fileNames;
+	std::vector<Fingerprint> m_fingerprints;
+	std::atomic<std::size_t> m_numberOfTokens;
+	std::atomic<bool> m_status;
+};
+
+class CloneIndex
+{
+public:
+	CloneIndex();
+
+	bool Open(const std::string& indexFileName);
+
+	std::size_t GetGramLength() const;
+	std::size_t GetWindowLength() const;
+	std::size_t GetNumberOfFiles() const;
+	const std::string& GetFileName(unsigned int fileId) const;
+	std::size_t GetNumberOfFingerprints() const;
+
+	void Lookup(unsigned long long hash, std::vector<Fingerprint>& fingerprints) const;
+	void FindClonePairs(std::size_t minimumShared, std::size_t maximumOccurrences, std::vector<ClonePair>& pairs) const;
+
+private:
+	Fingerprint GetFingerprint(std::size_t index) const;
+
+private:
+	MappedFile m_file;
+	std::size_t m_gramLength;
+	std::size_t m_windowLength;
+	std::vector<std::string> m_fileNames;
+	const char* m_fingerprints;
+	std::size_t m_numberOfFingerprints;
+};
+
+#endif /* CLONEINDEX_HPP_ */
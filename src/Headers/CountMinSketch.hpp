@@ -0,0 +1,32 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef COUNTMINSKETCH_HPP_
+#define COUNTMINSKETCH_HPP_
+
+#include <cstddef>
+#include <vector>
+
+class CountMinSketch
+{
+public:
+	CountMinSketch(std::size_t width, std::size_t depth);
+
+	void Add(unsigned long long hash, unsigned long long count);
+	unsigned long long Estimate(unsigned long long hash) const;
+	bool Merge(const CountMinSketch& other);
+
+	std::size_t GetMemoryUsage() const;
+
+private:
+	std::size_t GetCounterIndex(unsigned long long hash, std::size_t row) const;
+
+private:
+	std::size_t m_width;
+	std::size_t m_depth;
+	std::vector<unsigned long long> m_counters;
+};
+
+#endif /* COUNTMINSKETCH_HPP_ */
@@ -0,0 +1,133 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef CROSSREFERENCEINDEX_HPP_
+#define CROSSREFERENCEINDEX_HPP_
+
+#include "FileUtilities.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct CrossReference
+{
+	unsigned int fileId;
+	unsigned long long offset;
+};
+
+// In-memory index segment: postings of every identifier, delta and varint
+// encoded as they are added. File ids are local to the segment.
+class CrossReferenceSegment
+{
+public:
+	CrossReferenceSegment();
+
+	unsigned int AddFile(const std::string& fileName);
+	void AddReference(const char* identifier, std::size_t length, unsigned int fileId, unsigned long long offset);
+
+	bool IsEmpty() const;
+	std::size_t GetMemoryUsage() const;
+	bool Write(const std::string& indexFileName) const;
+	void Clear();
+
+private:
+	struct Postings
+	{
+		std::string data;
+		unsigned int numberOfReferences;
+		unsigned int lastFileId;
+		unsigned long long lastOffset;
+	};
+
+private:
+	std::vector<std::string> m_fileNames;
+	std::unordered_map<std::string, Postings> m_postings;
+	std::string m_identifier;
+	std::size_t m_memoryUsage;
+};
+
+// Read-only view of an index file. The file ends with a fixed footer that
+// locates the file table and a directory of fixed-size entries sorted by
+// identifier, so a lookup binary-searches the mapped directory and decodes
+// a single posting list.
+class CrossReferenceIndex
+{
+public:
+	CrossReferenceIndex();
+
+	bool Open(const std::string& indexFileName);
+
+	std::size_t GetNumberOfFiles() const;
+	const std::string& GetFileName(unsigned int fileId) const;
+	std::size_t GetNumberOfIdentifiers() const;
+	std::string GetIdentifier(std::size_t index) const;
+
+	bool Lookup(const std::string& identifier, std::vector<CrossReference>& references) const;
+	bool GetReferences(std::size_t index, std::vector<CrossReference>& references) const;
+
+private:
+	struct DirectoryEntry
+	{
+		unsigned long long nameOffset;
+		unsigned int nameLength;
+		unsigned int numberOfReferences;
+		unsigned long long postingsOffset;
+		unsigned long long postingsLength;
+	};
+
+	DirectoryEntry GetDirectoryEntry(std::size_t index) const;
+
+private:
+	MappedFile m_file;
+	std::vector<std::string> m_fileNames;
+	const char* m_names;
+	const char* m_directory;
+	std::size_t m_numberOfIdentifiers;
+};
+
+// Builds an index with one lexer per thread. Each thread fills its own
+// segment and spills it to disk when it exceeds its share of the memory
+// budget; the segments are then merged into the final index.
+class CrossReferenceBuilder
+{
+public:
+	explicit CrossReferenceBuilder(std::size_t memoryBudget);
+
+	bool Build(
+		const std::vector<std::string>& fileNames,
+		std::size_t numberOfThreads,
+		const std::string& indexFileName
+		);
+
+	std::size_t GetNumberOfReferences() const;
+	std::size_t GetNumberOfSegments() const;
+
+	static bool Merge(const std::vector<std::string>& inputFileNames, const std::string& indexFileName);
+
+private:
+	void IndexFiles(
+		const std::vector<std::string>& fileNames,
+		std::atomic<std::size_t>& nextFile,
+		const std::string& segmentPrefix,
+		std::size_t memoryBudget,
+		std::vector<std::string>& segmentFileNames
+		);
+	void WriteSegment(
+		CrossReferenceSegment& segment,
+		const std::string& segmentPrefix,
+		std::vector<std::string>& segmentFileNames
+		);
+
+private:
+	std::size_t m_memoryBudget;
+	std::atomic<std::size_t> m_numberOfReferences;
+	std::size_t m_numberOfSegments;
+	std::atomic<bool> m_status;
+};
+
+#endif /* CROSSREFERENCEINDEX_HPP_ */
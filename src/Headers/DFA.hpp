@@ -6,53 +6,49 @@ Creation date: 21.02.2018
 #ifndef DFA_HPP_
 #define DFA_HPP_
 
-#include <map>
-#include <string>
-#include <fstream>
+#include <cstddef>
+#include <memory_resource>
 
+// Transition table and accepting states of an automaton. Once built the
+// automaton is only read, so one instance can be shared by any number of
+// DFACursor scanners on different threads. Rows are stored contiguously in
+// memory obtained from the resource given at construction.
 class DFA
 {
 public:
-	DFA();
-	DFA(int numberOfStates, int alphabetLength);
+	explicit DFA(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+	DFA(int numberOfStates, int alphabetLength,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 	virtual ~DFA();
 
 	void Initialize(int numberOfStates, int alphabetLength);
 	void Reset();
 
-	bool IsValidState(int state);
+	bool IsValidState(int state) const;
 
 	int GetNumberOfStates() const;
 	int GetNumberOfTransitionSymbols() const;
 
-	int GetCurrentState() const;
+	unsigned long long ComputeTableHash() const;
 
-	int GetTransition(int sourceState, int transitionSymbol);
+	int GetTransition(int sourceState, int transitionSymbol) const;
 	bool SetTransition(int sourceState, int destinationState, int transitionSymbol);
 
-	bool IsAccepting();
+	bool IsAcceptingState(int state) const;
 	void SetAcceptingState(int state);
-	void ResetState();
 
-	bool ParseLexeme(
-		std::string initialText,
-		std::string& remainingText,
-		std::string& lexeme
-		);
+	const int* GetTransitionTable() const;
+	const bool* GetAcceptingStates() const;
 
-	bool ParseLexeme(
-		std::ifstream& initialText,
-		std::string& lexeme
-		);
-
-protected:
-	void Transition(int transitionSymbol);
+private:
+	DFA(const DFA&);
+	DFA& operator=(const DFA&);
 
 protected:
+	std::pmr::memory_resource* m_resource;
 	int		m_numberOfStates;
-	int		m_currentState;
 	int		m_numberOfTransitionSymbols;
-	int**	m_transitionTable;
+	int*	m_transitionTable;
 	bool*	m_acceptingStates;
 };
 
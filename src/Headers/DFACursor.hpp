@@ -0,0 +1,73 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef DFACURSOR_HPP_
+#define DFACURSOR_HPP_
+
+#include <cstddef>
+#include <string>
+#include <fstream>
+
+#include "DFA.hpp"
+#include "SourceView.hpp"
+
+// Scan state over a shared, read-only DFA. A cursor is a few words, so each
+// thread or analyzer holds its own while the table itself is shared.
+class DFACursor
+{
+public:
+	enum ParseStatus {
+		LEXEME_ACCEPTED,
+		LEXEME_REJECTED,
+		LEXEME_INCOMPLETE
+	};
+
+	explicit DFACursor(const DFA& dfa);
+
+	int GetCurrentState() const;
+	bool IsAccepting() const;
+	void ResetState();
+	void ResetState(int initialState);
+
+	bool ParseLexeme(
+		std::string initialText,
+		std::string& remainingText,
+		std::string& lexeme
+		);
+
+	bool ParseLexeme(
+		std::ifstream& initialText,
+		std::string& lexeme
+		);
+
+	bool ParseLexeme(
+		const char* text,
+		std::size_t length,
+		std::size_t& position
+		);
+
+	bool ParseLexeme(
+		const SourceView& source,
+		std::size_t& position
+		);
+
+	ParseStatus ResumeLexeme(
+		const char* text,
+		std::size_t length,
+		std::size_t& position
+		);
+	bool FinishLexeme();
+
+private:
+	void Transition(int transitionSymbol);
+
+private:
+	const int*	m_transitionTable;
+	const bool*	m_acceptingStates;
+	int		m_numberOfTransitionSymbols;
+	int		m_currentState;
+};
+
+#endif /* DFACURSOR_HPP_ */
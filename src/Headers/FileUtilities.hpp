@@ -0,0 +1,37 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef FILEUTILITIES_HPP_
+#define FILEUTILITIES_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+bool ReadFileContents(const std::string& fileName, std::string& text);
+void CollectSourceFiles(const std::string& path, std::vector<std::string>& fileNames);
+
+class MappedFile
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	bool Open(const std::string& fileName);
+	void Close();
+
+	const char* GetData() const;
+	std::size_t GetLength() const;
+
+private:
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+private:
+	void* m_data;
+	std::size_t m_length;
+};
+
+#endif /* FILEUTILITIES_HPP_ */
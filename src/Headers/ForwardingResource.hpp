@@ -0,0 +1,36 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 19.10.2026
+**************************************************************************/
+
+#ifndef FORWARDINGRESOURCE_HPP_
+#define FORWARDINGRESOURCE_HPP_
+
+#include <cstddef>
+#include <memory_resource>
+
+// Memory resource that passes every request on to a replaceable upstream.
+// Containers built on it keep comparing equal when the upstream changes, so
+// they can still be swapped; the upstream may only be replaced once nothing
+// allocated from it is left.
+class ForwardingResource : public std::pmr::memory_resource
+{
+public:
+	explicit ForwardingResource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+	std::pmr::memory_resource* GetUpstream() const;
+	void SetUpstream(std::pmr::memory_resource* upstream);
+
+private:
+	ForwardingResource(const ForwardingResource&);
+	ForwardingResource& operator=(const ForwardingResource&);
+
+	virtual void* do_allocate(std::size_t bytes, std::size_t alignment);
+	virtual void do_deallocate(void* data, std::size_t bytes, std::size_t alignment);
+	virtual bool do_is_equal(const std::pmr::memory_resource& other) const noexcept;
+
+private:
+	std::pmr::memory_resource* m_upstream;
+};
+
+#endif /* FORWARDINGRESOURCE_HPP_ */
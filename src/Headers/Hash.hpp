@@ -0,0 +1,14 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef HASH_HPP_
+#define HASH_HPP_
+
+#include <cstddef>
+
+// 64-bit xxHash (XXH64) of a byte range.
+unsigned long long ComputeHash64(const void* data, std::size_t length, unsigned long long seed = 0);
+
+#endif /* HASH_HPP_ */
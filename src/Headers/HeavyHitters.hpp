@@ -0,0 +1,42 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef HEAVYHITTERS_HPP_
+#define HEAVYHITTERS_HPP_
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Space-Saving summary: keeps at most `capacity` counters, the smallest one
+// being replaced by every unmonitored item.
+class HeavyHitters
+{
+public:
+	explicit HeavyHitters(std::size_t capacity);
+
+	void Add(const std::string& item, unsigned long long count);
+	void Merge(const HeavyHitters& other);
+
+	std::vector<std::pair<std::string, unsigned long long> > GetTop(std::size_t count) const;
+	unsigned long long GetMinimumCount() const;
+
+private:
+	typedef std::unordered_map<std::string, unsigned long long> Counters;
+	typedef std::set<std::pair<unsigned long long, const std::string*> > CounterOrder;
+
+	void SetCount(Counters::iterator it, unsigned long long count);
+	void Insert(const std::string& item, unsigned long long count);
+
+private:
+	std::size_t m_capacity;
+	Counters m_counters;
+	CounterOrder m_order;
+};
+
+#endif /* HEAVYHITTERS_HPP_ */
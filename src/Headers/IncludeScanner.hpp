@@ -0,0 +1,50 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef INCLUDESCANNER_HPP_
+#define INCLUDESCANNER_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Extracts #include dependencies without tokenizing the whole input: the
+// text is walked just far enough to track line starts, comments, literals
+// and line splices, and only directives are parsed. Comments and splices
+// are skipped wherever the lexical analyzer skips them.
+class IncludeScanner
+{
+public:
+	struct Include
+	{
+		std::string headerName;
+		bool isSystemHeader;
+		std::size_t offset;
+	};
+
+public:
+	IncludeScanner();
+
+	bool ScanFile(const std::string& fileName);
+	void Scan(const char* text, std::size_t length);
+	void Clear();
+
+	const std::vector<Include>& GetIncludes() const;
+	void DisplayIncludes(const std::string& fileName);
+
+private:
+	std::size_t ScanDirective(const char* text, std::size_t directiveStart, std::size_t length);
+	std::size_t SkipBlanks(const char* text, std::size_t position, std::size_t length);
+	std::size_t SkipComment(const char* text, std::size_t position, std::size_t length);
+	std::size_t SkipLiteral(const char* text, std::size_t position, std::size_t length);
+	std::size_t SkipSplices(const char* text, std::size_t position, std::size_t length);
+	std::size_t GetNextCharacter(const char* text, std::size_t position, std::size_t length);
+
+private:
+	std::string m_text;
+	std::vector<Include> m_includes;
+};
+
+#endif /* INCLUDESCANNER_HPP_ */
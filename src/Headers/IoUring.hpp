@@ -0,0 +1,54 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef IOURING_HPP_
+#define IOURING_HPP_
+
+#include <cstddef>
+
+// Minimal io_uring submission/completion ring driven through the raw system
+// calls, used for asynchronous whole-file reads. Initialize fails on kernels
+// or sandboxes without io_uring, in which case callers fall back to threads.
+class IoUring
+{
+public:
+	IoUring();
+	~IoUring();
+
+	bool Initialize(unsigned int entries);
+	bool IsInitialized() const;
+	unsigned int GetNumberOfEntries() const;
+
+	bool PrepareRead(int fileDescriptor, void* buffer, unsigned int length,
+		unsigned long long offset, unsigned long long userData);
+	bool SubmitAndWait(unsigned long long& userData, int& result);
+
+private:
+	IoUring(const IoUring&);
+	IoUring& operator=(const IoUring&);
+
+	void Close();
+
+private:
+	int m_ringDescriptor;
+	unsigned int m_numberOfEntries;
+	unsigned int m_pendingSubmissions;
+	void* m_submissionRing;
+	std::size_t m_submissionRingSize;
+	void* m_completionRing;
+	std::size_t m_completionRingSize;
+	void* m_submissionEntries;
+	std::size_t m_submissionEntriesSize;
+	unsigned int* m_submissionHead;
+	unsigned int* m_submissionTail;
+	unsigned int* m_submissionMask;
+	unsigned int* m_submissionArray;
+	unsigned int* m_completionHead;
+	unsigned int* m_completionTail;
+	unsigned int* m_completionMask;
+	void* m_completionEntries;
+};
+
+#endif /* IOURING_HPP_ */
@@ -0,0 +1,47 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 19.10.2026
+**************************************************************************/
+
+#ifndef LATENCYHISTOGRAM_HPP_
+#define LATENCYHISTOGRAM_HPP_
+
+#include <cstddef>
+#include <vector>
+
+// Log-linear histogram of non-negative durations in the style of HdrHistogram:
+// every power-of-two range is split into SUB_BUCKET_COUNT / 2 linear
+// buckets, so a recorded value is reproduced within 1 / 64 of itself while
+// the whole 64-bit range needs a few thousand counters. Histograms recorded
+// by different threads are combined with Merge.
+class LatencyHistogram
+{
+public:
+	static const unsigned int SUB_BUCKET_BITS = 7;
+	static const unsigned long long SUB_BUCKET_COUNT = 1ULL << SUB_BUCKET_BITS;
+
+	LatencyHistogram();
+
+	void Record(long long value);
+	void Merge(const LatencyHistogram& other);
+	void Clear();
+
+	unsigned long long GetCount() const;
+	long long GetMinimum() const;
+	long long GetMaximum() const;
+	long long GetTotal() const;
+	long long GetPercentile(double percentile) const;
+
+private:
+	static std::size_t GetBucketIndex(unsigned long long value);
+	static unsigned long long GetBucketUpperBound(std::size_t bucketIndex);
+
+private:
+	std::vector<unsigned long long> m_counts;
+	unsigned long long m_count;
+	long long m_minimum;
+	long long m_maximum;
+	long long m_total;
+};
+
+#endif /* LATENCYHISTOGRAM_HPP_ */
@@ -0,0 +1,57 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef LEXEMESTATISTICS_HPP_
+#define LEXEMESTATISTICS_HPP_
+
+#include "CountMinSketch.hpp"
+#include "HeavyHitters.hpp"
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Per lexeme type occurrence counts. Counts are exact until their estimated
+// memory use exceeds the budget; past it, a count-min sketch answers point
+// queries and a Space-Saving summary per type tracks the most frequent lexemes.
+// The sketch and the summaries are sized to fit in the same budget.
+class LexemeStatistics
+{
+public:
+	LexemeStatistics(int numberOfLexemeTypes, std::size_t memoryBudget, std::size_t heavyHitterCapacity);
+
+	static std::size_t GetMinimumMemoryBudget(int numberOfLexemeTypes, std::size_t heavyHitterCapacity);
+
+	void Add(int lexemeType, const char* text, std::size_t length);
+	void Merge(const LexemeStatistics& other);
+
+	bool IsExact() const;
+	unsigned long long GetCount(int lexemeType, const std::string& lexeme) const;
+	unsigned long long GetTotalCount(int lexemeType) const;
+	std::vector<std::pair<std::string, unsigned long long> > GetTop(int lexemeType, std::size_t count) const;
+
+private:
+	typedef std::unordered_map<std::string, unsigned long long> ExactCounts;
+
+	void AddApproximate(int lexemeType, const std::string& lexeme, unsigned long long count);
+	void SwitchToApproximate();
+	static unsigned long long Hash(int lexemeType, const std::string& lexeme);
+
+private:
+	std::size_t m_memoryBudget;
+	std::size_t m_heavyHitterCapacity;
+	std::size_t m_sketchWidth;
+	std::size_t m_exactMemoryUsage;
+	bool m_exact;
+	std::vector<ExactCounts> m_exactCounts;
+	std::vector<unsigned long long> m_totalCounts;
+	CountMinSketch m_sketch;
+	std::vector<HeavyHitters> m_heavyHitters;
+	std::string m_lexeme;
+};
+
+#endif /* LEXEMESTATISTICS_HPP_ */
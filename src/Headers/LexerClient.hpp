@@ -0,0 +1,34 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef LEXERCLIENT_HPP_
+#define LEXERCLIENT_HPP_
+
+#include "LexerProtocol.hpp"
+
+#include <string>
+#include <vector>
+
+class LexerClient
+{
+public:
+	LexerClient();
+	~LexerClient();
+
+	bool Connect(const std::string& socketPath);
+	void Close();
+
+	bool Lex(const std::vector<LexerRequest>& requests, std::vector<LexerResponse>& responses);
+
+private:
+	LexerClient(const LexerClient&);
+	LexerClient& operator=(const LexerClient&);
+
+private:
+	int m_socket;
+	std::string m_buffer;
+};
+
+#endif /* LEXERCLIENT_HPP_ */
@@ -0,0 +1,53 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef LEXERPROTOCOL_HPP_
+#define LEXERPROTOCOL_HPP_
+
+#include "BinaryStream.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Wire format shared by LexerServer and LexerClient. Every message is a frame
+// made of a magic number and a payload length followed by the payload. A
+// request payload holds a batch of items (file paths or inline buffers), the
+// response payload holds one token stream per item, in the same order.
+enum LexerRequestKind {
+	LEXER_REQUEST_PATH,
+	LEXER_REQUEST_BUFFER
+};
+
+struct LexerRequest
+{
+	LexerRequestKind kind;
+	std::string data;
+};
+
+struct LexerToken
+{
+	int type;
+	std::size_t offset;
+	std::string text;
+};
+
+struct LexerResponse
+{
+	bool success;
+	std::vector<LexerToken> tokens;
+};
+
+bool ReadFrame(int socket, std::string& payload);
+bool WriteFrame(int socket, const std::string& payload);
+
+void EncodeRequests(const std::vector<LexerRequest>& requests, std::string& payload);
+bool DecodeRequests(const char* payload, std::size_t length, std::vector<LexerRequest>& requests);
+
+void EncodeToken(BinaryWriter& writer, int type, const char* text, std::size_t length, std::size_t offset);
+void EncodeEndOfTokens(BinaryWriter& writer);
+bool DecodeResponses(const char* payload, std::size_t length, std::vector<LexerResponse>& responses);
+
+#endif /* LEXERPROTOCOL_HPP_ */
@@ -0,0 +1,55 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef LEXERSERVER_HPP_
+#define LEXERSERVER_HPP_
+
+#include "LexicalAnalyzer.hpp"
+#include "LexerProtocol.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Long-running lexer daemon listening on a Unix domain socket. Accepted
+// connections are queued and served by a pool of workers, each owning a warm
+// LexicalAnalyzer, so requests never pay for building the transition tables.
+// Run returns once Stop is called, after the queued connections are served.
+class LexerServer
+{
+public:
+	LexerServer(const std::string& socketPath, std::size_t numberOfWorkers);
+	~LexerServer();
+
+	bool Run();
+	// Only writes to a pipe, so it may be called from a signal handler.
+	void Stop();
+
+private:
+	LexerServer(const LexerServer&);
+	LexerServer& operator=(const LexerServer&);
+
+	void ServeConnections();
+	void ServeConnection(int connection, LexicalAnalyzer& lex);
+	void HandleRequests(
+		LexicalAnalyzer& lex,
+		const std::vector<LexerRequest>& requests,
+		std::string& response
+		);
+
+private:
+	std::string m_socketPath;
+	std::size_t m_numberOfWorkers;
+	int m_listener;
+	int m_stopPipe[2];
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::deque<int> m_connections;
+};
+
+#endif /* LEXERSERVER_HPP_ */
@@ -7,11 +7,24 @@ Creation date: 21.02.2018
 #define LEXICALANALYZER_HPP_
 
 #include "DFA.hpp"
+#include "DFACursor.hpp"
+#include "LineIndex.hpp"
+#include "LexemeStatistics.hpp"
+#include "NumericLiteral.hpp"
+#include "Arena.hpp"
+#include "SpillFile.hpp"
+#include "StructuralIndex.hpp"
+#include "ForwardingResource.hpp"
 
 #include <string>
 #include <map>
 #include <vector>
 #include <fstream>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <ostream>
+#include <string_view>
 
 class LexicalAnalyzer
 {
@@ -124,10 +137,55 @@ public:
 		BITWISE_LEFT_SHIFT_OPERATOR_END,
 		BITWISE_RIGHT_SHIFT_OPERATOR_BODY,
 		BITWISE_RIGHT_SHIFT_OPERATOR_END,
+		LINE_START_STATE,
+		HEADER_NAME_INITIAL_STATE,
+		STRINGIZING_OPERATOR_BODY,
+		STRINGIZING_OPERATOR_END,
+		TOKEN_PASTING_OPERATOR_BODY,
+		TOKEN_PASTING_OPERATOR_END,
+		DIRECTIVE_BEGIN,
+		DIRECTIVE_NAME_BODY,
+		DIRECTIVE_COMMENT_BEGIN,
+		DIRECTIVE_BLOCK_COMMENT_BODY,
+		DIRECTIVE_BLOCK_COMMENT_POSSIBLE_END,
+		DIRECTIVE_LINE_COMMENT_BODY,
+		DIRECTIVE_END,
+		HEADER_NAME_BODY,
+		QUOTED_HEADER_NAME_BODY,
+		HEADER_NAME_CLOSE,
+		HEADER_NAME_END,
+		DELIMITER_DOT_BODY,
+		ZERO_LITERAL,
+		OCTAL_LITERAL,
+		HEXADECIMAL_PREFIX,
+		HEXADECIMAL_LITERAL,
+		BINARY_PREFIX,
+		BINARY_LITERAL,
+		INTEGER_SUFFIX_U,
+		INTEGER_SUFFIX_U_LOWER_L,
+		INTEGER_SUFFIX_U_UPPER_L,
+		INTEGER_SUFFIX_LOWER_L,
+		INTEGER_SUFFIX_UPPER_L,
+		INTEGER_SUFFIX_LL,
+		INTEGER_SUFFIX_COMPLETE,
+		FLOATING_LITERAL_INTEGER_PART,
+		FLOATING_LITERAL_HEXADECIMAL_FRACTION_BEGIN,
+		FLOATING_LITERAL_HEXADECIMAL_FRACTIONAL_PART,
+		FLOATING_LITERAL_SCIENTIFIC_NOTATION_SIGN,
+		FLOATING_LITERAL_SUFFIX,
+		STRING_LITERAL_ESCAPED_BODY,
+		STRING_LITERAL_ESCAPED_CLOSE,
+		STRING_LITERAL_ESCAPED_END,
+		CHAR_LITERAL_ESCAPED_BODY,
+		CHAR_LITERAL_ESCAPED_CLOSE,
+		CHAR_LITERAL_ESCAPED_END,
+		IDENTIFIER_UTF8_TAIL_1,
+		IDENTIFIER_UTF8_TAIL_2,
+		IDENTIFIER_UTF8_TAIL_3,
 		NUMBER_OF_STATES
 	};
 
-	typedef std::string Lexeme;
+	typedef std::pmr::string Lexeme;
 
 	typedef int LexemeId;
 
@@ -179,86 +237,365 @@ public:
 		BITWISE_NOT_OPERATOR,
 		BITWISE_XOR_OPERATOR,
 		BITWISE_LEFT_SHIFT_OPERATOR,
-		BITWISE_RIGHT_SHIFT_OPERATOR
+		BITWISE_RIGHT_SHIFT_OPERATOR,
+		DIRECTIVE,
+		HEADER_NAME,
+		STRINGIZING_OPERATOR,
+		TOKEN_PASTING_OPERATOR,
+		ERROR,
+		NUMBER_OF_LEXEME_TYPES
 	};
 
-	typedef std::map<Lexeme, std::pair<LexemeType, LexemeId> > Lexemes;
+	typedef unsigned long long LexemeTypeMask;
+
+	typedef std::function<void(LexemeType, const char*, std::size_t, std::size_t)> LexemeHandler;
+
+	// Lets the dictionary be searched with any string type without building
+	// a Lexeme, which would allocate from the dictionary's resource.
+	struct LexemeLess
+	{
+		typedef void is_transparent;
+
+		bool operator()(std::string_view left, std::string_view right) const
+		{
+			return left < right;
+		}
+	};
+
+	// The same text can be lexemes of different types ("foo.h" is a header
+	// name after #include and a string literal elsewhere), so entries are
+	// unique by text and type together.
+	typedef std::pmr::multimap<Lexeme, std::pair<LexemeType, LexemeId>, LexemeLess> Lexemes;
+
+	struct Token
+	{
+		Lexemes::iterator lexeme;
+		std::size_t offset;
+	};
+
+	typedef std::pmr::vector<Token> Tokens;
+
+	struct LexicalError
+	{
+		std::size_t offset;
+		std::size_t length;
+	};
+
+	struct ScanStream
+	{
+		const char* text;
+		std::size_t length;
+		LexemeHandler handler;
+		bool status;
+	};
+
+	static const std::size_t MAXIMUM_INTERLEAVED_LANES = 8;
+
+	struct PhaseTimes
+	{
+		long long classifyTime;
+		long long dictionaryTime;
+	};
+
+	// Scanner state at a lexeme boundary; scanning can resume from it.
+	struct ScanCheckpoint
+	{
+		std::size_t offset;
+		bool lineStart;
+		bool expectHeaderName;
+	};
 
 public:
 	LexicalAnalyzer();
+	explicit LexicalAnalyzer(const std::shared_ptr<const DFA>& automaton);
+
+	static std::shared_ptr<const DFA> BuildAutomaton();
+	static const std::shared_ptr<const DFA>& GetSharedAutomaton();
+	const std::shared_ptr<const DFA>& GetAutomaton() const;
+	void CopyConfiguration(const LexicalAnalyzer& other);
 
 	bool Analyze(std::string text);
+	bool AnalyzeBuffer(const char* text, std::size_t length);
 	bool AnalyzeFile(std::string fileName);
+	bool Minify(const char* text, std::size_t length, std::ostream& output);
+	bool MinifyFile(std::string fileName, std::ostream& output);
+	bool ScanLexemes(const char* text, std::size_t length, const LexemeHandler& handler);
+	bool ScanInterleaved(std::vector<ScanStream>& streams, std::size_t numberOfLanes);
+	bool ScanRange(
+		const char* text,
+		std::size_t length,
+		const ScanCheckpoint& checkpoint,
+		std::size_t begin,
+		std::size_t end,
+		const LexemeHandler& handler
+		);
+	bool CountLexemes(const char* text, std::size_t length, LexemeStatistics& statistics);
+	bool CountLexemesInFile(std::string fileName, LexemeStatistics& statistics);
+	void BeginStream(const LexemeHandler& handler);
+	bool Feed(const char* data, std::size_t length);
+	bool Finish();
+	void Clear();
+	void ReserveForInput(std::size_t length);
 	void DisplayLexemes();
 	void DisplayLexemeDictionary();
+	void DisplayErrors();
 	Lexemes GetLexemes();
 
+	void SetErrorRecovery(bool enabled);
+	void SetUtf8Validation(bool enabled);
+	void SetStructuralScan(bool enabled);
+	void SetCheckpointInterval(std::size_t interval);
+	const std::vector<ScanCheckpoint>& GetCheckpoints() const;
+	void SetPhaseTiming(bool enabled);
+	const PhaseTimes& GetPhaseTimes() const;
+	void ResetPhaseTimes();
+	void SetLexemeFilter(LexemeTypeMask filteredTypes);
+	static LexemeTypeMask MaskForLexemeType(LexemeType lexemeType);
+	void SetDictionaryRetention(std::size_t maximumLexemes);
+	void SetMemoryResource(std::pmr::memory_resource* resource);
+	void SetArenaAllocation(bool enabled);
+	void ReleaseMemory();
+	void SetMemoryBudget(std::size_t memoryBudget, const std::string& spillDirectory = "/tmp");
+	void SetNumericLiteralDecoding(bool enabled);
+	bool GetNumericLiteral(LexemeId lexemeId, NumericLiteral& literal) const;
+	bool HasEscapeSequences(LexemeId lexemeId) const;
+	bool GetLiteralValue(const Token& token, const char*& data, std::size_t& length);
+
+	static std::string StringForLexemeType(int lexemeType);
+	const std::vector<LexicalError>& GetErrors() const;
+	std::size_t GetErrorCount() const;
+
+	const Tokens& GetTokens() const;
+	std::size_t GetNumberOfTokens() const;
+	std::size_t GetNumberOfSpilledTokens() const;
+	std::size_t GetNumberOfErrors() const;
+	bool ForEachToken(const LexemeHandler& handler);
+	unsigned long long GetConfigurationHash() const;
+	void SerializeTokens(std::size_t firstToken, std::size_t firstError, std::string& data);
+	bool DeserializeTokens(const char* data, std::size_t length, const char* text, std::size_t textLength);
+	void GetSourcePosition(std::size_t offset, std::size_t& line, std::size_t& column);
+
+private:
+	struct InterleavedLane
+	{
+		InterleavedLane() : source(NULL, 0), stream(NULL) {}
+
+		SourceView source;
+		ScanStream* stream;
+		const char* text;
+		std::size_t length;
+		std::size_t position;
+		std::size_t lexemeStart;
+		int state;
+		bool lineStart;
+		bool expectHeaderName;
+	};
+
 private:
+	void BeginInput();
+	bool AnalyzeText(const char* text, std::size_t length);
+	bool DeliverScannedLexeme(
+		const SourceView& source,
+		bool spliced,
+		bool accepted,
+		int state,
+		std::size_t lexemeStart,
+		std::size_t& position,
+		bool& lineStart,
+		bool& expectHeaderName,
+		const LexemeHandler& handler
+		);
+	bool ScanStructural(const LexemeHandler& handler);
+	int MatchStructuralLexeme(std::size_t& position);
+	template <std::size_t NumberOfLanes>
+	void ScanLanes(std::vector<ScanStream>& streams);
+	bool StartLane(InterleavedLane& lane, std::vector<ScanStream>& streams, std::size_t& nextStream);
+	int GetInitialState(bool lineStart, bool expectHeaderName) const;
+	void BeginCheckpoints();
+	void RecordCheckpoint(std::size_t position, bool lineStart, bool expectHeaderName);
+	void AddUtf8Errors(const char* text, std::size_t length, std::size_t invalidOffset, std::size_t firstError);
+	void UpdateLineState(
+		const SourceView& source,
+		int state,
+		std::size_t lexemeStart,
+		std::size_t lexemeEnd,
+		bool& lineStart,
+		bool& expectHeaderName
+		);
+	std::size_t FindErrorEnd(
+		const SourceView& source,
+		std::size_t lexemeStart,
+		std::size_t errorPosition
+		);
+	std::size_t RecoverFromError(
+		const SourceView& source,
+		std::size_t lexemeStart,
+		std::size_t errorPosition
+		);
+	void UpdateLineState(
+		int state,
+		const char* lexeme,
+		std::size_t lexemeLength,
+		bool& lineStart,
+		bool& expectHeaderName
+		);
+
+	bool AnalyzeBufferWithinBudget(const char* text, std::size_t length);
+	bool AnalyzeFileWithinBudget(const std::string& fileName);
+	void BeginBoundedStream();
+	bool EndBoundedStream(bool status, std::size_t length);
+	void AddStreamedLexeme(LexemeType lexemeType, const char* lexeme, std::size_t lexemeLength, std::size_t offset);
+	std::size_t GetMemoryUsage() const;
+	bool SpillTokens();
+	void EvictColdLexemes();
+	void ClearLexemeSideTables();
+	void DropDictionary();
+
+	bool FeedSegment(const char* text, std::size_t length, std::size_t offset);
+	void DeliverStreamLexeme(int state, const char* lexeme, std::size_t lexemeLength);
+	void DeliverStreamError();
+
 	LexemeType GetLexemeTypeForState(int state, const std::string& lexeme);
 	LexemeType GetIdentifierType(const std::string& lexeme);
-	std::string StringForLexemeType(int lexemeType);
-
-	void AddLexemeToDictionary(const std::string& lexeme);
-
-	void RegisterLexemeParsing();
-
-	void RegisterWhitespaces();
-	void RegisterDelimiter();
-	void RegisterOperators();
-	void RegisterDivisionOperator();
-	void RegisterMultiplicationOperator();
-	void RegisterAssignmentOperator();
-	void RegisterAdditionAndIncrementOperators();
-	void RegisterSubtractionAndDecrementOperators();
-	void RegisterLineComment();
-	void RegisterBlockComment();
-	void RegisterIdentifier();
-	void RegisterStringLiteral();
-	void RegisterCharLiteral();
-	void RegisterIntegerLiteral();
-	void RegisterFloatingLiteral();
-	void RegisterParentheses();
-
-	void RegisterArithmeticOperators();
-	void RegisterModuloOperator();
-
-	void RegisterComparisonOperators();
-	void RegisterLessThanOperator();
-	void RegisterGreaterThanOperator();
-	void RegisterNotEqualToOperator();
-	void RegisterGreaterThanOrEqualToOperator();
-	void RegisterLessThanOrEqualToOperator();
-
-	void RegisterBitwiseOperators();
-	void RegisterBitwiseAndOperator();
-	void RegisterBitwiseOrOperator();
-	void RegisterBitwiseNotOperator();
-	void RegisterBitwiseXorOperator();
-	void RegisterBitwiseLeftShiftOperator();
-	void RegisterBitwiseRightShiftOperator();
-
-	void RegisterLogicalOperators();
-	void RegisterLogicalAndOperator();
-	void RegisterLogicalOrOperator();
-	void RegisterLogicalNotOperator();
-
-	void RegisterCompoundAssignmentOperators();
-	void RegisterAdditionAssignmentOperator();
-	void RegisterSubtractionAssignmentOperator();
-	void RegisterMultiplicationAssignmentOperator();
-	void RegisterDivisionAssignmentOperator();
-	void RegisterModuloAssignmentOperator();
-	void RegisterBitwiseAndAssignmentOperator();
-	void RegisterBitwiseOrAssignmentOperator();
-	void RegisterBitwiseXorAssignmentOperator();
-	void RegisterBitwiseLeftShiftAssignmentOperator();
-	void RegisterBitwiseRightShiftAssignmentOperator();
+	bool IsIncludeDirective(const std::string& lexeme);
+	static std::string GetDirectiveName(const char* lexeme, std::size_t lexemeLength);
+	bool IsLexemeTypeFiltered(LexemeType lexemeType) const;
+	static bool NeedsSeparator(char previous, char next);
+
+	void AddLexemeToDictionary(const std::string& lexeme, std::size_t offset);
+	void AddLexemeToDictionary(const std::string& lexeme, LexemeType lexemeType, std::size_t offset);
+	bool FindLexeme(const std::string& lexeme, LexemeType lexemeType, Lexemes::iterator& lexemeIt);
+	Lexemes::iterator EmplaceLexeme(Lexemes::iterator hint, const std::string& lexeme, LexemeType lexemeType);
+	Lexemes::iterator InternLexeme(const std::string& lexeme, LexemeType lexemeType);
+	void DecodeLexemePayload(Lexemes::iterator lexemeIt);
+	void MarkEscapedLiteral(LexemeId lexemeId);
+
+	static void RegisterLexemeParsing(DFA& dfa);
+
+	static void RegisterWhitespaces(DFA& dfa);
+	static void RegisterDelimiter(DFA& dfa);
+	static void RegisterOperators(DFA& dfa);
+	static void RegisterDivisionOperator(DFA& dfa);
+	static void RegisterMultiplicationOperator(DFA& dfa);
+	static void RegisterAssignmentOperator(DFA& dfa);
+	static void RegisterAdditionAndIncrementOperators(DFA& dfa);
+	static void RegisterSubtractionAndDecrementOperators(DFA& dfa);
+	static void RegisterLineComment(DFA& dfa);
+	static void RegisterBlockComment(DFA& dfa);
+	static void RegisterIdentifier(DFA& dfa);
+	static void RegisterStringLiteral(DFA& dfa);
+	static void RegisterCharLiteral(DFA& dfa);
+	static void RegisterIntegerLiteral(DFA& dfa);
+	static void RegisterFloatingLiteral(DFA& dfa);
+	static void RegisterParentheses(DFA& dfa);
+
+	static void RegisterArithmeticOperators(DFA& dfa);
+	static void RegisterModuloOperator(DFA& dfa);
+
+	static void RegisterComparisonOperators(DFA& dfa);
+	static void RegisterLessThanOperator(DFA& dfa);
+	static void RegisterGreaterThanOperator(DFA& dfa);
+	static void RegisterNotEqualToOperator(DFA& dfa);
+	static void RegisterGreaterThanOrEqualToOperator(DFA& dfa);
+	static void RegisterLessThanOrEqualToOperator(DFA& dfa);
+
+	static void RegisterBitwiseOperators(DFA& dfa);
+	static void RegisterBitwiseAndOperator(DFA& dfa);
+	static void RegisterBitwiseOrOperator(DFA& dfa);
+	static void RegisterBitwiseNotOperator(DFA& dfa);
+	static void RegisterBitwiseXorOperator(DFA& dfa);
+	static void RegisterBitwiseLeftShiftOperator(DFA& dfa);
+	static void RegisterBitwiseRightShiftOperator(DFA& dfa);
+
+	static void RegisterLogicalOperators(DFA& dfa);
+	static void RegisterLogicalAndOperator(DFA& dfa);
+	static void RegisterLogicalOrOperator(DFA& dfa);
+	static void RegisterLogicalNotOperator(DFA& dfa);
+
+	static void RegisterCompoundAssignmentOperators(DFA& dfa);
+	static void RegisterAdditionAssignmentOperator(DFA& dfa);
+	static void RegisterSubtractionAssignmentOperator(DFA& dfa);
+	static void RegisterMultiplicationAssignmentOperator(DFA& dfa);
+	static void RegisterDivisionAssignmentOperator(DFA& dfa);
+	static void RegisterModuloAssignmentOperator(DFA& dfa);
+	static void RegisterBitwiseAndAssignmentOperator(DFA& dfa);
+	static void RegisterBitwiseOrAssignmentOperator(DFA& dfa);
+	static void RegisterBitwiseXorAssignmentOperator(DFA& dfa);
+	static void RegisterBitwiseLeftShiftAssignmentOperator(DFA& dfa);
+	static void RegisterBitwiseRightShiftAssignmentOperator(DFA& dfa);
+
+	static void RegisterPreprocessorOperators(DFA& dfa);
+	static void RegisterDirective(DFA& dfa);
+	static void RegisterHeaderName(DFA& dfa);
+	static void RegisterStartConditions(DFA& dfa);
 
 private:
-	DFA m_dfa;
+	std::shared_ptr<const DFA> m_dfa;
+	DFACursor m_cursor;
+	std::unique_ptr<std::pmr::monotonic_buffer_resource> m_arena;
+	ForwardingResource m_resource;
 	Lexemes m_lexemeDictionary;
-	std::vector<Lexemes::iterator> m_lexemes;
-	std::vector<std::string> m_keywords;
+	std::size_t m_dictionaryRetention;
+	std::string m_lexemeBuffer;
+	SourceView m_source;
+	Tokens m_lexemes;
+	const std::vector<std::string>& m_keywords;
+	std::vector<LexicalError> m_errors;
+	// Every analyzed input, back to back: token and error offsets, literal
+	// payloads and the token cache all address this copy. m_inputStarts
+	// records where each input begins, so positions are resolved per input.
+	std::string m_text;
+	std::vector<std::size_t> m_inputStarts;
+	LineIndex m_lineIndex;
+	std::size_t m_indexedInput;
+	std::size_t m_inputOffset;
+	bool m_errorRecovery;
+	bool m_validateUtf8;
+	bool m_structuralScan;
+	StructuralIndex m_structuralIndex;
+	bool m_phaseTiming;
+	PhaseTimes m_phaseTimes;
+	std::size_t m_checkpointInterval;
+	std::size_t m_nextCheckpoint;
+	std::vector<ScanCheckpoint> m_checkpoints;
+	mutable unsigned long long m_tableHash;
+	LexemeTypeMask m_filteredTypes;
+	std::vector<bool> m_filteredStates;
+	bool m_filterIdentifiers;
+	bool m_decodeNumericLiterals;
+	std::vector<int> m_numericLiteralIndices;
+	std::vector<NumericLiteral> m_numericLiterals;
+	std::vector<bool> m_escapedLiterals;
+	std::vector<std::pair<const char*, std::size_t> > m_decodedLiterals;
+	Arena m_literalArena;
+	std::size_t m_dictionaryBytes;
+
+	std::size_t m_memoryBudget;
+	std::string m_spillDirectory;
+	SpillFile m_spillFile;
+	std::string m_spillBuffer;
+	std::vector<Lexemes::iterator> m_spillEntries;
+	std::vector<unsigned int> m_spillEntryIndices;
+	std::size_t m_numberOfSpilledTokens;
+	std::size_t m_numberOfSpilledErrors;
+	std::size_t m_boundedInputLength;
+	bool m_spillFailed;
+
+	LexemeHandler m_streamHandler;
+	std::string m_streamCarry;
+	std::string m_streamHeldBack;
+	std::size_t m_streamOffset;
+	std::size_t m_streamHeldBackOffset;
+	std::size_t m_streamLexemeStart;
+	std::size_t m_streamInputStart;
+	bool m_streamAtInputStart;
+	int m_streamState;
+	bool m_streamInLexeme;
+	bool m_streamInError;
+	bool m_streamFailed;
+	bool m_streamLineStart;
+	bool m_streamExpectHeaderName;
+	bool m_streamRecordErrors;
 };
 
 #endif /* LEXICALANALYZER_HPP_ */
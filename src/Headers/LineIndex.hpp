@@ -0,0 +1,32 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef LINEINDEX_HPP_
+#define LINEINDEX_HPP_
+
+#include <cstddef>
+#include <vector>
+
+class LineIndex
+{
+public:
+	LineIndex();
+
+	void Build(const char* text, std::size_t length);
+	void Clear();
+
+	bool IsBuilt() const;
+	std::size_t GetNumberOfLines() const;
+
+	void GetPosition(std::size_t offset, std::size_t& line, std::size_t& column) const;
+
+private:
+	void AddLineStarts(const char* text, std::size_t begin, std::size_t end);
+
+private:
+	std::vector<std::size_t> m_lineStarts;
+};
+
+#endif /* LINEINDEX_HPP_ */
@@ -0,0 +1,32 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef NUMERICLITERAL_HPP_
+#define NUMERICLITERAL_HPP_
+
+#include <cstddef>
+
+// Value of an integer or floating literal decoded once at lex time. Floating
+// literals with an `l` suffix are still decoded to double precision.
+struct NumericLiteral
+{
+	enum Flags {
+		UNSIGNED_SUFFIX = 1,
+		LONG_SUFFIX = 2,
+		LONG_LONG_SUFFIX = 4,
+		FLOAT_SUFFIX = 8,
+		OUT_OF_RANGE = 16
+	};
+
+	bool isFloating;
+	int radix;
+	unsigned int flags;
+	unsigned long long integerValue;
+	double floatingValue;
+};
+
+bool DecodeNumericLiteral(const char* text, std::size_t length, NumericLiteral& literal);
+
+#endif /* NUMERICLITERAL_HPP_ */
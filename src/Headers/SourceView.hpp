@@ -0,0 +1,53 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef SOURCEVIEW_HPP_
+#define SOURCEVIEW_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Logical view over a source buffer in which backslash-newline line splices
+// are skipped. The buffer is never copied; splice positions are kept in a
+// side table that stays empty for the common splice-free input.
+class SourceView
+{
+public:
+	struct Splice
+	{
+		std::size_t begin;
+		std::size_t end;
+	};
+
+public:
+	SourceView(const char* text, std::size_t length);
+
+	void Assign(const char* text, std::size_t length);
+
+	const char* GetText() const;
+	std::size_t GetLength() const;
+	std::size_t GetLogicalEnd() const;
+
+	bool HasSplices() const;
+	std::size_t FindSpliceIndex(std::size_t position) const;
+	std::size_t GetNextSplice(std::size_t position, std::size_t& spliceIndex) const;
+	std::size_t GetSpliceEnd(std::size_t spliceIndex) const;
+
+	std::string GetLogicalText(std::size_t begin, std::size_t end) const;
+	void GetLogicalText(std::size_t begin, std::size_t end, std::string& text) const;
+	bool ContainsNewline(std::size_t begin, std::size_t end) const;
+
+private:
+	void FindSplices();
+
+private:
+	const char* m_text;
+	std::size_t m_length;
+	std::size_t m_logicalEnd;
+	std::vector<Splice> m_splices;
+};
+
+#endif /* SOURCEVIEW_HPP_ */
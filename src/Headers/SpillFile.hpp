@@ -0,0 +1,39 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef SPILLFILE_HPP_
+#define SPILLFILE_HPP_
+
+#include <cstddef>
+#include <string>
+
+// Anonymous temporary file for data that does not fit the memory budget.
+// The file is unlinked as soon as it is created, so it disappears with the
+// process; data is appended and read back by offset.
+class SpillFile
+{
+public:
+	SpillFile();
+	~SpillFile();
+
+	bool Open(const std::string& directory);
+	bool IsOpen() const;
+	void Close();
+
+	bool Append(const char* data, std::size_t length);
+	bool Read(unsigned long long offset, char* data, std::size_t length) const;
+	unsigned long long GetLength() const;
+	void Truncate();
+
+private:
+	SpillFile(const SpillFile&);
+	SpillFile& operator=(const SpillFile&);
+
+private:
+	int m_fileDescriptor;
+	unsigned long long m_length;
+};
+
+#endif /* SPILLFILE_HPP_ */
@@ -0,0 +1,17 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef STRINGLITERAL_HPP_
+#define STRINGLITERAL_HPP_
+
+#include <cstddef>
+
+// Translates the escape sequences of a string or character literal body
+// (simple, octal, hexadecimal and universal character names, the latter
+// encoded as UTF-8; a name outside the Unicode scalar values is copied as
+// written, without its backslash). The output never exceeds the input length.
+std::size_t DecodeEscapeSequences(const char* text, std::size_t length, char* output);
+
+#endif /* STRINGLITERAL_HPP_ */
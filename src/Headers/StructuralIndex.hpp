@@ -0,0 +1,96 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 19.10.2026
+**************************************************************************/
+
+#ifndef STRUCTURALINDEX_HPP_
+#define STRUCTURALINDEX_HPP_
+
+#include <cstddef>
+
+// Character classes of one 64-byte block, one bit per byte.
+struct StructuralBlock
+{
+	unsigned long long whitespace;
+	unsigned long long identifier;
+	unsigned long long operators;
+	unsigned long long quotes;
+	unsigned long long commentOpeners;
+	unsigned long long stringStops;
+	unsigned long long lineEnds;
+	unsigned long long blockCommentStops;
+};
+
+// First stage of the structural scan: the input is classified block by
+// block with SIMD compares, and the scanner then finds the end of
+// whitespace runs, identifiers, comments and string literals with bit
+// scans instead of one table transition per byte. Blocks are classified
+// on demand, so only the block under the scan position is kept.
+class StructuralIndex
+{
+public:
+	typedef unsigned long long StructuralBlock::*Mask;
+
+	static const std::size_t BLOCK_SIZE = 64;
+
+	StructuralIndex();
+
+	void Assign(const char* text, std::size_t length);
+
+	bool Test(std::size_t position, Mask mask)
+	{
+		return (GetBlock(position / BLOCK_SIZE).*mask >> (position % BLOCK_SIZE)) & 1;
+	}
+
+	// First position at or after position whose bit is set (or clear) in
+	// mask, or the input length when there is none.
+	std::size_t FindFirst(std::size_t position, Mask mask)
+	{
+		return Find(position, mask, 0);
+	}
+
+	std::size_t FindFirstNot(std::size_t position, Mask mask)
+	{
+		return Find(position, mask, ~0ULL);
+	}
+
+	static void ClassifyBlock(const char* block, char next, StructuralBlock& classification);
+
+private:
+	StructuralIndex(const StructuralIndex&);
+
+	const StructuralBlock& GetBlock(std::size_t blockIndex)
+	{
+		if (blockIndex != m_blockIndex)
+		{
+			LoadBlock(blockIndex);
+		}
+		return m_block;
+	}
+
+	std::size_t Find(std::size_t position, Mask mask, unsigned long long invert)
+	{
+		while (position < m_length)
+		{
+			std::size_t blockIndex = position / BLOCK_SIZE;
+			unsigned long long bits = (GetBlock(blockIndex).*mask ^ invert) >> (position % BLOCK_SIZE);
+			if (bits != 0)
+			{
+				position += __builtin_ctzll(bits);
+				return position < m_length ? position : m_length;
+			}
+			position = (blockIndex + 1) * BLOCK_SIZE;
+		}
+		return m_length;
+	}
+
+	void LoadBlock(std::size_t blockIndex);
+
+private:
+	const char* m_text;
+	std::size_t m_length;
+	std::size_t m_blockIndex;
+	StructuralBlock m_block;
+};
+
+#endif /* STRUCTURALINDEX_HPP_ */
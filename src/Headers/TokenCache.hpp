@@ -0,0 +1,45 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#ifndef TOKENCACHE_HPP_
+#define TOKENCACHE_HPP_
+
+#include "LexicalAnalyzer.hpp"
+#include "FileUtilities.hpp"
+
+#include <atomic>
+#include <string>
+
+// On-disk cache of serialized token streams keyed by the content hash of the
+// input and the configuration hash of the analyzer. Entries are published
+// with an atomic rename and evicted least recently used first.
+class TokenCache
+{
+public:
+	TokenCache(const std::string& directory, unsigned long long maximumSize);
+
+	bool AnalyzeFile(LexicalAnalyzer& lex, const std::string& fileName);
+	bool VerifyFile(const LexicalAnalyzer& lex, const std::string& fileName);
+	void Evict();
+
+	unsigned long long GetHits() const;
+	unsigned long long GetMisses() const;
+	void DisplayStatistics();
+
+private:
+	std::string GetEntryPath(const LexicalAnalyzer& lex, const MappedFile& inputFile) const;
+	bool StoreEntry(const std::string& entryPath, const std::string& data);
+
+private:
+	std::string m_directory;
+	unsigned long long m_maximumSize;
+	std::atomic<unsigned long long> m_hits;
+	std::atomic<unsigned long long> m_misses;
+	std::atomic<unsigned long long> m_writes;
+	std::atomic<unsigned long long> m_evictions;
+	std::atomic<unsigned long long> m_temporaryFileCounter;
+};
+
+#endif /* TOKENCACHE_HPP_ */
@@ -0,0 +1,52 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 19.10.2026
+**************************************************************************/
+
+#ifndef TRACERECORDER_HPP_
+#define TRACERECORDER_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct TraceEvent
+{
+	const char* name;
+	long long begin;
+	long long end;
+	std::size_t fileIndex;
+	bool overlapping;
+};
+
+// Spans recorded by one thread, written together with the spans of the
+// other threads as a Chrome trace-event file (chrome://tracing, Perfetto).
+// Spans of a thread must nest unless they are marked overlapping, such as
+// reads that are in flight at the same time; those are written as async
+// events keyed by file.
+class TraceRecorder
+{
+public:
+	static const std::size_t NO_FILE = static_cast<std::size_t>(-1);
+
+	TraceRecorder();
+
+	void SetThread(unsigned int threadId, const std::string& threadName);
+	void AddSpan(const char* name, long long begin, long long end, std::size_t fileIndex = NO_FILE);
+	void AddOverlappingSpan(const char* name, long long begin, long long end, std::size_t fileIndex);
+	void Clear();
+
+	static bool Write(
+		const std::vector<const TraceRecorder*>& recorders,
+		const std::vector<std::string>& fileNames,
+		long long origin,
+		const std::string& traceFileName
+		);
+
+private:
+	unsigned int m_threadId;
+	std::string m_threadName;
+	std::vector<TraceEvent> m_events;
+};
+
+#endif /* TRACERECORDER_HPP_ */
@@ -0,0 +1,20 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 19.10.2026
+**************************************************************************/
+
+#ifndef UTF8_HPP_
+#define UTF8_HPP_
+
+#include <cstddef>
+
+// Length of the well-formed UTF-8 sequence starting at position, or 0 when
+// the bytes there are not one (overlong forms, surrogates and code points
+// above U+10FFFF are rejected).
+std::size_t GetUtf8SequenceLength(const char* text, std::size_t length, std::size_t position);
+
+// Offset of the first byte that does not belong to a well-formed UTF-8
+// sequence, or length when the whole text is valid.
+std::size_t FindInvalidUtf8(const char* text, std::size_t length);
+
+#endif /* UTF8_HPP_ */
@@ -4,15 +4,1718 @@ Creation date: 21.02.2018
 **************************************************************************/
 
 #include "Headers/LexicalAnalyzer.hpp"
+#include "Headers/AnalyzerPool.hpp"
+#include "Headers/IncludeScanner.hpp"
+#include "Headers/FileUtilities.hpp"
+#include "Headers/LexemeStatistics.hpp"
+#include "Headers/TokenCache.hpp"
+#include "Headers/LexerServer.hpp"
+#include "Headers/LexerClient.hpp"
+#include "Headers/BatchPipeline.hpp"
+#include "Headers/CloneIndex.hpp"
+#include "Headers/CrossReferenceIndex.hpp"
+#include "Headers/LineIndex.hpp"
+#include "Headers/Hash.hpp"
+#include "Headers/Utf8.hpp"
+#include "Headers/StructuralIndex.hpp"
+#include "Headers/CLexer.h"
+#include "Headers/CheckpointIndex.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
 #include <iostream>
+#include <map>
+#include <memory_resource>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+static int ScanIncludes(const std::vector<std::string>& paths)
+{
+	std::vector<std::string> fileNames;
+	for (std::vector<std::string>::const_iterator it = paths.begin(); it != paths.end(); ++it)
+	{
+		CollectSourceFiles(*it, fileNames);
+	}
+
+	IncludeScanner scanner;
+	int status = 0;
+	for (std::vector<std::string>::iterator it = fileNames.begin(); it != fileNames.end(); ++it)
+	{
+		scanner.Clear();
+		if (!scanner.ScanFile(*it))
+		{
+			std::cerr << "Cannot read " << *it << '\n';
+			status = 1;
+			continue;
+		}
+		scanner.DisplayIncludes(*it);
+	}
+	return status;
+}
+
+static int Minify(const std::vector<std::string>& fileNames)
+{
+	LexicalAnalyzer lex;
+	lex.SetErrorRecovery(true);
+
+	int status = 0;
+	for (std::vector<std::string>::const_iterator it = fileNames.begin(); it != fileNames.end(); ++it)
+	{
+		if (!lex.MinifyFile(*it, std::cout))
+		{
+			std::cerr << "Cannot minify " << *it << '\n';
+			status = 1;
+		}
+	}
+	return status;
+}
+
+static void CountLexemesInFiles(
+	const std::vector<std::string>& fileNames,
+	std::atomic<std::size_t>& nextFile,
+	LexemeStatistics& statistics
+	)
+{
+	LexicalAnalyzer lex;
+	lex.SetErrorRecovery(true);
+	lex.SetLexemeFilter(
+		LexicalAnalyzer::MaskForLexemeType(LexicalAnalyzer::LINE_COMMENT) |
+		LexicalAnalyzer::MaskForLexemeType(LexicalAnalyzer::BLOCK_COMMENT)
+		);
+
+	for (std::size_t i = nextFile++; i < fileNames.size(); i = nextFile++)
+	{
+		if (!lex.CountLexemesInFile(fileNames[i], statistics))
+		{
+			std::cerr << "Cannot read " << fileNames[i] << '\n';
+		}
+	}
+}
+
+static int CountLexemes(const std::vector<std::string>& arguments)
+{
+	std::size_t numberOfThreads = std::thread::hardware_concurrency();
+	std::size_t topCount = 10;
+	std::size_t memoryBudget = 64 << 20;
+	std::vector<std::string> fileNames;
+	for (std::size_t i = 0; i < arguments.size(); ++i)
+	{
+		if (arguments[i] == "-j" && i + 1 < arguments.size())
+		{
+			numberOfThreads = std::strtoul(arguments[++i].c_str(), NULL, 10);
+		}
+		else if (arguments[i] == "-k" && i + 1 < arguments.size())
+		{
+			topCount = std::strtoul(arguments[++i].c_str(), NULL, 10);
+		}
+		else if (arguments[i] == "--budget" && i + 1 < arguments.size())
+		{
+			memoryBudget = std::strtoul(arguments[++i].c_str(), NULL, 10) << 20;
+		}
+		else
+		{
+			CollectSourceFiles(arguments[i], fileNames);
+		}
+	}
+	if (numberOfThreads == 0)
+	{
+		numberOfThreads = 1;
+	}
+	if (topCount == 0)
+	{
+		std::cerr << "-k must be at least 1\n";
+		return 1;
+	}
+	std::size_t minimumBudget =
+		LexemeStatistics::GetMinimumMemoryBudget(LexicalAnalyzer::NUMBER_OF_LEXEME_TYPES, topCount) * numberOfThreads;
+	if (memoryBudget < minimumBudget)
+	{
+		std::cerr << "--budget must be at least " << (minimumBudget + (1 << 20) - 1) / (1 << 20)
+			<< " MB for -k " << topCount << " on " << numberOfThreads << " thread(s)\n";
+		return 1;
+	}
+
+	std::vector<LexemeStatistics> statistics(
+		numberOfThreads,
+		LexemeStatistics(LexicalAnalyzer::NUMBER_OF_LEXEME_TYPES, memoryBudget / numberOfThreads, topCount * 16)
+		);
+	std::atomic<std::size_t> nextFile(0);
+	std::vector<std::thread> workers;
+	for (std::size_t i = 0; i < numberOfThreads; ++i)
+	{
+		workers.push_back(std::thread(
+			CountLexemesInFiles, std::cref(fileNames), std::ref(nextFile), std::ref(statistics[i])));
+	}
+	for (std::size_t i = 0; i < numberOfThreads; ++i)
+	{
+		workers[i].join();
+		if (i != 0)
+		{
+			statistics[0].Merge(statistics[i]);
+		}
+	}
+
+	LexicalAnalyzer lex;
+	for (int type = 0; type < LexicalAnalyzer::NUMBER_OF_LEXEME_TYPES; ++type)
+	{
+		if (statistics[0].GetTotalCount(type) == 0)
+		{
+			continue;
+		}
+		std::cout << lex.StringForLexemeType(type) << ": " << statistics[0].GetTotalCount(type) << '\n';
+		std::vector<std::pair<std::string, unsigned long long> > top = statistics[0].GetTop(type, topCount);
+		for (std::size_t i = 0; i < top.size(); ++i)
+		{
+			std::cout << "\t" << top[i].first << ", " << top[i].second << '\n';
+		}
+	}
+	if (!statistics[0].IsExact())
+	{
+		std::cout << "(approximate counts)\n";
+	}
+	return 0;
+}
+
+static int AnalyzeWithCache(const std::vector<std::string>& arguments)
+{
+	if (arguments.empty())
+	{
+		std::cerr << "Missing cache directory\n";
+		return 1;
+	}
+	bool verify = false;
+	unsigned long long maximumSize = 1ULL << 30;
+	std::vector<std::string> fileNames;
+	for (std::size_t i = 1; i < arguments.size(); ++i)
+	{
+		if (arguments[i] == "--verify")
+		{
+			verify = true;
+		}
+		else if (arguments[i] == "--max-size" && i + 1 < arguments.size())
+		{
+			maximumSize = std::strtoull(arguments[++i].c_str(), NULL, 10) << 20;
+		}
+		else
+		{
+			CollectSourceFiles(arguments[i], fileNames);
+		}
+	}
+
+	TokenCache cache(arguments[0], maximumSize);
+	int status = 0;
+	for (std::vector<std::string>::iterator it = fileNames.begin(); it != fileNames.end(); ++it)
+	{
+		LexicalAnalyzer lex;
+		lex.SetErrorRecovery(true);
+		if (!cache.AnalyzeFile(lex, *it))
+		{
+			std::cerr << "Cannot analyze " << *it << '\n';
+			status = 1;
+			continue;
+		}
+		if (verify && !cache.VerifyFile(lex, *it))
+		{
+			std::cerr << "Cached tokens differ for " << *it << '\n';
+			status = 1;
+		}
+	}
+	cache.DisplayStatistics();
+	return status;
+}
+
+static void DisplayToken(int lexemeType, const char* lexeme, std::size_t lexemeLength, std::size_t offset)
+{
+	std::cout << LexicalAnalyzer::StringForLexemeType(lexemeType) << ": ";
+	std::cout.write(lexeme, lexemeLength);
+	std::cout << ", " << offset << '\n';
+}
+
+static bool DisplayStreamTokens(LexicalAnalyzer& lex, int fileDescriptor)
+{
+	std::vector<char> chunk(64 * 1024);
+	lex.BeginStream(DisplayToken);
+	while (true)
+	{
+		ssize_t count = read(fileDescriptor, &chunk[0], chunk.size());
+		if (count < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (count < 0)
+		{
+			return false;
+		}
+		if (count == 0)
+		{
+			return lex.Finish();
+		}
+		if (!lex.Feed(&chunk[0], count))
+		{
+			return false;
+		}
+	}
+}
+
+static std::string DigestTokens(LexicalAnalyzer& lex, const std::string& text, std::size_t chunkLength)
+{
+	std::string tokens;
+	LexicalAnalyzer::LexemeHandler handler =
+		[&tokens](LexicalAnalyzer::LexemeType lexemeType, const char* lexeme, std::size_t lexemeLength, std::size_t offset)
+		{
+			tokens += std::to_string(lexemeType) + ' ' + std::to_string(offset) + ' ';
+			tokens.append(lexeme, lexemeLength);
+			tokens += '\n';
+		};
+	if (chunkLength == 0)
+	{
+		lex.ScanLexemes(text.data(), text.length(), handler);
+		return tokens;
+	}
+	lex.BeginStream(handler);
+	for (std::size_t position = 0; position < text.length(); position += chunkLength)
+	{
+		lex.Feed(text.data() + position, std::min(chunkLength, text.length() - position));
+	}
+	lex.Finish();
+	return tokens;
+}
+
+// Checks that streaming the inputs in chunks of several sizes yields the
+// tokens of the buffered scan. Inputs with line splices at lexeme and chunk
+// boundaries are always checked.
+static int VerifyStreaming(const std::vector<std::string>& arguments)
+{
+	std::vector<std::string> names;
+	std::vector<std::string> inputs;
+	const char* const builtinInputs[] = {
+		"\\\nint x;\n",
+		"\\\r\nint x;\n",
+		"\\\n\\\n#define X 1\n",
+		"int\\\n x = a\\\n+\\\n+;\n",
+		"@\\\n@ y /\\\n* c *\\\n/\n",
+		"\"a\\\nb\" '\\\\' \\",
+		"\\\n\\\r\n",
+		"# /*c*/ define Y 2\n# /* a\\\nb */ include <x.h>\n"
+	};
+	for (std::size_t i = 0; i < sizeof(builtinInputs) / sizeof(builtinInputs[0]); ++i)
+	{
+		names.push_back("built-in input " + std::to_string(i + 1));
+		inputs.push_back(builtinInputs[i]);
+	}
+	std::vector<std::string> fileNames;
+	for (std::vector<std::string>::const_iterator it = arguments.begin(); it != arguments.end(); ++it)
+	{
+		CollectSourceFiles(*it, fileNames);
+	}
+	for (std::vector<std::string>::iterator it = fileNames.begin(); it != fileNames.end(); ++it)
+	{
+		std::string text;
+		if (!ReadFileContents(*it, text))
+		{
+			std::cerr << "Cannot read " << *it << '\n';
+			return 1;
+		}
+		names.push_back(*it);
+		inputs.push_back(text);
+	}
+
+	static const std::size_t chunkLengths[] = { 1, 2, 3, 7, 4096 };
+	LexicalAnalyzer lex;
+	lex.SetErrorRecovery(true);
+	int status = 0;
+	for (std::size_t i = 0; i < inputs.size(); ++i)
+	{
+		std::string expected = DigestTokens(lex, inputs[i], 0);
+		for (std::size_t j = 0; j < sizeof(chunkLengths) / sizeof(chunkLengths[0]); ++j)
+		{
+			if (DigestTokens(lex, inputs[i], chunkLengths[j]) != expected)
+			{
+				std::cout << names[i] << ": streaming in chunks of " << chunkLengths[j] << " bytes differs\n";
+				status = 1;
+			}
+		}
+	}
+	std::cout << inputs.size() << " inputs checked\n";
+	return status;
+}
+
+// Decodes string and character literals with known values. Every literal is
+// read twice, so that escaped ones are checked both when they are decoded
+// into the arena and when they are served from it.
+static int VerifyLiterals()
+{
+	struct LiteralCase
+	{
+		const char* source;
+		std::string expected;
+	};
+	const LiteralCase cases[] = {
+		{ "\"plain\"", "plain" },
+		{ "\"a\\nb\\t\\\\\"", "a\nb\t\\" },
+		{ "'\\''", "'" },
+		{ "\"\\101\\7\\0\"", std::string("A\x07\0", 3) },
+		{ "\"\\1234\"", "S4" },
+		{ "\"\\x41\\x7e\\x\"", "A~x" },
+		{ "\"\\u00e9\"", "\xC3\xA9" },
+		{ "\"\\u20AC\"", "\xE2\x82\xAC" },
+		{ "\"\\U0001F600\"", "\xF0\x9F\x98\x80" },
+		{ "\"\\U0010FFFF\"", "\xF4\x8F\xBF\xBF" },
+		{ "\"\\uD800\"", "uD800" },
+		{ "\"\\uDFFF\"", "uDFFF" },
+		{ "\"\\U00110000\"", "U00110000" },
+		{ "\"\\u12\"", "u12" },
+		{ "\"\\q\"", "q" }
+	};
+
+	LexicalAnalyzer lex;
+	int status = 0;
+	for (std::size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+	{
+		lex.Clear();
+		if (!lex.Analyze(cases[i].source) || lex.GetTokens().size() != 1)
+		{
+			std::cout << cases[i].source << ": not lexed as one literal\n";
+			status = 1;
+			continue;
+		}
+		for (int pass = 0; pass < 2; ++pass)
+		{
+			const char* data;
+			std::size_t length;
+			if (!lex.GetLiteralValue(lex.GetTokens()[0], data, length) ||
+				std::string(data, length) != cases[i].expected)
+			{
+				std::cout << cases[i].source << ": wrong value\n";
+				status = 1;
+				break;
+			}
+		}
+	}
+	std::cout << sizeof(cases) / sizeof(cases[0]) << " literals checked\n";
+	return status;
+}
+
+static int DisplayTokens(const std::vector<std::string>& fileNames)
+{
+	LexicalAnalyzer lex;
+	lex.SetErrorRecovery(true);
+
+	if (fileNames.empty())
+	{
+		return DisplayStreamTokens(lex, STDIN_FILENO) ? 0 : 1;
+	}
+
+	int status = 0;
+	for (std::vector<std::string>::const_iterator it = fileNames.begin(); it != fileNames.end(); ++it)
+	{
+		if (*it == "-")
+		{
+			if (!DisplayStreamTokens(lex, STDIN_FILENO))
+			{
+				std::cerr << "Cannot read the standard input\n";
+				status = 1;
+			}
+			continue;
+		}
+		MappedFile inputFile;
+		if (!inputFile.Open(*it))
+		{
+			std::cerr << "Cannot read " << *it << '\n';
+			status = 1;
+			continue;
+		}
+		lex.ScanLexemes(inputFile.GetData(), inputFile.GetLength(), DisplayToken);
+	}
+	return status;
+}
+
+// Lists the lexemes overlapping [BEGIN, END) of FILE. The checkpoints are
+// kept next to the file and rebuilt by a full scan when they are missing
+// or stale.
+static int DisplayTokenRange(const std::vector<std::string>& arguments)
+{
+	std::size_t interval = CheckpointIndex::DEFAULT_INTERVAL;
+	std::size_t first = 0;
+	if (arguments.size() >= 2 && arguments[0] == "-i")
+	{
+		interval = std::max<std::size_t>(1, std::strtoul(arguments[1].c_str(), NULL, 10)) * 1024;
+		first = 2;
+	}
+	if (arguments.size() != first + 3)
+	{
+		std::cerr << "Usage: --range [-i KB] FILE BEGIN END\n";
+		return 1;
+	}
+	const std::string& fileName = arguments[first];
+	std::size_t begin = std::strtoull(arguments[first + 1].c_str(), NULL, 10);
+	std::size_t end = std::strtoull(arguments[first + 2].c_str(), NULL, 10);
+	MappedFile inputFile;
+	if (!inputFile.Open(fileName))
+	{
+		std::cerr << "Cannot read " << fileName << '\n';
+		return 1;
+	}
+
+	LexicalAnalyzer lex;
+	lex.SetErrorRecovery(true);
+	std::string indexFileName = fileName + ".checkpoints";
+	CheckpointIndex index;
+	if (!index.Read(indexFileName, lex, inputFile.GetData(), inputFile.GetLength()))
+	{
+		lex.SetCheckpointInterval(interval);
+		lex.ScanLexemes(inputFile.GetData(), inputFile.GetLength(),
+			[](LexicalAnalyzer::LexemeType, const char*, std::size_t, std::size_t)
+			{
+			});
+		lex.SetCheckpointInterval(0);
+		index.Assign(lex, inputFile.GetData(), inputFile.GetLength());
+		if (!index.Write(indexFileName))
+		{
+			std::cerr << "Cannot write " << indexFileName << '\n';
+		}
+	}
+	return index.ScanRange(lex, inputFile.GetData(), inputFile.GetLength(), begin, end, DisplayToken) ? 0 : 1;
+}
+
+static LexerServer* runningServer = NULL;
+
+static void StopServer(int)
+{
+	runningServer->Stop();
+}
+
+static int RunDaemon(const std::vector<std::string>& arguments)
+{
+	if (arguments.empty())
+	{
+		std::cerr << "Missing socket path\n";
+		return 1;
+	}
+	std::size_t numberOfWorkers = std::thread::hardware_concurrency();
+	for (std::size_t i = 1; i < arguments.size(); ++i)
+	{
+		if (arguments[i] == "-j" && i + 1 < arguments.size())
+		{
+			numberOfWorkers = std::strtoul(arguments[++i].c_str(), NULL, 10);
+		}
+	}
+
+	LexerServer server(arguments[0], numberOfWorkers);
+	runningServer = &server;
+	std::signal(SIGINT, StopServer);
+	std::signal(SIGTERM, StopServer);
+	bool status = server.Run();
+	std::signal(SIGINT, SIG_DFL);
+	std::signal(SIGTERM, SIG_DFL);
+	runningServer = NULL;
+	if (!status)
+	{
+		std::cerr << "Lexer daemon on " << arguments[0] << " failed\n";
+		return 1;
+	}
+	return 0;
+}
+
+static int RunClient(const std::vector<std::string>& arguments)
+{
+	if (arguments.empty())
+	{
+		std::cerr << "Missing socket path\n";
+		return 1;
+	}
+	std::vector<LexerRequest> requests;
+	for (std::size_t i = 1; i < arguments.size(); ++i)
+	{
+		LexerRequest request;
+		request.kind = LEXER_REQUEST_PATH;
+		request.data = std::filesystem::absolute(arguments[i]).string();
+		requests.push_back(request);
+	}
+
+	LexerClient client;
+	std::vector<LexerResponse> responses;
+	if (!client.Connect(arguments[0]) || !client.Lex(requests, responses))
+	{
+		std::cerr << "Cannot reach the lexer daemon on " << arguments[0] << '\n';
+		return 1;
+	}
+
+	int status = 0;
+	for (std::size_t i = 0; i < responses.size(); ++i)
+	{
+		if (!responses[i].success)
+		{
+			std::cerr << "Cannot read " << arguments[i + 1] << '\n';
+			status = 1;
+			continue;
+		}
+		for (
+			std::vector<LexerToken>::iterator it = responses[i].tokens.begin();
+			it != responses[i].tokens.end();
+			++it
+			)
+		{
+			DisplayToken(it->type, it->text.data(), it->text.length(), it->offset);
+		}
+	}
+	return status;
+}
+
+static void DisplayLatencies(const std::string& name, std::vector<double>& latencies)
+{
+	std::sort(latencies.begin(), latencies.end());
+	std::cout << name << ": p50 " << latencies[latencies.size() / 2] << " us, p99 " <<
+		latencies[latencies.size() * 99 / 100] << " us\n";
+}
+
+static int BenchmarkDaemon(const std::vector<std::string>& arguments)
+{
+	if (arguments.size() < 3)
+	{
+		std::cerr << "Usage: --benchmark-daemon SOCKET ITERATIONS FILE\n";
+		return 1;
+	}
+	std::size_t iterations = std::strtoul(arguments[1].c_str(), NULL, 10);
+	std::string fileName = std::filesystem::absolute(arguments[2]).string();
+	if (iterations == 0)
+	{
+		iterations = 1;
+	}
+
+	posix_spawn_file_actions_t fileActions;
+	posix_spawn_file_actions_init(&fileActions);
+	posix_spawn_file_actions_addopen(&fileActions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+	char executable[] = "/proc/self/exe";
+	char mode[] = "--tokens";
+	std::vector<char> fileNameArgument(fileName.begin(), fileName.end());
+	fileNameArgument.push_back('\0');
+	char* spawnArguments[] = { executable, mode, &fileNameArgument[0], NULL };
+
+	std::vector<double> processLatencies;
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		pid_t child = 0;
+		int childStatus = 0;
+		if (posix_spawn(&child, executable, &fileActions, NULL, spawnArguments, environ) != 0 ||
+			waitpid(child, &childStatus, 0) != child)
+		{
+			std::cerr << "Cannot spawn the per-process lexer\n";
+			posix_spawn_file_actions_destroy(&fileActions);
+			return 1;
+		}
+		processLatencies.push_back(std::chrono::duration<double, std::micro>(
+			std::chrono::steady_clock::now() - start).count());
+	}
+	posix_spawn_file_actions_destroy(&fileActions);
+
+	LexerClient client;
+	if (!client.Connect(arguments[0]))
+	{
+		std::cerr << "Cannot reach the lexer daemon on " << arguments[0] << '\n';
+		return 1;
+	}
+	std::vector<LexerRequest> requests(1);
+	requests[0].kind = LEXER_REQUEST_PATH;
+	requests[0].data = fileName;
+	std::vector<LexerResponse> responses;
+	std::vector<double> daemonLatencies;
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		if (!client.Lex(requests, responses))
+		{
+			std::cerr << "Lexer daemon request failed\n";
+			return 1;
+		}
+		daemonLatencies.push_back(std::chrono::duration<double, std::micro>(
+			std::chrono::steady_clock::now() - start).count());
+	}
+
+	DisplayLatencies("Per-process", processLatencies);
+	DisplayLatencies("Daemon", daemonLatencies);
+	return 0;
+}
+
+static int AnalyzeBatch(const std::vector<std::string>& arguments)
+{
+	std::size_t numberOfWorkers = std::thread::hardware_concurrency();
+	std::size_t numberOfReaders = 4;
+	std::size_t queueDepth = 32;
+	bool asyncReads = true;
+	bool tokenDictionary = false;
+	bool latencies = false;
+	std::string traceFileName;
+	std::vector<std::string> fileNames;
+	for (std::size_t i = 0; i < arguments.size(); ++i)
+	{
+		if (arguments[i] == "-j" && i + 1 < arguments.size())
+		{
+			numberOfWorkers = std::strtoul(arguments[++i].c_str(), NULL, 10);
+		}
+		else if (arguments[i] == "--dictionary")
+		{
+			tokenDictionary = true;
+		}
+		else if (arguments[i] == "--latency")
+		{
+			latencies = true;
+		}
+		else if (arguments[i] == "--trace" && i + 1 < arguments.size())
+		{
+			traceFileName = arguments[++i];
+		}
+		else if (arguments[i] == "--readers" && i + 1 < arguments.size())
+		{
+			numberOfReaders = std::strtoul(arguments[++i].c_str(), NULL, 10);
+		}
+		else if (arguments[i] == "--depth" && i + 1 < arguments.size())
+		{
+			queueDepth = std::strtoul(arguments[++i].c_str(), NULL, 10);
+		}
+		else if (arguments[i] == "--sync-reads")
+		{
+			asyncReads = false;
+		}
+		else
+		{
+			CollectSourceFiles(arguments[i], fileNames);
+		}
+	}
+
+	BatchPipeline pipeline(numberOfReaders, numberOfWorkers, queueDepth);
+	pipeline.SetAsyncReads(asyncReads);
+	pipeline.SetTokenDictionary(tokenDictionary);
+	pipeline.SetProfiling(latencies);
+	pipeline.SetTraceFile(traceFileName);
+	bool status = pipeline.Run(fileNames, std::cout);
+	pipeline.DisplayUtilization(std::cerr);
+	if (latencies)
+	{
+		pipeline.DisplayLatencies(std::cerr);
+	}
+	return status ? 0 : 1;
+}
+
+static double ElapsedMilliseconds(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static long GetPeakResidentKilobytes()
+{
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+static int AnalyzeWithinBudget(const std::vector<std::string>& arguments)
+{
+	if (arguments.empty())
+	{
+		std::cerr << "Usage: --bounded [--budget MB] [--spill DIRECTORY] [--quiet] files\n";
+		return 1;
+	}
+	std::size_t memoryBudget = 64 << 20;
+	std::string spillDirectory = "/tmp";
+	bool quiet = false;
+	std::vector<std::string> fileNames;
+	for (std::size_t i = 0; i < arguments.size(); ++i)
+	{
+		if (arguments[i] == "--budget" && i + 1 < arguments.size())
+		{
+			memoryBudget = std::strtoul(arguments[++i].c_str(), NULL, 10) << 20;
+		}
+		else if (arguments[i] == "--spill" && i + 1 < arguments.size())
+		{
+			spillDirectory = arguments[++i];
+		}
+		else if (arguments[i] == "--quiet")
+		{
+			quiet = true;
+		}
+		else
+		{
+			fileNames.push_back(arguments[i]);
+		}
+	}
+
+	LexicalAnalyzer lex;
+	lex.SetErrorRecovery(true);
+	lex.SetMemoryBudget(memoryBudget, spillDirectory);
+	int status = 0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (std::vector<std::string>::const_iterator it = fileNames.begin(); it != fileNames.end(); ++it)
+	{
+		if (!lex.AnalyzeFile(*it))
+		{
+			std::cerr << "Cannot analyze " << *it << '\n';
+			status = 1;
+		}
+	}
+	double analysisTime = ElapsedMilliseconds(start);
+	if (!quiet && !lex.ForEachToken(DisplayToken))
+	{
+		std::cerr << "Cannot read the spilled tokens\n";
+		status = 1;
+	}
+	std::cerr << "Tokens: " << lex.GetNumberOfTokens() << ", spilled: " << lex.GetNumberOfSpilledTokens()
+		<< ", errors: " << lex.GetNumberOfErrors() << ", " << analysisTime << " ms, peak RSS: "
+		<< GetPeakResidentKilobytes() / 1024 << " MB\n";
+	return status;
+}
+
+static int BenchmarkNumericLiterals(const std::vector<std::string>& arguments)
+{
+	std::vector<std::string> fileNames;
+	for (std::vector<std::string>::const_iterator it = arguments.begin(); it != arguments.end(); ++it)
+	{
+		CollectSourceFiles(*it, fileNames);
+	}
+	std::string text;
+	for (std::vector<std::string>::iterator it = fileNames.begin(); it != fileNames.end(); ++it)
+	{
+		ReadFileContents(*it, text);
+		text.push_back('\n');
+	}
+
+	double bestStrtod[2] = { 1e300, 1e300 };
+	double bestPayload[2] = { 1e300, 1e300 };
+	std::size_t numberOfLiterals = 0;
+	std::size_t mismatches = 0;
+	for (int iteration = 0; iteration < 5; ++iteration)
+	{
+		LexicalAnalyzer strtodLex;
+		strtodLex.SetErrorRecovery(true);
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		strtodLex.AnalyzeBuffer(text.data(), text.length());
+		double lexTime = ElapsedMilliseconds(start);
+
+		start = std::chrono::steady_clock::now();
+		std::vector<double> strtodValues;
+		const LexicalAnalyzer::Tokens& strtodTokens = strtodLex.GetTokens();
+		for (std::size_t i = 0; i < strtodTokens.size(); ++i)
+		{
+			LexicalAnalyzer::LexemeType lexemeType = strtodTokens[i].lexeme->second.first;
+			const char* lexeme = strtodTokens[i].lexeme->first.c_str();
+			if (lexemeType == LexicalAnalyzer::FLOATING_LITERAL)
+			{
+				strtodValues.push_back(std::strtod(lexeme, NULL));
+			}
+			else if (lexemeType == LexicalAnalyzer::INTEGER_LITERAL)
+			{
+				bool binary = lexeme[0] == '0' && (lexeme[1] == 'b' || lexeme[1] == 'B');
+				strtodValues.push_back(static_cast<double>(
+					binary ? std::strtoull(lexeme + 2, NULL, 2) : std::strtoull(lexeme, NULL, 0)));
+			}
+		}
+		bestStrtod[0] = std::min(bestStrtod[0], lexTime);
+		bestStrtod[1] = std::min(bestStrtod[1], ElapsedMilliseconds(start));
+
+		LexicalAnalyzer payloadLex;
+		payloadLex.SetErrorRecovery(true);
+		payloadLex.SetNumericLiteralDecoding(true);
+		start = std::chrono::steady_clock::now();
+		payloadLex.AnalyzeBuffer(text.data(), text.length());
+		lexTime = ElapsedMilliseconds(start);
+
+		start = std::chrono::steady_clock::now();
+		std::vector<double> payloadValues;
+		const LexicalAnalyzer::Tokens& payloadTokens = payloadLex.GetTokens();
+		for (std::size_t i = 0; i < payloadTokens.size(); ++i)
+		{
+			LexicalAnalyzer::LexemeType lexemeType = payloadTokens[i].lexeme->second.first;
+			NumericLiteral literal;
+			if ((lexemeType == LexicalAnalyzer::INTEGER_LITERAL || lexemeType == LexicalAnalyzer::FLOATING_LITERAL) &&
+				payloadLex.GetNumericLiteral(payloadTokens[i].lexeme->second.second, literal))
+			{
+				payloadValues.push_back(literal.isFloating ?
+					literal.floatingValue : static_cast<double>(literal.integerValue));
+			}
+		}
+		bestPayload[0] = std::min(bestPayload[0], lexTime);
+		bestPayload[1] = std::min(bestPayload[1], ElapsedMilliseconds(start));
+
+		numberOfLiterals = strtodValues.size();
+		mismatches = strtodValues.size() > payloadValues.size() ?
+			strtodValues.size() - payloadValues.size() : payloadValues.size() - strtodValues.size();
+		for (std::size_t i = 0; i < std::min(strtodValues.size(), payloadValues.size()); ++i)
+		{
+			if (strtodValues[i] != payloadValues[i])
+			{
+				++mismatches;
+			}
+		}
+	}
+
+	std::cout << "Literals: " << numberOfLiterals << ", mismatches: " << mismatches << '\n';
+	std::cout << "strtod consumer: lex " << bestStrtod[0] << " ms + convert " << bestStrtod[1] << " ms\n";
+	std::cout << "Lex-time payload: lex and decode " << bestPayload[0] << " ms + lookup " << bestPayload[1] << " ms\n";
+	return mismatches == 0 ? 0 : 1;
+}
+
+static int BenchmarkUtf8Validation(const std::vector<std::string>& arguments)
+{
+	std::vector<std::string> fileNames;
+	for (std::vector<std::string>::const_iterator it = arguments.begin(); it != arguments.end(); ++it)
+	{
+		CollectSourceFiles(*it, fileNames);
+	}
+	std::string text;
+	for (std::vector<std::string>::iterator it = fileNames.begin(); it != fileNames.end(); ++it)
+	{
+		ReadFileContents(*it, text);
+		text.push_back('\n');
+	}
+
+	double bestValidation = 1e300;
+	double bestLexing[2] = { 1e300, 1e300 };
+	std::size_t invalidOffset = 0;
+	std::size_t numberOfErrors[2] = { 0, 0 };
+	for (int iteration = 0; iteration < 5; ++iteration)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		invalidOffset = FindInvalidUtf8(text.data(), text.length());
+		bestValidation = std::min(bestValidation, ElapsedMilliseconds(start));
+
+		for (int validate = 0; validate < 2; ++validate)
+		{
+			LexicalAnalyzer lex;
+			lex.SetErrorRecovery(true);
+			lex.SetUtf8Validation(validate != 0);
+			start = std::chrono::steady_clock::now();
+			lex.AnalyzeBuffer(text.data(), text.length());
+			bestLexing[validate] = std::min(bestLexing[validate], ElapsedMilliseconds(start));
+			numberOfErrors[validate] = lex.GetErrorCount();
+		}
+	}
+
+	double megabytes = text.length() / 1048576.0;
+	std::cout << "Input: " << megabytes << " MB, " << (invalidOffset == text.length() ? "valid UTF-8" : "invalid UTF-8") << '\n';
+	std::cout << "Validation: " << bestValidation << " ms (" << megabytes / bestValidation * 1000.0 << " MB/s)\n";
+	std::cout << "Lexing: " << bestLexing[0] << " ms, with validation: " << bestLexing[1] << " ms\n";
+	std::cout << "Errors: " << numberOfErrors[0] << ", with validation: " << numberOfErrors[1] << '\n';
+	return 0;
+}
+
+static int BenchmarkAnalyzerPool(const std::vector<std::string>& arguments)
+{
+	if (arguments.size() < 2)
+	{
+		std::cerr << "Usage: --benchmark-pool ITERATIONS files\n";
+		return 1;
+	}
+	std::size_t iterations = std::strtoul(arguments[0].c_str(), NULL, 10);
+	std::vector<std::string> fileNames;
+	for (std::size_t i = 1; i < arguments.size(); ++i)
+	{
+		CollectSourceFiles(arguments[i], fileNames);
+	}
+	std::vector<std::string> requests(fileNames.size());
+	for (std::size_t i = 0; i < fileNames.size(); ++i)
+	{
+		if (!ReadFileContents(fileNames[i], requests[i]))
+		{
+			std::cerr << "Cannot read " << fileNames[i] << '\n';
+			return 1;
+		}
+	}
+	if (requests.empty() || iterations == 0)
+	{
+		return 0;
+	}
+
+	std::size_t freshTokens = 0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+	{
+		for (std::vector<std::string>::iterator it = requests.begin(); it != requests.end(); ++it)
+		{
+			LexicalAnalyzer lex;
+			lex.SetErrorRecovery(true);
+			lex.AnalyzeBuffer(it->data(), it->length());
+			freshTokens += lex.GetTokens().size();
+		}
+	}
+	double freshTime = ElapsedMilliseconds(start);
+
+	AnalyzerPool pool(1,
+		[](LexicalAnalyzer& lex)
+		{
+			lex.SetErrorRecovery(true);
+		});
+	std::size_t pooledTokens = 0;
+	start = std::chrono::steady_clock::now();
+	for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+	{
+		for (std::vector<std::string>::iterator it = requests.begin(); it != requests.end(); ++it)
+		{
+			PooledAnalyzer lex(pool);
+			lex->AnalyzeBuffer(it->data(), it->length());
+			pooledTokens += lex->GetTokens().size();
+		}
+	}
+	double pooledTime = ElapsedMilliseconds(start);
+
+	double numberOfRequests = static_cast<double>(iterations * requests.size());
+	std::cout << "Requests: " << iterations * requests.size() << ", tokens: " << freshTokens << '\n';
+	std::cout << "Fresh analyzer: " << freshTime * 1000 / numberOfRequests << " us per request\n";
+	std::cout << "Pooled analyzer: " << pooledTime * 1000 / numberOfRequests << " us per request ("
+		<< pool.GetNumberOfCreated() << " created)\n";
+	return freshTokens == pooledTokens ? 0 : 1;
+}
+
+static int BenchmarkInterleavedScan(const std::vector<std::string>& arguments)
+{
+	std::vector<std::string> fileNames;
+	for (std::vector<std::string>::const_iterator it = arguments.begin(); it != arguments.end(); ++it)
+	{
+		CollectSourceFiles(*it, fileNames);
+	}
+	std::vector<std::string> texts(fileNames.size());
+	std::size_t totalLength = 0;
+	for (std::size_t i = 0; i < fileNames.size(); ++i)
+	{
+		ReadFileContents(fileNames[i], texts[i]);
+		totalLength += texts[i].length();
+	}
+
+	// Every lexeme of a stream is folded into that stream's digest, so the
+	// interleaved runs can be compared with the serial one stream by stream.
+	LexicalAnalyzer lex;
+	lex.SetErrorRecovery(true);
+	std::vector<unsigned long long> serialDigests(texts.size(), 0);
+	std::vector<unsigned long long> digests(texts.size(), 0);
+	std::vector<LexicalAnalyzer::ScanStream> streams(texts.size());
+	for (std::size_t i = 0; i < texts.size(); ++i)
+	{
+		unsigned long long* digest = &serialDigests[i];
+		lex.ScanLexemes(texts[i].data(), texts[i].length(),
+			[digest](LexicalAnalyzer::LexemeType lexemeType, const char* lexeme, std::size_t length, std::size_t offset)
+			{
+				*digest = ComputeHash64(lexeme, length, *digest ^ (offset * 64 + lexemeType));
+			});
+	}
+
+	std::size_t numberOfLexemes = 0;
+	LexicalAnalyzer::LexemeHandler countLexemes =
+		[&numberOfLexemes](LexicalAnalyzer::LexemeType, const char*, std::size_t, std::size_t)
+		{
+			++numberOfLexemes;
+		};
+	double serialTime = 1e300;
+	for (int iteration = 0; iteration < 5; ++iteration)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < texts.size(); ++i)
+		{
+			lex.ScanLexemes(texts[i].data(), texts[i].length(), countLexemes);
+		}
+		serialTime = std::min(serialTime, ElapsedMilliseconds(start));
+	}
+	double megabytes = totalLength / 1048576.0;
+	std::cout << "Files: " << texts.size() << ", " << megabytes << " MB\n";
+	std::cout << "Serial: " << serialTime << " ms (" << megabytes / serialTime * 1000.0 << " MB/s)\n";
+
+	int status = 0;
+	static const std::size_t laneCounts[] = { 1, 2, 4, 8 };
+	for (std::size_t l = 0; l < sizeof(laneCounts) / sizeof(laneCounts[0]); ++l)
+	{
+		for (std::size_t i = 0; i < texts.size(); ++i)
+		{
+			unsigned long long* digest = &digests[i];
+			*digest = 0;
+			streams[i].text = texts[i].data();
+			streams[i].length = texts[i].length();
+			streams[i].handler =
+				[digest](LexicalAnalyzer::LexemeType lexemeType, const char* lexeme, std::size_t length, std::size_t offset)
+				{
+					*digest = ComputeHash64(lexeme, length, *digest ^ (offset * 64 + lexemeType));
+				};
+		}
+		lex.ScanInterleaved(streams, laneCounts[l]);
+		bool identical = digests == serialDigests;
+
+		for (std::size_t i = 0; i < texts.size(); ++i)
+		{
+			streams[i].handler = countLexemes;
+		}
+		double interleavedTime = 1e300;
+		for (int iteration = 0; iteration < 5; ++iteration)
+		{
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			lex.ScanInterleaved(streams, laneCounts[l]);
+			interleavedTime = std::min(interleavedTime, ElapsedMilliseconds(start));
+		}
+		std::cout << "Interleaved, K = " << laneCounts[l] << ": " << interleavedTime << " ms ("
+			<< megabytes / interleavedTime * 1000.0 << " MB/s, " << serialTime / interleavedTime << "x), "
+			<< (identical ? "identical" : "DIFFERENT") << " output\n";
+		if (!identical)
+		{
+			status = 1;
+		}
+	}
+	return status;
+}
+
+struct TokenDigest
+{
+	unsigned long long numberOfTokens;
+	unsigned long long digest;
+};
+
+static int DigestTokenBatch(void* context, const clexer_token* tokens, size_t count)
+{
+	TokenDigest* digest = static_cast<TokenDigest*>(context);
+	digest->numberOfTokens += count;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		digest->digest = ComputeHash64(&tokens[i], sizeof(clexer_token), digest->digest);
+	}
+	return 0;
+}
+
+// Spawns --tokens and parses its output the way an embedding toolchain that
+// shells out would: one "Type: lexeme, offset" record per line.
+static bool LexInSubprocess(char** spawnArguments, std::vector<unsigned long long>& offsets)
+{
+	int pipeDescriptors[2];
+	if (pipe(pipeDescriptors) != 0)
+	{
+		return false;
+	}
+	posix_spawn_file_actions_t fileActions;
+	posix_spawn_file_actions_init(&fileActions);
+	posix_spawn_file_actions_adddup2(&fileActions, pipeDescriptors[1], STDOUT_FILENO);
+	posix_spawn_file_actions_addclose(&fileActions, pipeDescriptors[0]);
+	pid_t child = 0;
+	bool spawned = posix_spawn(&child, spawnArguments[0], &fileActions, NULL, spawnArguments, environ) == 0;
+	posix_spawn_file_actions_destroy(&fileActions);
+	close(pipeDescriptors[1]);
+
+	std::string output;
+	char chunk[1 << 16];
+	ssize_t count;
+	while (spawned && ((count = read(pipeDescriptors[0], chunk, sizeof(chunk))) > 0 || (count < 0 && errno == EINTR)))
+	{
+		if (count > 0)
+		{
+			output.append(chunk, count);
+		}
+	}
+	close(pipeDescriptors[0]);
+	int childStatus = 0;
+	if (!spawned || waitpid(child, &childStatus, 0) != child)
+	{
+		return false;
+	}
+
+	offsets.clear();
+	std::size_t lineStart = 0;
+	while (lineStart < output.length())
+	{
+		std::size_t lineEnd = output.find('\n', lineStart);
+		if (lineEnd == std::string::npos)
+		{
+			lineEnd = output.length();
+		}
+		std::size_t typeEnd = output.find(": ", lineStart);
+		std::size_t offsetStart = output.rfind(", ", lineEnd);
+		if (typeEnd < lineEnd && offsetStart != std::string::npos && offsetStart > typeEnd)
+		{
+			offsets.push_back(std::strtoull(output.c_str() + offsetStart + 2, NULL, 10));
+		}
+		lineStart = lineEnd + 1;
+	}
+	return true;
+}
+
+static int BenchmarkCInterface(const std::vector<std::string>& arguments)
+{
+	if (arguments.size() < 2)
+	{
+		std::cerr << "Usage: --benchmark-capi ITERATIONS FILE\n";
+		return 1;
+	}
+	std::size_t iterations = std::strtoul(arguments[0].c_str(), NULL, 10);
+	if (iterations == 0)
+	{
+		iterations = 1;
+	}
+	std::string text;
+	if (!ReadFileContents(arguments[1], text))
+	{
+		std::cerr << "Cannot read " << arguments[1] << '\n';
+		return 1;
+	}
+
+	char executable[] = "/proc/self/exe";
+	char mode[] = "--tokens";
+	std::vector<char> fileNameArgument(arguments[1].begin(), arguments[1].end());
+	fileNameArgument.push_back('\0');
+	char* spawnArguments[] = { executable, mode, &fileNameArgument[0], NULL };
+	std::vector<double> processLatencies;
+	std::vector<unsigned long long> processOffsets;
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		if (!LexInSubprocess(spawnArguments, processOffsets))
+		{
+			std::cerr << "Cannot spawn the per-process lexer\n";
+			return 1;
+		}
+		processLatencies.push_back(ElapsedMilliseconds(start) * 1000.0);
+	}
+
+	clexer* lexer = clexer_create(NULL);
+	std::vector<double> callbackLatencies;
+	TokenDigest callbackDigest = { 0, 0 };
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		callbackDigest.numberOfTokens = 0;
+		callbackDigest.digest = 0;
+		clexer_lex(lexer, text.data(), text.length(), DigestTokenBatch, &callbackDigest);
+		callbackLatencies.push_back(ElapsedMilliseconds(start) * 1000.0);
+	}
+
+	std::vector<clexer_token> tokens(4096);
+	std::vector<double> arrayLatencies;
+	TokenDigest arrayDigest = { 0, 0 };
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		arrayDigest.numberOfTokens = 0;
+		arrayDigest.digest = 0;
+		std::size_t count = 0;
+		int status = clexer_lex_into(lexer, text.data(), text.length(), &tokens[0], tokens.size(), &count);
+		while (true)
+		{
+			DigestTokenBatch(&arrayDigest, &tokens[0], count);
+			if (status != CLEXER_MORE_TOKENS)
+			{
+				break;
+			}
+			status = clexer_next_tokens(lexer, &tokens[0], tokens.size(), &count);
+		}
+		arrayLatencies.push_back(ElapsedMilliseconds(start) * 1000.0);
+	}
+	clexer_destroy(lexer);
+
+	std::cout << "Tokens: " << processOffsets.size() << " from the subprocess, " << callbackDigest.numberOfTokens <<
+		" through the C interface\n";
+	DisplayLatencies("Subprocess", processLatencies);
+	DisplayLatencies("C interface, callback", callbackLatencies);
+	DisplayLatencies("C interface, array", arrayLatencies);
+	return callbackDigest.digest == arrayDigest.digest &&
+		callbackDigest.numberOfTokens == arrayDigest.numberOfTokens ? 0 : 1;
+}
+
+static int BenchmarkStructuralScan(const std::vector<std::string>& arguments)
+{
+	std::vector<std::string> fileNames;
+	for (std::vector<std::string>::const_iterator it = arguments.begin(); it != arguments.end(); ++it)
+	{
+		CollectSourceFiles(*it, fileNames);
+	}
+	std::string text;
+	for (std::vector<std::string>::iterator it = fileNames.begin(); it != fileNames.end(); ++it)
+	{
+		ReadFileContents(*it, text);
+		text.push_back('\n');
+	}
+
+	double classificationTime = 1e300;
+	unsigned long long classified = 0;
+	for (int iteration = 0; iteration < 5; ++iteration)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		StructuralBlock block;
+		for (std::size_t i = 0; i + StructuralIndex::BLOCK_SIZE < text.length(); i += StructuralIndex::BLOCK_SIZE)
+		{
+			StructuralIndex::ClassifyBlock(text.data() + i, text[i + StructuralIndex::BLOCK_SIZE], block);
+			classified += block.whitespace ^ block.identifier;
+		}
+		classificationTime = std::min(classificationTime, ElapsedMilliseconds(start));
+	}
+
+	double scanTimes[2] = { 1e300, 1e300 };
+	unsigned long long digests[2] = { 0, 0 };
+	for (int structural = 0; structural < 2; ++structural)
+	{
+		LexicalAnalyzer lex;
+		lex.SetErrorRecovery(true);
+		lex.SetStructuralScan(structural != 0);
+		unsigned long long* digest = &digests[structural];
+		lex.ScanLexemes(text.data(), text.length(),
+			[digest](LexicalAnalyzer::LexemeType lexemeType, const char* lexeme, std::size_t length, std::size_t offset)
+			{
+				*digest = ComputeHash64(lexeme, length, *digest ^ (offset * 64 + lexemeType));
+			});
+
+		std::size_t numberOfLexemes = 0;
+		for (int iteration = 0; iteration < 5; ++iteration)
+		{
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			lex.ScanLexemes(text.data(), text.length(),
+				[&numberOfLexemes](LexicalAnalyzer::LexemeType, const char*, std::size_t, std::size_t)
+				{
+					++numberOfLexemes;
+				});
+			scanTimes[structural] = std::min(scanTimes[structural], ElapsedMilliseconds(start));
+		}
+	}
+
+	double megabytes = text.length() / 1048576.0;
+	std::cout << "Input: " << megabytes << " MB (" << (classified & 1) << ")\n";
+	std::cout << "Classification: " << classificationTime << " ms (" << megabytes / classificationTime * 1000.0 << " MB/s)\n";
+	std::cout << "Byte-wise scan: " << scanTimes[0] << " ms (" << megabytes / scanTimes[0] * 1000.0 << " MB/s)\n";
+	std::cout << "Structural scan: " << scanTimes[1] << " ms (" << megabytes / scanTimes[1] * 1000.0 << " MB/s), "
+		<< (digests[0] == digests[1] ? "identical" : "DIFFERENT") << " output\n";
+	return digests[0] == digests[1] ? 0 : 1;
+}
+
+static const char* const ALLOCATOR_NAMES[] = { "heap", "pool", "arena" };
+
+// Every thread analyzes all inputs with its own analyzer and releases the
+// tokens and the dictionary after each one, as a server answering requests
+// does.
+static std::size_t AnalyzeWithAllocator(int allocator, const std::vector<std::string>& inputs, std::size_t iterations)
+{
+	std::pmr::unsynchronized_pool_resource pool;
+	LexicalAnalyzer lex;
+	lex.SetErrorRecovery(true);
+	if (allocator == 1)
+	{
+		lex.SetMemoryResource(&pool);
+	}
+	else if (allocator == 2)
+	{
+		lex.SetArenaAllocation(true);
+	}
+	std::size_t numberOfTokens = 0;
+	for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+	{
+		for (std::vector<std::string>::const_iterator it = inputs.begin(); it != inputs.end(); ++it)
+		{
+			lex.AnalyzeBuffer(it->data(), it->length());
+			numberOfTokens += lex.GetTokens().size();
+			lex.ReleaseMemory();
+		}
+	}
+	return numberOfTokens;
+}
+
+static int BenchmarkAllocators(const std::vector<std::string>& arguments)
+{
+	if (arguments.size() < 3)
+	{
+		std::cerr << "Usage: --benchmark-allocators THREADS ITERATIONS files\n";
+		return 1;
+	}
+	std::size_t maximumThreads = std::max<std::size_t>(1, std::strtoul(arguments[0].c_str(), NULL, 10));
+	std::size_t iterations = std::strtoul(arguments[1].c_str(), NULL, 10);
+	std::vector<std::string> fileNames;
+	for (std::size_t i = 2; i < arguments.size(); ++i)
+	{
+		CollectSourceFiles(arguments[i], fileNames);
+	}
+	std::vector<std::string> inputs(fileNames.size());
+	std::size_t inputLength = 0;
+	for (std::size_t i = 0; i < fileNames.size(); ++i)
+	{
+		if (!ReadFileContents(fileNames[i], inputs[i]))
+		{
+			std::cerr << "Cannot read " << fileNames[i] << '\n';
+			return 1;
+		}
+		inputLength += inputs[i].length();
+	}
+	if (inputs.empty() || iterations == 0)
+	{
+		return 0;
+	}
+
+	bool identical = true;
+	std::size_t expectedTokens = 0;
+	for (std::size_t numberOfThreads = 1; ; numberOfThreads = std::min(2 * numberOfThreads, maximumThreads))
+	{
+		std::cout << numberOfThreads << " thread(s):";
+		for (int allocator = 0; allocator < 3; ++allocator)
+		{
+			std::vector<std::size_t> numberOfTokens(numberOfThreads, 0);
+			std::vector<std::thread> threads;
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (std::size_t i = 0; i < numberOfThreads; ++i)
+			{
+				threads.push_back(std::thread(
+					[allocator, &inputs, iterations, &numberOfTokens, i]()
+					{
+						numberOfTokens[i] = AnalyzeWithAllocator(allocator, inputs, iterations);
+					}));
+			}
+			for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it)
+			{
+				it->join();
+			}
+			double time = ElapsedMilliseconds(start);
+			for (std::size_t i = 0; i < numberOfThreads; ++i)
+			{
+				if (expectedTokens == 0)
+				{
+					expectedTokens = numberOfTokens[i];
+				}
+				identical = identical && numberOfTokens[i] == expectedTokens;
+			}
+			double megabytes = static_cast<double>(inputLength) * iterations * numberOfThreads / 1048576.0;
+			std::cout << ' ' << ALLOCATOR_NAMES[allocator] << ' ' << megabytes / time * 1000.0 << " MB/s";
+		}
+		std::cout << '\n';
+		if (numberOfThreads == maximumThreads)
+		{
+			break;
+		}
+	}
+	return identical ? 0 : 1;
+}
+
+static int BuildCloneIndex(const std::vector<std::string>& arguments)
+{
+	if (arguments.empty())
+	{
+		std::cerr << "Usage: --clone-index INDEX [-j N] [-k TOKENS] [-w WINDOW] [--keep-identifiers] paths\n";
+		return 1;
+	}
+	std::size_t numberOfThreads = std::thread::hardware_concurrency();
+	std::size_t gramLength = 25;
+	std::size_t windowLength = 8;
+	bool abstractIdentifiers = true;
+	std::vector<std::string> fileNames;
+	for (std::size_t i = 1; i < arguments.size(); ++i)
+	{
+		if (arguments[i] == "-j" && i + 1 < arguments.size())
+		{
+			numberOfThreads = std::strtoul(arguments[++i].c_str(), NULL, 10);
+		}
+		else if (arguments[i] == "-k" && i + 1 < arguments.size())
+		{
+			gramLength = std::strtoul(arguments[++i].c_str(), NULL, 10);
+		}
+		else if (arguments[i] == "-w" && i + 1 < arguments.size())
+		{
+			windowLength = std::strtoul(arguments[++i].c_str(), NULL, 10);
+		}
+		else if (arguments[i] == "--keep-identifiers")
+		{
+			abstractIdentifiers = false;
+		}
+		else
+		{
+			CollectSourceFiles(arguments[i], fileNames);
+		}
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	CloneIndexBuilder builder(gramLength, windowLength, abstractIdentifiers);
+	bool status = builder.Build(fileNames, numberOfThreads);
+	if (!builder.Write(arguments[0]))
+	{
+		std::cerr << "Cannot write " << arguments[0] << '\n';
+		return 1;
+	}
+	std::cerr << "Files: " << fileNames.size() << ", tokens: " << builder.GetNumberOfTokens()
+		<< ", fingerprints: " << builder.GetNumberOfFingerprints() << ", "
+		<< ElapsedMilliseconds(start) << " ms\n";
+	return status ? 0 : 1;
+}
+
+static void DisplaySourcePosition(
+	const std::string& fileName,
+	std::size_t offset,
+	std::map<std::string, LineIndex>& lineIndices
+	)
+{
+	std::map<std::string, LineIndex>::iterator it = lineIndices.find(fileName);
+	if (it == lineIndices.end())
+	{
+		it = lineIndices.insert(std::make_pair(fileName, LineIndex())).first;
+		MappedFile inputFile;
+		if (inputFile.Open(fileName))
+		{
+			it->second.Build(inputFile.GetData(), inputFile.GetLength());
+		}
+	}
+	std::cout << fileName;
+	if (it->second.IsBuilt())
+	{
+		std::size_t line, column;
+		it->second.GetPosition(offset, line, column);
+		std::cout << ':' << line << ':' << column;
+	}
+	else
+	{
+		std::cout << '@' << offset;
+	}
+}
+
+static int FindClones(const std::vector<std::string>& arguments)
+{
+	if (arguments.empty())
+	{
+		std::cerr << "Usage: --clones INDEX [--min N] [--max-occurrences N] [--top N]\n";
+		return 1;
+	}
+	std::size_t minimumShared = 4;
+	std::size_t maximumOccurrences = 64;
+	std::size_t topCount = 50;
+	for (std::size_t i = 1; i + 1 < arguments.size(); ++i)
+	{
+		if (arguments[i] == "--min")
+		{
+			minimumShared = std::strtoul(arguments[++i].c_str(), NULL, 10);
+		}
+		else if (arguments[i] == "--max-occurrences")
+		{
+			maximumOccurrences = std::strtoul(arguments[++i].c_str(), NULL, 10);
+		}
+		else if (arguments[i] == "--top")
+		{
+			topCount = std::strtoul(arguments[++i].c_str(), NULL, 10);
+		}
+	}
+
+	CloneIndex index;
+	if (!index.Open(arguments[0]))
+	{
+		std::cerr << "Cannot read clone index " << arguments[0] << '\n';
+		return 1;
+	}
+	std::vector<ClonePair> pairs;
+	index.FindClonePairs(minimumShared, maximumOccurrences, pairs);
+
+	std::map<std::string, LineIndex> lineIndices;
+	for (std::size_t i = 0; i < pairs.size() && i < topCount; ++i)
+	{
+		DisplaySourcePosition(index.GetFileName(pairs[i].firstFileId), pairs[i].firstOffset, lineIndices);
+		std::cout << " ~ ";
+		DisplaySourcePosition(index.GetFileName(pairs[i].secondFileId), pairs[i].secondOffset, lineIndices);
+		std::cout << ", " << pairs[i].sharedFingerprints << " shared fingerprints\n";
+	}
+	std::cout << "Clone pairs: " << pairs.size() << '\n';
+	return 0;
+}
+
+static int BuildCrossReferenceIndex(const std::vector<std::string>& arguments)
+{
+	if (arguments.empty())
+	{
+		std::cerr << "Usage: --xref INDEX [-j N] [--budget MB] paths\n";
+		return 1;
+	}
+	std::size_t numberOfThreads = std::thread::hardware_concurrency();
+	std::size_t memoryBudget = 256 << 20;
+	std::vector<std::string> fileNames;
+	for (std::size_t i = 1; i < arguments.size(); ++i)
+	{
+		if (arguments[i] == "-j" && i + 1 < arguments.size())
+		{
+			numberOfThreads = std::strtoul(arguments[++i].c_str(), NULL, 10);
+		}
+		else if (arguments[i] == "--budget" && i + 1 < arguments.size())
+		{
+			memoryBudget = std::strtoul(arguments[++i].c_str(), NULL, 10) << 20;
+		}
+		else
+		{
+			CollectSourceFiles(arguments[i], fileNames);
+		}
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	CrossReferenceBuilder builder(memoryBudget);
+	bool status = builder.Build(fileNames, numberOfThreads, arguments[0]);
+	std::cerr << "Files: " << fileNames.size() << ", references: " << builder.GetNumberOfReferences()
+		<< ", segments: " << builder.GetNumberOfSegments() << ", " << ElapsedMilliseconds(start) << " ms\n";
+	return status ? 0 : 1;
+}
+
+static int MergeCrossReferenceIndexes(const std::vector<std::string>& arguments)
+{
+	if (arguments.size() < 2)
+	{
+		std::cerr << "Usage: --xref-merge INDEX inputs\n";
+		return 1;
+	}
+	if (!CrossReferenceBuilder::Merge(std::vector<std::string>(arguments.begin() + 1, arguments.end()), arguments[0]))
+	{
+		std::cerr << "Cannot merge into " << arguments[0] << '\n';
+		return 1;
+	}
+	return 0;
+}
+
+static int LookupCrossReferences(const std::vector<std::string>& arguments)
+{
+	if (arguments.empty())
+	{
+		std::cerr << "Usage: --xref-lookup INDEX identifiers\n";
+		return 1;
+	}
+	CrossReferenceIndex index;
+	if (!index.Open(arguments[0]))
+	{
+		std::cerr << "Cannot read cross-reference index " << arguments[0] << '\n';
+		return 1;
+	}
+
+	std::map<std::string, LineIndex> lineIndices;
+	std::vector<CrossReference> references;
+	for (std::size_t i = 1; i < arguments.size(); ++i)
+	{
+		references.clear();
+		index.Lookup(arguments[i], references);
+		std::cout << arguments[i] << ": " << references.size() << " references\n";
+		for (std::vector<CrossReference>::iterator it = references.begin(); it != references.end(); ++it)
+		{
+			std::cout << '\t';
+			DisplaySourcePosition(index.GetFileName(it->fileId), it->offset, lineIndices);
+			std::cout << '\n';
+		}
+	}
+	return 0;
+}
 
 int main(int argc, char **argv)
 {
+	std::vector<std::string> arguments(argv + 1, argv + argc);
+	if (!arguments.empty() && arguments[0] == "--includes")
+	{
+		return ScanIncludes(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--stats")
+	{
+		return CountLexemes(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--cache")
+	{
+		return AnalyzeWithCache(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--minify")
+	{
+		return Minify(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--batch")
+	{
+		return AnalyzeBatch(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--benchmark-literals")
+	{
+		return BenchmarkNumericLiterals(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--benchmark-utf8")
+	{
+		return BenchmarkUtf8Validation(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--benchmark-interleaved")
+	{
+		return BenchmarkInterleavedScan(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--benchmark-structural")
+	{
+		return BenchmarkStructuralScan(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--benchmark-allocators")
+	{
+		return BenchmarkAllocators(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--benchmark-pool")
+	{
+		return BenchmarkAnalyzerPool(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--tokens")
+	{
+		return DisplayTokens(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--verify-literals")
+	{
+		return VerifyLiterals();
+	}
+	if (!arguments.empty() && arguments[0] == "--verify-stream")
+	{
+		return VerifyStreaming(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--range")
+	{
+		return DisplayTokenRange(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--bounded")
+	{
+		return AnalyzeWithinBudget(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--daemon")
+	{
+		return RunDaemon(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--client")
+	{
+		return RunClient(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--clone-index")
+	{
+		return BuildCloneIndex(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--clones")
+	{
+		return FindClones(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--xref")
+	{
+		return BuildCrossReferenceIndex(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--xref-merge")
+	{
+		return MergeCrossReferenceIndexes(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--xref-lookup")
+	{
+		return LookupCrossReferences(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--benchmark-capi")
+	{
+		return BenchmarkCInterface(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+	if (!arguments.empty() && arguments[0] == "--benchmark-daemon")
+	{
+		return BenchmarkDaemon(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+	}
+
 	LexicalAnalyzer lex;
 	std::string fileName;
 
+	lex.SetErrorRecovery(true);
+	if (!arguments.empty() && arguments[0] == "--no-comments")
+	{
+		lex.SetLexemeFilter(
+			LexicalAnalyzer::MaskForLexemeType(LexicalAnalyzer::LINE_COMMENT) |
+			LexicalAnalyzer::MaskForLexemeType(LexicalAnalyzer::BLOCK_COMMENT)
+			);
+	}
+
 	std::cout << "Enter the name of the file to be parsed: ";
 	std::getline(std::cin, fileName);
 
@@ -23,6 +1726,10 @@ int main(int argc, char **argv)
 		return 0;
 	}
 	lex.DisplayLexemes();
+	if (lex.GetErrorCount() != 0)
+	{
+		lex.DisplayErrors();
+	}
 
 	return 0;
 }
@@ -0,0 +1,90 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/AnalyzerPool.hpp"
+
+AnalyzerPool::AnalyzerPool(std::size_t maximumIdle, const Configurator& configure)
+	: m_maximumIdle(maximumIdle)
+	, m_configure(configure)
+	, m_numberOfCreated(0)
+{
+	m_idle.reserve(m_maximumIdle);
+}
+
+AnalyzerPool::~AnalyzerPool()
+{
+	for (std::vector<LexicalAnalyzer*>::iterator it = m_idle.begin(); it != m_idle.end(); ++it)
+	{
+		delete *it;
+	}
+}
+
+LexicalAnalyzer* AnalyzerPool::Acquire()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_idle.empty())
+		{
+			LexicalAnalyzer* lex = m_idle.back();
+			m_idle.pop_back();
+			return lex;
+		}
+		++m_numberOfCreated;
+	}
+
+	LexicalAnalyzer* lex = new LexicalAnalyzer();
+	if (m_configure)
+	{
+		m_configure(*lex);
+	}
+	return lex;
+}
+
+void AnalyzerPool::Release(LexicalAnalyzer* lex)
+{
+	lex->Clear();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_idle.size() < m_maximumIdle)
+		{
+			m_idle.push_back(lex);
+			return;
+		}
+	}
+	delete lex;
+}
+
+std::size_t AnalyzerPool::GetNumberOfCreated() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_numberOfCreated;
+}
+
+std::size_t AnalyzerPool::GetNumberOfIdle() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_idle.size();
+}
+
+PooledAnalyzer::PooledAnalyzer(AnalyzerPool& pool)
+	: m_pool(pool)
+	, m_analyzer(pool.Acquire())
+{
+}
+
+PooledAnalyzer::~PooledAnalyzer()
+{
+	m_pool.Release(m_analyzer);
+}
+
+LexicalAnalyzer& PooledAnalyzer::operator*() const
+{
+	return *m_analyzer;
+}
+
+LexicalAnalyzer* PooledAnalyzer::operator->() const
+{
+	return m_analyzer;
+}
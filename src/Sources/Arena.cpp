@@ -0,0 +1,70 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/Arena.hpp"
+
+Arena::Arena(std::size_t blockSize)
+	: m_blockSize(blockSize == 0 ? 1 : blockSize)
+	, m_nextBlock(0)
+	, m_current(NULL)
+	, m_remaining(0)
+	, m_memoryUsage(0)
+{
+}
+
+Arena::~Arena()
+{
+	Clear();
+}
+
+char* Arena::Allocate(std::size_t length)
+{
+	while (length > m_remaining && m_nextBlock < m_blocks.size())
+	{
+		m_current = m_blocks[m_nextBlock];
+		m_remaining = m_blockSizes[m_nextBlock];
+		++m_nextBlock;
+	}
+	if (length > m_remaining)
+	{
+		std::size_t blockSize = length > m_blockSize ? length : m_blockSize;
+		m_current = new char[blockSize];
+		m_remaining = blockSize;
+		m_blocks.push_back(m_current);
+		m_blockSizes.push_back(blockSize);
+		m_nextBlock = m_blocks.size();
+		m_memoryUsage += blockSize;
+	}
+	char* data = m_current;
+	m_current += length;
+	m_remaining -= length;
+	return data;
+}
+
+void Arena::Clear()
+{
+	for (std::size_t i = 0; i < m_blocks.size(); ++i)
+	{
+		delete[] m_blocks[i];
+	}
+	m_blocks.clear();
+	m_blockSizes.clear();
+	m_nextBlock = 0;
+	m_current = NULL;
+	m_remaining = 0;
+	m_memoryUsage = 0;
+}
+
+void Arena::Reset()
+{
+	m_nextBlock = 0;
+	m_current = NULL;
+	m_remaining = 0;
+}
+
+std::size_t Arena::GetMemoryUsage() const
+{
+	return m_memoryUsage;
+}
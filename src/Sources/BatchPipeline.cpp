@@ -0,0 +1,646 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/BatchPipeline.hpp"
+#include "../Headers/FileUtilities.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const std::size_t MAXIMUM_READ_LENGTH = 1 << 30;
+static const long long MINIMUM_TRACED_WAIT = 10000;
+
+static long long Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool ReadRemainder(int fileDescriptor, std::string& data, std::size_t offset)
+{
+	while (offset < data.length())
+	{
+		ssize_t count = pread(fileDescriptor, &data[offset], data.length() - offset, offset);
+		if (count < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (count < 0)
+		{
+			return false;
+		}
+		if (count == 0)
+		{
+			data.resize(offset);
+			break;
+		}
+		offset += count;
+	}
+	return true;
+}
+
+BatchPipeline::BatchPipeline(std::size_t numberOfReaders, std::size_t numberOfWorkers, std::size_t queueDepth)
+	: m_numberOfReaders(numberOfReaders == 0 ? 1 : numberOfReaders)
+	, m_numberOfWorkers(numberOfWorkers == 0 ? 1 : numberOfWorkers)
+	, m_queueDepth(queueDepth == 0 ? 1 : queueDepth)
+	, m_filteredTypes(0)
+	, m_asyncReads(true)
+	, m_usedAsyncReads(false)
+	, m_tokenDictionary(false)
+	, m_profiling(false)
+	, m_fileNames(NULL)
+	, m_nextFile(0)
+	, m_freeBuffers(NULL)
+	, m_readyBuffers(NULL)
+	, m_results(NULL)
+	, m_success(true)
+	, m_wallTime(0)
+{
+	for (int type = 0; type < LexicalAnalyzer::NUMBER_OF_LEXEME_TYPES; ++type)
+	{
+		m_typeNames.push_back(LexicalAnalyzer::StringForLexemeType(type));
+	}
+	for (int stage = 0; stage < NUMBER_OF_STAGES; ++stage)
+	{
+		m_statistics[stage].numberOfThreads = 0;
+		m_statistics[stage].busyTime = 0;
+		m_statistics[stage].inputWaitTime = 0;
+		m_statistics[stage].outputWaitTime = 0;
+	}
+	for (int phase = 0; phase < NUMBER_OF_PHASES; ++phase)
+	{
+		m_slowestDurations[phase] = -1;
+	}
+}
+
+void BatchPipeline::SetLexemeFilter(LexicalAnalyzer::LexemeTypeMask filteredTypes)
+{
+	m_filteredTypes = filteredTypes;
+}
+
+void BatchPipeline::SetAsyncReads(bool enabled)
+{
+	m_asyncReads = enabled;
+}
+
+// Workers build each file's token dictionary with AnalyzeBuffer and print
+// the tokens from it instead of printing lexemes as they are scanned.
+void BatchPipeline::SetTokenDictionary(bool enabled)
+{
+	m_tokenDictionary = enabled;
+}
+
+void BatchPipeline::SetProfiling(bool enabled)
+{
+	m_profiling = enabled;
+}
+
+// Implies profiling. The trace is written at the end of every Run.
+void BatchPipeline::SetTraceFile(const std::string& traceFileName)
+{
+	m_traceFileName = traceFileName;
+}
+
+bool BatchPipeline::Run(const std::vector<std::string>& fileNames, std::ostream& output)
+{
+	long long start = Now();
+	m_fileNames = &fileNames;
+	m_nextFile = 0;
+	m_success = true;
+	m_resultStorage.assign(fileNames.size(), Result());
+	for (std::size_t i = 0; i < m_resultStorage.size(); ++i)
+	{
+		m_resultStorage[i].ready = false;
+		m_resultStorage[i].success = false;
+		m_resultStorage[i].formatTime = 0;
+		m_resultStorage[i].buffer = NULL;
+	}
+
+	std::size_t numberOfBuffers = 2 * m_queueDepth + m_numberOfWorkers + m_numberOfReaders;
+	m_buffers.assign(numberOfBuffers, Buffer());
+	BoundedQueue<Buffer*> freeBuffers(numberOfBuffers);
+	BoundedQueue<Buffer*> readyBuffers(m_queueDepth);
+	BoundedQueue<Result*> results(m_queueDepth);
+	for (std::size_t i = 0; i < numberOfBuffers; ++i)
+	{
+		freeBuffers.Push(&m_buffers[i]);
+	}
+	m_freeBuffers = &freeBuffers;
+	m_readyBuffers = &readyBuffers;
+	m_results = &results;
+
+	IoUring ring;
+	m_usedAsyncReads = m_asyncReads && ring.Initialize(static_cast<unsigned int>(m_queueDepth));
+	std::size_t numberOfReaders = m_usedAsyncReads ? 1 : m_numberOfReaders;
+	bool profiling = m_profiling || !m_traceFileName.empty();
+	m_profiles.assign(profiling ? numberOfReaders + m_numberOfWorkers + 1 : 0, ThreadProfile());
+	for (std::size_t i = 0; i < m_profiles.size(); ++i)
+	{
+		ThreadProfile& profile = m_profiles[i];
+		std::string threadName = i < numberOfReaders ? "Read " + std::to_string(i) :
+			i < numberOfReaders + m_numberOfWorkers ? "Lex " + std::to_string(i - numberOfReaders) : "Write";
+		profile.trace.SetThread(static_cast<unsigned int>(i + 1), threadName);
+		for (int phase = 0; phase < NUMBER_OF_PHASES; ++phase)
+		{
+			profile.slowestFiles[phase] = 0;
+		}
+	}
+	ThreadProfile* profiles = m_profiles.empty() ? NULL : &m_profiles[0];
+
+	std::vector<std::thread> readers;
+	if (m_usedAsyncReads)
+	{
+		readers.push_back(std::thread(&BatchPipeline::ReadFilesAsync, this, &ring, profiles));
+	}
+	else
+	{
+		for (std::size_t i = 0; i < numberOfReaders; ++i)
+		{
+			readers.push_back(std::thread(&BatchPipeline::ReadFiles, this, profiles == NULL ? NULL : profiles + i));
+		}
+	}
+	std::vector<std::thread> workers;
+	for (std::size_t i = 0; i < m_numberOfWorkers; ++i)
+	{
+		workers.push_back(std::thread(&BatchPipeline::LexBuffers, this,
+			profiles == NULL ? NULL : profiles + numberOfReaders + i));
+	}
+	std::thread writer(&BatchPipeline::WriteResults, this, std::ref(output),
+		profiles == NULL ? NULL : profiles + numberOfReaders + m_numberOfWorkers);
+	m_statistics[READ_STAGE].numberOfThreads = readers.size();
+	m_statistics[LEX_STAGE].numberOfThreads = workers.size();
+	m_statistics[WRITE_STAGE].numberOfThreads = 1;
+
+	for (std::size_t i = 0; i < readers.size(); ++i)
+	{
+		readers[i].join();
+	}
+	readyBuffers.Close();
+	for (std::size_t i = 0; i < workers.size(); ++i)
+	{
+		workers[i].join();
+	}
+	results.Close();
+	writer.join();
+
+	MergeProfiles();
+	if (!m_traceFileName.empty())
+	{
+		std::vector<const TraceRecorder*> recorders;
+		for (std::size_t i = 0; i < m_profiles.size(); ++i)
+		{
+			recorders.push_back(&m_profiles[i].trace);
+		}
+		if (!TraceRecorder::Write(recorders, fileNames, start, m_traceFileName))
+		{
+			std::cerr << "Cannot write " << m_traceFileName << '\n';
+			m_success = false;
+		}
+	}
+	m_profiles.clear();
+
+	m_freeBuffers = NULL;
+	m_readyBuffers = NULL;
+	m_results = NULL;
+	m_fileNames = NULL;
+	m_buffers.clear();
+	m_resultStorage.clear();
+	m_wallTime += Now() - start;
+	return m_success;
+}
+
+void BatchPipeline::RecordPhase(ThreadProfile* profile, Phase phase, std::size_t fileIndex, long long duration)
+{
+	if (duration > profile->latencies[phase].GetMaximum() || profile->latencies[phase].GetCount() == 0)
+	{
+		profile->slowestFiles[phase] = fileIndex;
+	}
+	profile->latencies[phase].Record(duration);
+}
+
+void BatchPipeline::RecordSpan(ThreadProfile* profile, const char* name, long long begin, long long end, std::size_t fileIndex)
+{
+	if (!m_traceFileName.empty())
+	{
+		profile->trace.AddSpan(name, begin, end, fileIndex);
+	}
+}
+
+void BatchPipeline::RecordWait(ThreadProfile* profile, const char* name, long long begin, long long end)
+{
+	if (profile != NULL && end - begin >= MINIMUM_TRACED_WAIT)
+	{
+		RecordSpan(profile, name, begin, end, TraceRecorder::NO_FILE);
+	}
+}
+
+void BatchPipeline::MergeProfiles()
+{
+	for (std::vector<ThreadProfile>::iterator profile = m_profiles.begin(); profile != m_profiles.end(); ++profile)
+	{
+		for (int phase = 0; phase < NUMBER_OF_PHASES; ++phase)
+		{
+			const LatencyHistogram& latencies = profile->latencies[phase];
+			if (latencies.GetCount() != 0 && latencies.GetMaximum() > m_slowestDurations[phase])
+			{
+				m_slowestDurations[phase] = latencies.GetMaximum();
+				m_slowestFiles[phase] = (*m_fileNames)[profile->slowestFiles[phase]];
+			}
+			m_latencies[phase].Merge(latencies);
+		}
+	}
+}
+
+BatchPipeline::Buffer* BatchPipeline::AcquireBuffer(bool wait, ThreadProfile* profile)
+{
+	StageStatistics& statistics = m_statistics[READ_STAGE];
+	long long start = Now();
+	Buffer* buffer = NULL;
+	if (wait)
+	{
+		m_freeBuffers->Pop(buffer);
+	}
+	else
+	{
+		m_freeBuffers->TryPop(buffer);
+	}
+	long long end = Now();
+	statistics.outputWaitTime += end - start;
+	RecordWait(profile, "wait for buffer", start, end);
+	return buffer;
+}
+
+// Returns how long the reader was blocked on a full ready queue.
+long long BatchPipeline::PushBuffer(Buffer* buffer, ThreadProfile* profile)
+{
+	StageStatistics& statistics = m_statistics[READ_STAGE];
+	long long start = Now();
+	m_readyBuffers->Push(buffer);
+	long long end = Now();
+	statistics.outputWaitTime += end - start;
+	RecordWait(profile, "wait for workers", start, end);
+	return end - start;
+}
+
+void BatchPipeline::ReadFiles(ThreadProfile* profile)
+{
+	StageStatistics& statistics = m_statistics[READ_STAGE];
+	const std::vector<std::string>& fileNames = *m_fileNames;
+	while (true)
+	{
+		// The buffer is taken before the file is claimed: the writer frees
+		// buffers in file order, so a claimed file must never wait for one.
+		Buffer* buffer = AcquireBuffer(true, profile);
+		std::size_t i = m_nextFile++;
+		if (i >= fileNames.size())
+		{
+			m_freeBuffers->Push(buffer);
+			break;
+		}
+		long long start = Now();
+		buffer->fileIndex = i;
+		buffer->data.clear();
+		buffer->success = ReadFileContents(fileNames[i], buffer->data);
+		long long end = Now();
+		statistics.busyTime += end - start;
+		if (profile != NULL)
+		{
+			RecordPhase(profile, READ_PHASE, i, end - start);
+			RecordSpan(profile, "read", start, end, i);
+		}
+		PushBuffer(buffer, profile);
+	}
+}
+
+// Reads are timed from submission until their completion is reaped; several
+// are in flight at once, so they are traced as overlapping spans. Time the
+// thread spent blocked on a full ready queue in between is its own wait span
+// and is not charged to the reads that were in flight, since their
+// completions could not be reaped meanwhile.
+void BatchPipeline::ReadFilesAsync(IoUring* ring, ThreadProfile* profile)
+{
+	struct PendingRead
+	{
+		Buffer* buffer;
+		int fileDescriptor;
+		std::size_t offset;
+		long long start;
+		long long blockedTimeAtStart;
+	};
+
+	StageStatistics& statistics = m_statistics[READ_STAGE];
+	const std::vector<std::string>& fileNames = *m_fileNames;
+	std::vector<PendingRead> reads(ring->GetNumberOfEntries());
+	std::vector<unsigned long long> freeSlots;
+	long long blockedTime = 0;
+	for (std::size_t i = reads.size(); i > 0; --i)
+	{
+		freeSlots.push_back(i - 1);
+	}
+
+	while (true)
+	{
+		while (!freeSlots.empty() && m_nextFile < fileNames.size())
+		{
+			Buffer* buffer = AcquireBuffer(freeSlots.size() == reads.size(), profile);
+			if (buffer == NULL)
+			{
+				break;
+			}
+			long long start = Now();
+			buffer->fileIndex = m_nextFile++;
+			if (buffer->fileIndex >= fileNames.size())
+			{
+				m_freeBuffers->Push(buffer);
+				break;
+			}
+			buffer->data.clear();
+			buffer->success = false;
+			int fileDescriptor = open(fileNames[buffer->fileIndex].c_str(), O_RDONLY);
+			struct stat fileStatus;
+			bool statusRead = fileDescriptor != -1 && fstat(fileDescriptor, &fileStatus) == 0;
+			if (!statusRead || fileStatus.st_size == 0)
+			{
+				buffer->success = statusRead;
+				if (fileDescriptor != -1)
+				{
+					close(fileDescriptor);
+				}
+				long long end = Now();
+				statistics.busyTime += end - start;
+				if (profile != NULL)
+				{
+					RecordPhase(profile, READ_PHASE, buffer->fileIndex, end - start);
+					RecordSpan(profile, "read", start, end, buffer->fileIndex);
+				}
+				blockedTime += PushBuffer(buffer, profile);
+				continue;
+			}
+			buffer->data.resize(static_cast<std::size_t>(fileStatus.st_size));
+
+			unsigned long long slot = freeSlots.back();
+			freeSlots.pop_back();
+			reads[slot].buffer = buffer;
+			reads[slot].fileDescriptor = fileDescriptor;
+			reads[slot].offset = 0;
+			reads[slot].start = start;
+			reads[slot].blockedTimeAtStart = blockedTime;
+			ring->PrepareRead(fileDescriptor, &buffer->data[0],
+				static_cast<unsigned int>(std::min(buffer->data.length(), MAXIMUM_READ_LENGTH)), 0, slot);
+			statistics.busyTime += Now() - start;
+		}
+		if (freeSlots.size() == reads.size())
+		{
+			if (m_nextFile >= fileNames.size())
+			{
+				break;
+			}
+			continue;
+		}
+
+		long long start = Now();
+		unsigned long long slot = 0;
+		int result = 0;
+		if (!ring->SubmitAndWait(slot, result))
+		{
+			for (std::size_t i = 0; i < reads.size(); ++i)
+			{
+				if (std::find(freeSlots.begin(), freeSlots.end(), i) != freeSlots.end())
+				{
+					continue;
+				}
+				reads[i].buffer->success = ReadRemainder(reads[i].fileDescriptor, reads[i].buffer->data, 0);
+				close(reads[i].fileDescriptor);
+				if (profile != NULL)
+				{
+					RecordPhase(profile, READ_PHASE, reads[i].buffer->fileIndex, Now() - reads[i].start);
+				}
+				PushBuffer(reads[i].buffer, profile);
+			}
+			statistics.busyTime += Now() - start;
+			ReadFiles(profile);
+			return;
+		}
+		long long end = Now();
+		statistics.inputWaitTime += end - start;
+		RecordWait(profile, "wait for reads", start, end);
+
+		start = end;
+		PendingRead& read = reads[slot];
+		std::string& data = read.buffer->data;
+		if (result > 0)
+		{
+			read.offset += result;
+			if (read.offset < data.length())
+			{
+				ring->PrepareRead(read.fileDescriptor, &data[read.offset],
+					static_cast<unsigned int>(std::min(data.length() - read.offset, MAXIMUM_READ_LENGTH)),
+					read.offset, slot);
+				statistics.busyTime += Now() - start;
+				continue;
+			}
+			read.buffer->success = true;
+		}
+		else if (result == 0)
+		{
+			data.resize(read.offset);
+			read.buffer->success = true;
+		}
+		else
+		{
+			read.buffer->success = ReadRemainder(read.fileDescriptor, data, read.offset);
+		}
+		close(read.fileDescriptor);
+		freeSlots.push_back(slot);
+		end = Now();
+		statistics.busyTime += end - start;
+		if (profile != NULL)
+		{
+			RecordPhase(profile, READ_PHASE, read.buffer->fileIndex,
+				end - read.start - (blockedTime - read.blockedTimeAtStart));
+			if (!m_traceFileName.empty())
+			{
+				profile->trace.AddOverlappingSpan("read", read.start, end, read.buffer->fileIndex);
+			}
+		}
+		blockedTime += PushBuffer(read.buffer, profile);
+	}
+}
+
+void BatchPipeline::LexBuffers(ThreadProfile* profile)
+{
+	StageStatistics& statistics = m_statistics[LEX_STAGE];
+	LexicalAnalyzer lex;
+	lex.SetErrorRecovery(true);
+	lex.SetLexemeFilter(m_filteredTypes);
+	lex.SetPhaseTiming(profile != NULL);
+
+	while (true)
+	{
+		long long start = Now();
+		Buffer* buffer = NULL;
+		if (!m_readyBuffers->Pop(buffer))
+		{
+			statistics.inputWaitTime += Now() - start;
+			break;
+		}
+		long long lexStart = Now();
+		statistics.inputWaitTime += lexStart - start;
+		RecordWait(profile, "wait for input", start, lexStart);
+
+		std::size_t fileIndex = buffer->fileIndex;
+		Result& result = m_resultStorage[fileIndex];
+		result.success = buffer->success;
+		result.buffer = buffer;
+		if (buffer->success)
+		{
+			std::string& data = result.data;
+			const std::vector<std::string>& typeNames = m_typeNames;
+			long long* formatTime = profile == NULL ? NULL : &result.formatTime;
+			LexicalAnalyzer::LexemeHandler handler =
+				[&data, &typeNames, formatTime](LexicalAnalyzer::LexemeType lexemeType, const char* lexeme, std::size_t lexemeLength, std::size_t offset)
+				{
+					long long formatStart = formatTime == NULL ? 0 : Now();
+					data += typeNames[lexemeType];
+					data += ": ";
+					data.append(lexeme, lexemeLength);
+					data += ", ";
+					data += std::to_string(offset);
+					data += '\n';
+					if (formatTime != NULL)
+					{
+						*formatTime += Now() - formatStart;
+					}
+				};
+			lex.ResetPhaseTimes();
+			if (m_tokenDictionary)
+			{
+				lex.Clear();
+				lex.AnalyzeBuffer(buffer->data.data(), buffer->data.length());
+				lex.ForEachToken(handler);
+			}
+			else
+			{
+				lex.ScanLexemes(buffer->data.data(), buffer->data.length(), handler);
+			}
+		}
+		long long pushStart = Now();
+		statistics.busyTime += pushStart - lexStart;
+		if (profile != NULL && result.success)
+		{
+			// Classification, dictionary inserts and formatting are timed
+			// inside the scan and reported as their own phases.
+			const LexicalAnalyzer::PhaseTimes& phaseTimes = lex.GetPhaseTimes();
+			RecordPhase(profile, LEX_PHASE, fileIndex, pushStart - lexStart -
+				phaseTimes.classifyTime - phaseTimes.dictionaryTime - result.formatTime);
+			RecordPhase(profile, CLASSIFY_PHASE, fileIndex, phaseTimes.classifyTime);
+			if (m_tokenDictionary)
+			{
+				RecordPhase(profile, DICTIONARY_PHASE, fileIndex, phaseTimes.dictionaryTime);
+			}
+			RecordSpan(profile, "lex", lexStart, pushStart, fileIndex);
+		}
+
+		m_results->Push(&result);
+		long long end = Now();
+		statistics.outputWaitTime += end - pushStart;
+		RecordWait(profile, "wait for writer", pushStart, end);
+	}
+}
+
+// Output time of a file is the worker's formatting time plus the write.
+void BatchPipeline::WriteResults(std::ostream& output, ThreadProfile* profile)
+{
+	StageStatistics& statistics = m_statistics[WRITE_STAGE];
+	std::size_t nextResult = 0;
+	while (true)
+	{
+		long long start = Now();
+		Result* result = NULL;
+		if (!m_results->Pop(result))
+		{
+			statistics.inputWaitTime += Now() - start;
+			break;
+		}
+		long long writeStart = Now();
+		statistics.inputWaitTime += writeStart - start;
+		RecordWait(profile, "wait for results", start, writeStart);
+
+		result->ready = true;
+		while (nextResult < m_resultStorage.size() && m_resultStorage[nextResult].ready)
+		{
+			Result& next = m_resultStorage[nextResult];
+			long long fileStart = profile == NULL ? 0 : Now();
+			if (next.success)
+			{
+				output.write(next.data.data(), next.data.length());
+			}
+			else
+			{
+				std::cerr << "Cannot read " << (*m_fileNames)[nextResult] << '\n';
+				m_success = false;
+			}
+			if (profile != NULL && next.success)
+			{
+				long long fileEnd = Now();
+				RecordPhase(profile, OUTPUT_PHASE, nextResult, next.formatTime + fileEnd - fileStart);
+				RecordSpan(profile, "write", fileStart, fileEnd, nextResult);
+			}
+			std::string().swap(next.data);
+			m_freeBuffers->Push(next.buffer);
+			next.buffer = NULL;
+			++nextResult;
+		}
+		statistics.busyTime += Now() - writeStart;
+	}
+	output.flush();
+}
+
+void BatchPipeline::DisplayUtilization(std::ostream& output)
+{
+	static const char* stageNames[NUMBER_OF_STAGES] = { "Read", "Lex", "Write" };
+
+	output << "Reads: " << (m_usedAsyncReads ? "io_uring" : "thread pool") <<
+		", queue depth " << m_queueDepth << '\n';
+	for (int stage = 0; stage < NUMBER_OF_STAGES; ++stage)
+	{
+		StageStatistics& statistics = m_statistics[stage];
+		double capacity = static_cast<double>(m_wallTime) * statistics.numberOfThreads;
+		if (capacity == 0)
+		{
+			continue;
+		}
+		output << stageNames[stage] << " (" << statistics.numberOfThreads << " threads): busy " <<
+			100.0 * statistics.busyTime / capacity << "%, waiting for input " <<
+			100.0 * statistics.inputWaitTime / capacity << "%, waiting for output " <<
+			100.0 * statistics.outputWaitTime / capacity << "%\n";
+	}
+}
+
+void BatchPipeline::DisplayLatencies(std::ostream& output)
+{
+	static const char* phaseNames[NUMBER_OF_PHASES] = { "Read", "Lex", "Classify", "Dictionary", "Output" };
+
+	for (int phase = 0; phase < NUMBER_OF_PHASES; ++phase)
+	{
+		const LatencyHistogram& latencies = m_latencies[phase];
+		if (latencies.GetCount() == 0)
+		{
+			continue;
+		}
+		output << phaseNames[phase] << " (" << latencies.GetCount() << " files, us): p50 " <<
+			latencies.GetPercentile(50) / 1000.0 << ", p90 " <<
+			latencies.GetPercentile(90) / 1000.0 << ", p99 " <<
+			latencies.GetPercentile(99) / 1000.0 << ", max " <<
+			latencies.GetMaximum() / 1000.0 << " (" << m_slowestFiles[phase] << ")\n";
+	}
+}
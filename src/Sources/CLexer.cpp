@@ -0,0 +1,390 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 19.10.2026
+**************************************************************************/
+
+#include "../Headers/CLexer.h"
+#include "../Headers/LexicalAnalyzer.hpp"
+#include "../Headers/Utf8.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct clexer_table
+{
+	std::shared_ptr<const DFA> automaton;
+};
+
+static const std::size_t LEXEME_ID_RETENTION = 1 << 16;
+
+struct clexer
+{
+	explicit clexer(const std::shared_ptr<const DFA>& automaton)
+		: analyzer(automaton)
+		, errorRecovery(true)
+		, validateUtf8(false)
+		, text(NULL)
+		, length(0)
+		, nextToken(0)
+		, numberOfErrors(0)
+	{
+	}
+
+	LexicalAnalyzer analyzer;
+	bool errorRecovery;
+	bool validateUtf8;
+	const char* text;
+	std::size_t length;
+	std::vector<clexer_token> tokens;
+	std::size_t nextToken;
+	std::size_t numberOfErrors;
+	std::unordered_map<std::string, uint64_t> lexemeIds;
+	std::string lexeme;
+};
+
+static const std::vector<std::string>& GetTypeNames()
+{
+	static const std::vector<std::string> typeNames = []()
+	{
+		std::vector<std::string> names;
+		for (int type = 0; type < LexicalAnalyzer::NUMBER_OF_LEXEME_TYPES; ++type)
+		{
+			names.push_back(LexicalAnalyzer::StringForLexemeType(type));
+		}
+		return names;
+	}();
+	return typeNames;
+}
+
+static std::size_t GetSpliceLength(const char* text, std::size_t length, std::size_t position)
+{
+	if (text[position] != '\\' || position + 1 >= length)
+	{
+		return 0;
+	}
+	if (text[position + 1] == '\n')
+	{
+		return 2;
+	}
+	if (text[position + 1] == '\r' && position + 2 < length && text[position + 2] == '\n')
+	{
+		return 3;
+	}
+	return 0;
+}
+
+// Extent in the caller's buffer of a lexeme whose line splices were removed.
+static std::size_t GetPhysicalLength(const char* text, std::size_t length, std::size_t offset, std::size_t logicalLength)
+{
+	std::size_t position = offset;
+	std::size_t remaining = logicalLength;
+	while (remaining != 0 && position < length)
+	{
+		std::size_t spliceLength = GetSpliceLength(text, length, position);
+		if (spliceLength != 0)
+		{
+			position += spliceLength;
+			continue;
+		}
+		++position;
+		--remaining;
+	}
+	return position - offset;
+}
+
+// Counts the ill-formed UTF-8 sequences (a stray byte and the continuation
+// bytes after it) that no error token already covers, as AnalyzeText does.
+static std::size_t CountUtf8Errors(const clexer* lexer, std::size_t invalidOffset)
+{
+	const char* text = lexer->text;
+	std::size_t length = lexer->length;
+	const std::vector<clexer_token>& tokens = lexer->tokens;
+	std::size_t tokenIndex = 0;
+	std::size_t numberOfErrors = 0;
+	while (invalidOffset < length)
+	{
+		std::size_t errorEnd = invalidOffset + 1;
+		while (errorEnd < length && (static_cast<unsigned char>(text[errorEnd]) & 0xC0) == 0x80)
+		{
+			++errorEnd;
+		}
+		while (tokenIndex < tokens.size() && tokens[tokenIndex].offset + tokens[tokenIndex].length <= invalidOffset)
+		{
+			++tokenIndex;
+		}
+		if (tokenIndex == tokens.size() || tokens[tokenIndex].type != LexicalAnalyzer::ERROR ||
+			tokens[tokenIndex].offset > invalidOffset)
+		{
+			++numberOfErrors;
+		}
+		invalidOffset = errorEnd + FindInvalidUtf8(text + errorEnd, length - errorEnd);
+	}
+	return numberOfErrors;
+}
+
+// Lexemes are scanned in place and only their ids are looked up, so the
+// input is never copied; equal lexemes share an id until the id table
+// outgrows its retention limit between two analyses.
+static int LexBuffer(clexer* lexer, const char* text, std::size_t length)
+{
+	lexer->text = text;
+	lexer->length = length;
+	lexer->tokens.clear();
+	lexer->nextToken = 0;
+	lexer->numberOfErrors = 0;
+	if (lexer->lexemeIds.size() > LEXEME_ID_RETENTION)
+	{
+		lexer->lexemeIds.clear();
+	}
+	std::size_t invalidOffset = lexer->validateUtf8 ? FindInvalidUtf8(text, length) : length;
+	if (invalidOffset != length && !lexer->errorRecovery)
+	{
+		++lexer->numberOfErrors;
+		return CLEXER_LEXICAL_ERROR;
+	}
+	bool status = lexer->analyzer.ScanLexemes(text, length,
+		[lexer](LexicalAnalyzer::LexemeType lexemeType, const char* lexeme, std::size_t lexemeLength, std::size_t offset)
+		{
+			lexer->lexeme.assign(lexeme, lexemeLength);
+			std::unordered_map<std::string, uint64_t>::iterator idIt = lexer->lexemeIds.find(lexer->lexeme);
+			if (idIt == lexer->lexemeIds.end())
+			{
+				idIt = lexer->lexemeIds.insert(std::make_pair(lexer->lexeme, lexer->lexemeIds.size())).first;
+			}
+			bool spliced = lexeme < lexer->text || lexeme >= lexer->text + lexer->length;
+			clexer_token token;
+			token.type = static_cast<uint32_t>(lexemeType);
+			token.length = static_cast<uint32_t>(spliced ?
+				GetPhysicalLength(lexer->text, lexer->length, offset, lexemeLength) : lexemeLength);
+			token.offset = offset;
+			token.id = idIt->second;
+			lexer->tokens.push_back(token);
+			if (lexemeType == LexicalAnalyzer::ERROR)
+			{
+				++lexer->numberOfErrors;
+			}
+		});
+	if (!status)
+	{
+		++lexer->numberOfErrors;
+		lexer->tokens.clear();
+		return CLEXER_LEXICAL_ERROR;
+	}
+	if (invalidOffset != length)
+	{
+		lexer->numberOfErrors += CountUtf8Errors(lexer, invalidOffset);
+	}
+	return CLEXER_OK;
+}
+
+int clexer_abi_version(void)
+{
+	return CLEXER_ABI_VERSION;
+}
+
+int clexer_type_count(void)
+{
+	return LexicalAnalyzer::NUMBER_OF_LEXEME_TYPES;
+}
+
+const char* clexer_type_name(int type)
+{
+	if (type < 0 || type >= LexicalAnalyzer::NUMBER_OF_LEXEME_TYPES)
+	{
+		return NULL;
+	}
+	return GetTypeNames()[type].c_str();
+}
+
+clexer_table* clexer_table_create(void)
+{
+	try
+	{
+		clexer_table* table = new clexer_table;
+		table->automaton = LexicalAnalyzer::BuildAutomaton();
+		return table;
+	}
+	catch (...)
+	{
+		return NULL;
+	}
+}
+
+const clexer_table* clexer_table_shared(void)
+{
+	try
+	{
+		static const clexer_table sharedTable = { LexicalAnalyzer::GetSharedAutomaton() };
+		return &sharedTable;
+	}
+	catch (...)
+	{
+		return NULL;
+	}
+}
+
+// Analyzers created from the table keep the automaton alive, so the table
+// may be destroyed before them.
+void clexer_table_destroy(clexer_table* table)
+{
+	delete table;
+}
+
+clexer* clexer_create(const clexer_table* table)
+{
+	try
+	{
+		if (table == NULL)
+		{
+			table = clexer_table_shared();
+			if (table == NULL)
+			{
+				return NULL;
+			}
+		}
+		clexer* lexer = new clexer(table->automaton);
+		lexer->analyzer.SetErrorRecovery(true);
+		lexer->analyzer.SetStructuralScan(true);
+		return lexer;
+	}
+	catch (...)
+	{
+		return NULL;
+	}
+}
+
+void clexer_destroy(clexer* lexer)
+{
+	delete lexer;
+}
+
+int clexer_set_option(clexer* lexer, int option, int value)
+{
+	if (lexer == NULL)
+	{
+		return CLEXER_INVALID_ARGUMENT;
+	}
+	switch (option)
+	{
+	case CLEXER_OPTION_ERROR_RECOVERY:
+		lexer->errorRecovery = value != 0;
+		lexer->analyzer.SetErrorRecovery(value != 0);
+		return CLEXER_OK;
+	case CLEXER_OPTION_SKIP_COMMENTS:
+		lexer->analyzer.SetLexemeFilter(value == 0 ? 0 :
+			LexicalAnalyzer::MaskForLexemeType(LexicalAnalyzer::LINE_COMMENT) |
+			LexicalAnalyzer::MaskForLexemeType(LexicalAnalyzer::BLOCK_COMMENT));
+		return CLEXER_OK;
+	case CLEXER_OPTION_VALIDATE_UTF8:
+		lexer->validateUtf8 = value != 0;
+		return CLEXER_OK;
+	default:
+		return CLEXER_INVALID_ARGUMENT;
+	}
+}
+
+int clexer_lex(
+	clexer* lexer,
+	const char* text,
+	size_t length,
+	clexer_token_callback callback,
+	void* context
+	)
+{
+	if (lexer == NULL || (text == NULL && length != 0) || callback == NULL)
+	{
+		return CLEXER_INVALID_ARGUMENT;
+	}
+	try
+	{
+		int status = LexBuffer(lexer, text, length);
+		if (status != CLEXER_OK)
+		{
+			return status;
+		}
+		const std::vector<clexer_token>& tokens = lexer->tokens;
+		for (std::size_t first = 0; first < tokens.size(); first += CLEXER_CALLBACK_BATCH_SIZE)
+		{
+			std::size_t count = std::min<std::size_t>(tokens.size() - first, CLEXER_CALLBACK_BATCH_SIZE);
+			if (callback(context, &tokens[first], count) != 0)
+			{
+				lexer->nextToken = tokens.size();
+				return CLEXER_STOPPED;
+			}
+		}
+		lexer->nextToken = tokens.size();
+		return CLEXER_OK;
+	}
+	catch (const std::bad_alloc&)
+	{
+		return CLEXER_OUT_OF_MEMORY;
+	}
+	catch (...)
+	{
+		return CLEXER_INTERNAL_ERROR;
+	}
+}
+
+int clexer_lex_into(
+	clexer* lexer,
+	const char* text,
+	size_t length,
+	clexer_token* tokens,
+	size_t capacity,
+	size_t* count
+	)
+{
+	if (lexer == NULL || (text == NULL && length != 0) || (tokens == NULL && capacity != 0) || count == NULL)
+	{
+		return CLEXER_INVALID_ARGUMENT;
+	}
+	*count = 0;
+	try
+	{
+		int status = LexBuffer(lexer, text, length);
+		if (status != CLEXER_OK)
+		{
+			return status;
+		}
+	}
+	catch (const std::bad_alloc&)
+	{
+		return CLEXER_OUT_OF_MEMORY;
+	}
+	catch (...)
+	{
+		return CLEXER_INTERNAL_ERROR;
+	}
+	return clexer_next_tokens(lexer, tokens, capacity, count);
+}
+
+int clexer_next_tokens(clexer* lexer, clexer_token* tokens, size_t capacity, size_t* count)
+{
+	if (lexer == NULL || (tokens == NULL && capacity != 0) || count == NULL)
+	{
+		return CLEXER_INVALID_ARGUMENT;
+	}
+	std::size_t remaining = lexer->tokens.size() - lexer->nextToken;
+	*count = std::min(remaining, capacity);
+	if (*count != 0)
+	{
+		std::memcpy(tokens, &lexer->tokens[lexer->nextToken], *count * sizeof(clexer_token));
+	}
+	lexer->nextToken += *count;
+	return lexer->nextToken < lexer->tokens.size() ? CLEXER_MORE_TOKENS : CLEXER_OK;
+}
+
+size_t clexer_token_count(const clexer* lexer)
+{
+	return lexer == NULL ? 0 : lexer->tokens.size();
+}
+
+size_t clexer_error_count(const clexer* lexer)
+{
+	return lexer == NULL ? 0 : lexer->numberOfErrors;
+}
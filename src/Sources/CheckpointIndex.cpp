@@ -0,0 +1,170 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 19.10.2026
+**************************************************************************/
+
+#include "../Headers/CheckpointIndex.hpp"
+#include "../Headers/BinaryStream.hpp"
+#include "../Headers/FileUtilities.hpp"
+#include "../Headers/Hash.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+static const unsigned int CHECKPOINT_INDEX_MAGIC = 0x544B4843;
+static const unsigned int CHECKPOINT_INDEX_VERSION = 1;
+static const unsigned long long LINE_START_FLAG = 1;
+static const unsigned long long EXPECT_HEADER_NAME_FLAG = 2;
+static const unsigned int FLAG_BITS = 2;
+
+static bool CompareCheckpointOffsets(std::size_t offset, const LexicalAnalyzer::ScanCheckpoint& checkpoint)
+{
+	return offset < checkpoint.offset;
+}
+
+CheckpointIndex::CheckpointIndex()
+	: m_contentHash(0)
+	, m_configurationHash(0)
+	, m_inputLength(0)
+{
+}
+
+// Takes the checkpoints lex recorded while scanning text, which needs a
+// checkpoint interval set before the scan.
+void CheckpointIndex::Assign(const LexicalAnalyzer& lex, const char* text, std::size_t length)
+{
+	m_contentHash = ComputeHash64(text, length);
+	m_configurationHash = lex.GetConfigurationHash();
+	m_inputLength = length;
+	m_checkpoints = lex.GetCheckpoints();
+}
+
+// Layout: magic, version, content hash, configuration hash, input length,
+// number of checkpoints, then one varint per checkpoint holding the
+// distance from the previous checkpoint shifted over the line state flags.
+bool CheckpointIndex::Write(const std::string& indexFileName) const
+{
+	std::string data;
+	BinaryWriter writer(data);
+	writer.Write<unsigned int>(CHECKPOINT_INDEX_MAGIC);
+	writer.Write<unsigned int>(CHECKPOINT_INDEX_VERSION);
+	writer.Write<unsigned long long>(m_contentHash);
+	writer.Write<unsigned long long>(m_configurationHash);
+	writer.Write<unsigned long long>(m_inputLength);
+	writer.Write<unsigned long long>(m_checkpoints.size());
+	std::size_t previousOffset = 0;
+	for (std::vector<LexicalAnalyzer::ScanCheckpoint>::const_iterator it = m_checkpoints.begin(); it != m_checkpoints.end(); ++it)
+	{
+		unsigned long long flags = (it->lineStart ? LINE_START_FLAG : 0) |
+			(it->expectHeaderName ? EXPECT_HEADER_NAME_FLAG : 0);
+		writer.WriteVarint((static_cast<unsigned long long>(it->offset - previousOffset) << FLAG_BITS) | flags);
+		previousOffset = it->offset;
+	}
+
+	std::ofstream outputFile(indexFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!outputFile.is_open())
+	{
+		return false;
+	}
+	outputFile.write(data.data(), data.length());
+	return static_cast<bool>(outputFile.flush());
+}
+
+// Loads the checkpoints of text, failing when the file was written for
+// other content or another analyzer configuration.
+bool CheckpointIndex::Read(const std::string& indexFileName, const LexicalAnalyzer& lex, const char* text, std::size_t length)
+{
+	m_checkpoints.clear();
+	MappedFile indexFile;
+	if (!indexFile.Open(indexFileName))
+	{
+		return false;
+	}
+	BinaryReader reader(indexFile.GetData(), indexFile.GetLength());
+	unsigned int magic, version;
+	unsigned long long contentHash, configurationHash, inputLength, numberOfCheckpoints;
+	if (
+		!reader.Read(magic) || magic != CHECKPOINT_INDEX_MAGIC ||
+		!reader.Read(version) || version != CHECKPOINT_INDEX_VERSION ||
+		!reader.Read(contentHash) || !reader.Read(configurationHash) ||
+		!reader.Read(inputLength) || !reader.Read(numberOfCheckpoints) ||
+		configurationHash != lex.GetConfigurationHash() || inputLength != length ||
+		numberOfCheckpoints > reader.GetRemaining() ||
+		contentHash != ComputeHash64(text, length)
+		)
+	{
+		return false;
+	}
+
+	std::vector<LexicalAnalyzer::ScanCheckpoint> checkpoints;
+	checkpoints.reserve(numberOfCheckpoints);
+	unsigned long long offset = 0;
+	for (unsigned long long i = 0; i < numberOfCheckpoints; ++i)
+	{
+		unsigned long long value;
+		if (!reader.ReadVarint(value))
+		{
+			return false;
+		}
+		offset += value >> FLAG_BITS;
+		if (i == 0 ? offset != 0 : offset >= length || (value >> FLAG_BITS) == 0)
+		{
+			return false;
+		}
+		LexicalAnalyzer::ScanCheckpoint checkpoint = {
+			static_cast<std::size_t>(offset),
+			(value & LINE_START_FLAG) != 0,
+			(value & EXPECT_HEADER_NAME_FLAG) != 0
+		};
+		checkpoints.push_back(checkpoint);
+	}
+	if (reader.GetRemaining() != 0 || (length != 0 && checkpoints.empty()))
+	{
+		return false;
+	}
+
+	m_contentHash = contentHash;
+	m_configurationHash = configurationHash;
+	m_inputLength = inputLength;
+	m_checkpoints.swap(checkpoints);
+	return true;
+}
+
+// Scans the lexemes of text that overlap [begin, end). The scan starts at
+// the last checkpoint at or before begin and stops reading at the
+// checkpoint after the first one at or past end, which leaves the lexemes
+// in range their lookahead.
+bool CheckpointIndex::ScanRange(
+	LexicalAnalyzer& lex,
+	const char* text,
+	std::size_t length,
+	std::size_t begin,
+	std::size_t end,
+	const LexicalAnalyzer::LexemeHandler& handler
+	) const
+{
+	if (length != m_inputLength || m_checkpoints.empty())
+	{
+		return length == 0 && m_inputLength == 0;
+	}
+	end = std::min(end, length);
+	if (begin >= end)
+	{
+		return true;
+	}
+	std::vector<LexicalAnalyzer::ScanCheckpoint>::const_iterator first = std::upper_bound(
+		m_checkpoints.begin(), m_checkpoints.end(), begin, CompareCheckpointOffsets) - 1;
+	std::vector<LexicalAnalyzer::ScanCheckpoint>::const_iterator last = std::upper_bound(
+		first, m_checkpoints.end(), end - 1, CompareCheckpointOffsets);
+	std::size_t scanEnd = length;
+	if (last != m_checkpoints.end() && last + 1 != m_checkpoints.end())
+	{
+		scanEnd = (last + 1)->offset;
+	}
+	return lex.ScanRange(text, scanEnd, *first, begin, end, handler);
+}
+
+std::size_t CheckpointIndex::GetNumberOfCheckpoints() const
+{
+	return m_checkpoints.size();
+}
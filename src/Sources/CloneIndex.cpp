@@ -0,0 +1,483 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/CloneIndex.hpp"
+#include "../Headers/BinaryStream.hpp"
+#include "../Headers/Hash.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+
+static const unsigned int CLONE_INDEX_MAGIC = 0x58494C43;
+static const unsigned int CLONE_INDEX_VERSION = 1;
+static const unsigned int ABSTRACT_IDENTIFIERS_FLAG = 1;
+static const unsigned long long ROLLING_HASH_BASE = 0x100000001B3ULL;
+
+static unsigned long long HashForLexemeType(int lexemeType)
+{
+	return (static_cast<unsigned long long>(lexemeType) + 1) * 0x9E3779B97F4A7C15ULL;
+}
+
+static unsigned long long MixHash(unsigned long long hash)
+{
+	hash ^= hash >> 33;
+	hash *= 0xFF51AFD7ED558CCDULL;
+	hash ^= hash >> 33;
+	hash *= 0xC4CEB9FE1A85EC53ULL;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+static bool CompareFingerprints(const Fingerprint& first, const Fingerprint& second)
+{
+	if (first.hash != second.hash)
+	{
+		return first.hash < second.hash;
+	}
+	if (first.fileId != second.fileId)
+	{
+		return first.fileId < second.fileId;
+	}
+	return first.offset < second.offset;
+}
+
+CloneIndexBuilder::CloneIndexBuilder(std::size_t gramLength, std::size_t windowLength, bool abstractIdentifiers)
+	: m_gramLength(gramLength == 0 ? 1 : gramLength)
+	, m_windowLength(windowLength == 0 ? 1 : windowLength)
+	, m_abstractIdentifiers(abstractIdentifiers)
+	, m_numberOfTokens(0)
+	, m_status(true)
+{
+}
+
+bool CloneIndexBuilder::Build(const std::vector<std::string>& fileNames, std::size_t numberOfThreads)
+{
+	if (numberOfThreads == 0)
+	{
+		numberOfThreads = 1;
+	}
+	m_fileNames = fileNames;
+	m_fingerprints.clear();
+	m_numberOfTokens = 0;
+	m_status = true;
+
+	std::vector<std::vector<Fingerprint> > fingerprints(numberOfThreads);
+	std::atomic<std::size_t> nextFile(0);
+	std::vector<std::thread> workers;
+	for (std::size_t i = 0; i < numberOfThreads; ++i)
+	{
+		workers.push_back(std::thread(
+			&CloneIndexBuilder::FingerprintFiles, this, std::ref(nextFile), std::ref(fingerprints[i])));
+	}
+	for (std::vector<std::thread>::iterator it = workers.begin(); it != workers.end(); ++it)
+	{
+		it->join();
+	}
+
+	std::size_t numberOfFingerprints = 0;
+	for (std::size_t i = 0; i < numberOfThreads; ++i)
+	{
+		numberOfFingerprints += fingerprints[i].size();
+	}
+	m_fingerprints.reserve(numberOfFingerprints);
+	for (std::size_t i = 0; i < numberOfThreads; ++i)
+	{
+		std::size_t middle = m_fingerprints.size();
+		m_fingerprints.insert(m_fingerprints.end(), fingerprints[i].begin(), fingerprints[i].end());
+		std::vector<Fingerprint>().swap(fingerprints[i]);
+		std::inplace_merge(
+			m_fingerprints.begin(), m_fingerprints.begin() + middle, m_fingerprints.end(), CompareFingerprints);
+	}
+	return m_status;
+}
+
+void CloneIndexBuilder::FingerprintFiles(std::atomic<std::size_t>& nextFile, std::vector<Fingerprint>& fingerprints)
+{
+	LexicalAnalyzer lex;
+	lex.SetErrorRecovery(true);
+	lex.SetLexemeFilter(
+		LexicalAnalyzer::MaskForLexemeType(LexicalAnalyzer::LINE_COMMENT) |
+		LexicalAnalyzer::MaskForLexemeType(LexicalAnalyzer::BLOCK_COMMENT)
+		);
+
+	std::vector<unsigned long long> tokenHashes;
+	std::vector<unsigned int> tokenOffsets;
+	bool abstractIdentifiers = m_abstractIdentifiers;
+	LexicalAnalyzer::LexemeHandler handler =
+		[&tokenHashes, &tokenOffsets, abstractIdentifiers](
+			LexicalAnalyzer::LexemeType lexemeType, const char* lexeme, std::size_t lexemeLength, std::size_t offset)
+		{
+			unsigned long long hash;
+			switch (lexemeType)
+			{
+			case LexicalAnalyzer::IDENTIFIER:
+				hash = abstractIdentifiers ?
+					HashForLexemeType(lexemeType) : ComputeHash64(lexeme, lexemeLength, lexemeType + 1);
+				break;
+			case LexicalAnalyzer::KEYWORD:
+			case LexicalAnalyzer::DELIMITER:
+			case LexicalAnalyzer::DIRECTIVE:
+				hash = ComputeHash64(lexeme, lexemeLength, lexemeType + 1);
+				break;
+			default:
+				hash = HashForLexemeType(lexemeType);
+				break;
+			}
+			tokenHashes.push_back(hash);
+			tokenOffsets.push_back(static_cast<unsigned int>(offset));
+		};
+
+	MappedFile inputFile;
+	for (std::size_t i = nextFile++; i < m_fileNames.size(); i = nextFile++)
+	{
+		if (!inputFile.Open(m_fileNames[i]) || inputFile.GetLength() > 0xFFFFFFFFULL)
+		{
+			m_status = false;
+			continue;
+		}
+		tokenHashes.clear();
+		tokenOffsets.clear();
+		lex.ScanLexemes(inputFile.GetData(), inputFile.GetLength(), handler);
+		inputFile.Close();
+
+		m_numberOfTokens += tokenHashes.size();
+		FingerprintTokens(
+			tokenHashes, tokenOffsets, static_cast<unsigned int>(i), m_gramLength, m_windowLength, fingerprints);
+	}
+	std::sort(fingerprints.begin(), fingerprints.end(), CompareFingerprints);
+}
+
+void CloneIndexBuilder::FingerprintTokens(
+	const std::vector<unsigned long long>& tokenHashes,
+	const std::vector<unsigned int>& tokenOffsets,
+	unsigned int fileId,
+	std::size_t gramLength,
+	std::size_t windowLength,
+	std::vector<Fingerprint>& fingerprints
+	)
+{
+	if (tokenHashes.size() < gramLength)
+	{
+		return;
+	}
+
+	unsigned long long leadingPower = 1;
+	for (std::size_t i = 1; i < gramLength; ++i)
+	{
+		leadingPower *= ROLLING_HASH_BASE;
+	}
+
+	std::size_t numberOfGrams = tokenHashes.size() - gramLength + 1;
+	std::vector<unsigned long long> gramHashes(numberOfGrams);
+	unsigned long long rollingHash = 0;
+	for (std::size_t i = 0; i < gramLength; ++i)
+	{
+		rollingHash = rollingHash * ROLLING_HASH_BASE + tokenHashes[i];
+	}
+	gramHashes[0] = MixHash(rollingHash);
+	for (std::size_t i = 1; i < numberOfGrams; ++i)
+	{
+		rollingHash = (rollingHash - tokenHashes[i - 1] * leadingPower) * ROLLING_HASH_BASE +
+			tokenHashes[i + gramLength - 1];
+		gramHashes[i] = MixHash(rollingHash);
+	}
+
+	// Robust winnowing: the rightmost minimum of every window is selected and
+	// recorded once, while it stays the minimum of the following windows.
+	std::deque<std::size_t> minima;
+	std::size_t lastSelected = numberOfGrams;
+	for (std::size_t i = 0; i < numberOfGrams; ++i)
+	{
+		while (!minima.empty() && gramHashes[minima.back()] >= gramHashes[i])
+		{
+			minima.pop_back();
+		}
+		minima.push_back(i);
+		if (minima.front() + windowLength <= i)
+		{
+			minima.pop_front();
+		}
+		if ((i + 1 >= windowLength || i + 1 == numberOfGrams) && minima.front() != lastSelected)
+		{
+			lastSelected = minima.front();
+			Fingerprint fingerprint;
+			fingerprint.hash = gramHashes[lastSelected];
+			fingerprint.fileId = fileId;
+			fingerprint.offset = tokenOffsets[lastSelected];
+			fingerprints.push_back(fingerprint);
+		}
+	}
+}
+
+bool CloneIndexBuilder::Write(const std::string& indexFileName) const
+{
+	std::string header;
+	BinaryWriter writer(header);
+	writer.Write<unsigned int>(CLONE_INDEX_MAGIC);
+	writer.Write<unsigned int>(CLONE_INDEX_VERSION);
+	writer.Write<unsigned int>(static_cast<unsigned int>(m_gramLength));
+	writer.Write<unsigned int>(static_cast<unsigned int>(m_windowLength));
+	writer.Write<unsigned int>(m_abstractIdentifiers ? ABSTRACT_IDENTIFIERS_FLAG : 0);
+	writer.Write<unsigned int>(static_cast<unsigned int>(m_fileNames.size()));
+	for (std::vector<std::string>::const_iterator it = m_fileNames.begin(); it != m_fileNames.end(); ++it)
+	{
+		writer.WriteVarint(it->length());
+		writer.WriteBytes(it->data(), it->length());
+	}
+	writer.Write<unsigned long long>(m_fingerprints.size());
+	header.resize((header.length() + 7) & ~static_cast<std::size_t>(7), '\0');
+
+	std::ofstream outputFile(indexFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!outputFile.is_open())
+	{
+		return false;
+	}
+	outputFile.write(header.data(), header.length());
+	for (std::vector<Fingerprint>::const_iterator it = m_fingerprints.begin(); it != m_fingerprints.end(); ++it)
+	{
+		outputFile.write(reinterpret_cast<const char*>(&it->hash), sizeof(it->hash));
+		outputFile.write(reinterpret_cast<const char*>(&it->fileId), sizeof(it->fileId));
+		outputFile.write(reinterpret_cast<const char*>(&it->offset), sizeof(it->offset));
+	}
+	return static_cast<bool>(outputFile.flush());
+}
+
+std::size_t CloneIndexBuilder::GetNumberOfTokens() const
+{
+	return m_numberOfTokens;
+}
+
+std::size_t CloneIndexBuilder::GetNumberOfFingerprints() const
+{
+	return m_fingerprints.size();
+}
+
+static const std::size_t FINGERPRINT_RECORD_SIZE =
+	sizeof(unsigned long long) + sizeof(unsigned int) + sizeof(unsigned int);
+
+CloneIndex::CloneIndex()
+	: m_gramLength(0)
+	, m_windowLength(0)
+	, m_fingerprints(NULL)
+	, m_numberOfFingerprints(0)
+{
+}
+
+bool CloneIndex::Open(const std::string& indexFileName)
+{
+	m_fileNames.clear();
+	m_fingerprints = NULL;
+	m_numberOfFingerprints = 0;
+	if (!m_file.Open(indexFileName))
+	{
+		return false;
+	}
+
+	BinaryReader reader(m_file.GetData(), m_file.GetLength());
+	unsigned int magic, version, gramLength, windowLength, flags, numberOfFiles;
+	if (
+		!reader.Read(magic) || magic != CLONE_INDEX_MAGIC ||
+		!reader.Read(version) || version != CLONE_INDEX_VERSION ||
+		!reader.Read(gramLength) || !reader.Read(windowLength) ||
+		!reader.Read(flags) || !reader.Read(numberOfFiles)
+		)
+	{
+		return false;
+	}
+	for (unsigned int i = 0; i < numberOfFiles; ++i)
+	{
+		unsigned long long length;
+		const char* fileName;
+		if (!reader.ReadVarint(length) || !reader.ReadBytes(fileName, length))
+		{
+			return false;
+		}
+		m_fileNames.push_back(std::string(fileName, length));
+	}
+	unsigned long long numberOfFingerprints;
+	if (!reader.Read(numberOfFingerprints))
+	{
+		return false;
+	}
+	std::size_t padding = ((reader.GetPosition() + 7) & ~static_cast<std::size_t>(7)) - reader.GetPosition();
+	const char* fingerprints;
+	if (
+		!reader.ReadBytes(fingerprints, padding) ||
+		reader.GetRemaining() / FINGERPRINT_RECORD_SIZE < numberOfFingerprints ||
+		!reader.ReadBytes(fingerprints, numberOfFingerprints * FINGERPRINT_RECORD_SIZE)
+		)
+	{
+		m_fileNames.clear();
+		return false;
+	}
+
+	m_gramLength = gramLength;
+	m_windowLength = windowLength;
+	m_fingerprints = fingerprints;
+	m_numberOfFingerprints = numberOfFingerprints;
+	return true;
+}
+
+std::size_t CloneIndex::GetGramLength() const
+{
+	return m_gramLength;
+}
+
+std::size_t CloneIndex::GetWindowLength() const
+{
+	return m_windowLength;
+}
+
+std::size_t CloneIndex::GetNumberOfFiles() const
+{
+	return m_fileNames.size();
+}
+
+const std::string& CloneIndex::GetFileName(unsigned int fileId) const
+{
+	return m_fileNames[fileId];
+}
+
+std::size_t CloneIndex::GetNumberOfFingerprints() const
+{
+	return m_numberOfFingerprints;
+}
+
+Fingerprint CloneIndex::GetFingerprint(std::size_t index) const
+{
+	const char* record = m_fingerprints + index * FINGERPRINT_RECORD_SIZE;
+	Fingerprint fingerprint;
+	std::memcpy(&fingerprint.hash, record, sizeof(fingerprint.hash));
+	std::memcpy(&fingerprint.fileId, record + sizeof(fingerprint.hash), sizeof(fingerprint.fileId));
+	std::memcpy(
+		&fingerprint.offset, record + sizeof(fingerprint.hash) + sizeof(fingerprint.fileId), sizeof(fingerprint.offset));
+	return fingerprint;
+}
+
+void CloneIndex::Lookup(unsigned long long hash, std::vector<Fingerprint>& fingerprints) const
+{
+	std::size_t first = 0;
+	std::size_t last = m_numberOfFingerprints;
+	while (first < last)
+	{
+		std::size_t middle = first + (last - first) / 2;
+		if (GetFingerprint(middle).hash < hash)
+		{
+			first = middle + 1;
+		}
+		else
+		{
+			last = middle;
+		}
+	}
+	for (; first < m_numberOfFingerprints; ++first)
+	{
+		Fingerprint fingerprint = GetFingerprint(first);
+		if (fingerprint.hash != hash)
+		{
+			break;
+		}
+		fingerprints.push_back(fingerprint);
+	}
+}
+
+void CloneIndex::FindClonePairs(
+	std::size_t minimumShared,
+	std::size_t maximumOccurrences,
+	std::vector<ClonePair>& pairs
+	) const
+{
+	// Each shared hash is counted once per file pair; hashes occurring more
+	// than maximumOccurrences times are boilerplate and are skipped.
+	struct PairState
+	{
+		ClonePair pair;
+		unsigned long long lastHash;
+	};
+	std::unordered_map<unsigned long long, PairState> pairStates;
+	std::vector<Fingerprint> group;
+	for (std::size_t first = 0; first < m_numberOfFingerprints; )
+	{
+		group.clear();
+		group.push_back(GetFingerprint(first));
+		std::size_t last = first + 1;
+		for (; last < m_numberOfFingerprints; ++last)
+		{
+			Fingerprint fingerprint = GetFingerprint(last);
+			if (fingerprint.hash != group[0].hash)
+			{
+				break;
+			}
+			group.push_back(fingerprint);
+		}
+		first = last;
+		if (group.size() < 2 || group.size() > maximumOccurrences)
+		{
+			continue;
+		}
+
+		for (std::size_t i = 0; i < group.size(); ++i)
+		{
+			for (std::size_t j = i + 1; j < group.size(); ++j)
+			{
+				unsigned long long key =
+					(static_cast<unsigned long long>(group[i].fileId) << 32) | group[j].fileId;
+				std::unordered_map<unsigned long long, PairState>::iterator it = pairStates.find(key);
+				if (it == pairStates.end())
+				{
+					PairState state;
+					state.pair.firstFileId = group[i].fileId;
+					state.pair.secondFileId = group[j].fileId;
+					state.pair.firstOffset = group[i].offset;
+					state.pair.secondOffset = group[j].offset;
+					state.pair.sharedFingerprints = 1;
+					state.lastHash = group[0].hash;
+					pairStates.insert(std::make_pair(key, state));
+				}
+				else if (it->second.lastHash != group[0].hash)
+				{
+					++it->second.pair.sharedFingerprints;
+					it->second.lastHash = group[0].hash;
+					if (group[i].offset < it->second.pair.firstOffset)
+					{
+						it->second.pair.firstOffset = group[i].offset;
+						it->second.pair.secondOffset = group[j].offset;
+					}
+				}
+			}
+		}
+	}
+
+	pairs.clear();
+	for (
+		std::unordered_map<unsigned long long, PairState>::iterator it = pairStates.begin();
+		it != pairStates.end();
+		++it
+		)
+	{
+		if (it->second.pair.sharedFingerprints >= minimumShared)
+		{
+			pairs.push_back(it->second.pair);
+		}
+	}
+	std::sort(pairs.begin(), pairs.end(),
+		[](const ClonePair& first, const ClonePair& second)
+		{
+			if (first.sharedFingerprints != second.sharedFingerprints)
+			{
+				return first.sharedFingerprints > second.sharedFingerprints;
+			}
+			if (first.firstFileId != second.firstFileId)
+			{
+				return first.firstFileId < second.firstFileId;
+			}
+			return first.secondFileId < second.secondFileId;
+		});
+}
@@ -0,0 +1,59 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/CountMinSketch.hpp"
+
+#include <algorithm>
+
+CountMinSketch::CountMinSketch(std::size_t width, std::size_t depth)
+	: m_width(width)
+	, m_depth(depth)
+	, m_counters(width * depth, 0)
+{
+}
+
+std::size_t CountMinSketch::GetCounterIndex(unsigned long long hash, std::size_t row) const
+{
+	// Rows are indexed by double hashing on the two halves of a single hash.
+	unsigned long long low = hash & 0xFFFFFFFFULL;
+	unsigned long long high = (hash >> 32) | 1;
+	return row * m_width + static_cast<std::size_t>((low + row * high) % m_width);
+}
+
+void CountMinSketch::Add(unsigned long long hash, unsigned long long count)
+{
+	for (std::size_t row = 0; row < m_depth; ++row)
+	{
+		m_counters[GetCounterIndex(hash, row)] += count;
+	}
+}
+
+unsigned long long CountMinSketch::Estimate(unsigned long long hash) const
+{
+	unsigned long long estimate = m_counters[GetCounterIndex(hash, 0)];
+	for (std::size_t row = 1; row < m_depth; ++row)
+	{
+		estimate = std::min(estimate, m_counters[GetCounterIndex(hash, row)]);
+	}
+	return estimate;
+}
+
+bool CountMinSketch::Merge(const CountMinSketch& other)
+{
+	if (other.m_width != m_width || other.m_depth != m_depth)
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < m_counters.size(); ++i)
+	{
+		m_counters[i] += other.m_counters[i];
+	}
+	return true;
+}
+
+std::size_t CountMinSketch::GetMemoryUsage() const
+{
+	return m_counters.size() * sizeof(unsigned long long);
+}
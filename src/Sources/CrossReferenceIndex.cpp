@@ -0,0 +1,601 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/CrossReferenceIndex.hpp"
+#include "../Headers/LexicalAnalyzer.hpp"
+#include "../Headers/BinaryStream.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+static const unsigned int CROSS_REFERENCE_MAGIC = 0x46455258;
+static const std::size_t DIRECTORY_ENTRY_SIZE = 32;
+static const std::size_t FOOTER_SIZE = 40;
+
+// Posting lists store the file id as a delta from the previous reference;
+// the offset is a delta within the same file and absolute otherwise.
+static void EncodeReference(
+	BinaryWriter& writer,
+	unsigned int fileId,
+	unsigned long long offset,
+	bool first,
+	unsigned int& lastFileId,
+	unsigned long long& lastOffset
+	)
+{
+	unsigned int fileDelta = first ? fileId : fileId - lastFileId;
+	writer.WriteVarint(fileDelta);
+	writer.WriteVarint(first || fileDelta != 0 ? offset : offset - lastOffset);
+	lastFileId = fileId;
+	lastOffset = offset;
+}
+
+static bool DecodeReferences(
+	const char* data,
+	std::size_t length,
+	unsigned int numberOfReferences,
+	std::size_t numberOfFiles,
+	std::vector<CrossReference>& references
+	)
+{
+	BinaryReader reader(data, length);
+	CrossReference reference;
+	reference.fileId = 0;
+	reference.offset = 0;
+	for (unsigned int i = 0; i < numberOfReferences; ++i)
+	{
+		unsigned long long fileDelta, offset;
+		if (!reader.ReadVarint(fileDelta) || !reader.ReadVarint(offset))
+		{
+			return false;
+		}
+		if (fileDelta >= numberOfFiles - reference.fileId)
+		{
+			return false;
+		}
+		reference.fileId += static_cast<unsigned int>(fileDelta);
+		reference.offset = i != 0 && fileDelta == 0 ? reference.offset + offset : offset;
+		references.push_back(reference);
+	}
+	return true;
+}
+
+// Writes an index from its sorted parts. Layout: magic, posting lists,
+// identifier names, file table, directory and footer.
+class CrossReferenceWriter
+{
+public:
+	explicit CrossReferenceWriter(const std::string& indexFileName)
+		: m_outputFile(indexFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc)
+		, m_position(0)
+		, m_numberOfIdentifiers(0)
+	{
+		std::string header;
+		BinaryWriter writer(header);
+		writer.Write<unsigned int>(CROSS_REFERENCE_MAGIC);
+		WriteData(header);
+	}
+
+	bool IsOpen() const
+	{
+		return m_outputFile.is_open();
+	}
+
+	void AddIdentifier(const std::string& identifier, unsigned int numberOfReferences, const std::string& postings)
+	{
+		BinaryWriter writer(m_directory);
+		writer.Write<unsigned long long>(m_names.length());
+		writer.Write<unsigned int>(static_cast<unsigned int>(identifier.length()));
+		writer.Write<unsigned int>(numberOfReferences);
+		writer.Write<unsigned long long>(m_position);
+		writer.Write<unsigned long long>(postings.length());
+		m_names.append(identifier);
+		WriteData(postings);
+		++m_numberOfIdentifiers;
+	}
+
+	bool Finish(const std::vector<std::string>& fileNames)
+	{
+		unsigned long long namesOffset = m_position;
+		WriteData(m_names);
+
+		std::string fileTable;
+		BinaryWriter writer(fileTable);
+		for (std::vector<std::string>::const_iterator it = fileNames.begin(); it != fileNames.end(); ++it)
+		{
+			writer.WriteVarint(it->length());
+			writer.WriteBytes(it->data(), it->length());
+		}
+		fileTable.resize(fileTable.length() + (8 - (m_position + fileTable.length()) % 8) % 8, '\0');
+		unsigned long long fileTableOffset = m_position;
+		WriteData(fileTable);
+
+		unsigned long long directoryOffset = m_position;
+		WriteData(m_directory);
+
+		std::string footer;
+		BinaryWriter footerWriter(footer);
+		footerWriter.Write<unsigned long long>(namesOffset);
+		footerWriter.Write<unsigned long long>(fileTableOffset);
+		footerWriter.Write<unsigned long long>(directoryOffset);
+		footerWriter.Write<unsigned long long>(m_numberOfIdentifiers);
+		footerWriter.Write<unsigned int>(static_cast<unsigned int>(fileNames.size()));
+		footerWriter.Write<unsigned int>(CROSS_REFERENCE_MAGIC);
+		WriteData(footer);
+		return static_cast<bool>(m_outputFile.flush());
+	}
+
+private:
+	void WriteData(const std::string& data)
+	{
+		m_outputFile.write(data.data(), data.length());
+		m_position += data.length();
+	}
+
+private:
+	std::ofstream m_outputFile;
+	unsigned long long m_position;
+	unsigned long long m_numberOfIdentifiers;
+	std::string m_names;
+	std::string m_directory;
+};
+
+CrossReferenceSegment::CrossReferenceSegment()
+	: m_memoryUsage(0)
+{
+}
+
+unsigned int CrossReferenceSegment::AddFile(const std::string& fileName)
+{
+	m_fileNames.push_back(fileName);
+	m_memoryUsage += fileName.length() + sizeof(std::string);
+	return static_cast<unsigned int>(m_fileNames.size() - 1);
+}
+
+void CrossReferenceSegment::AddReference(
+	const char* identifier,
+	std::size_t length,
+	unsigned int fileId,
+	unsigned long long offset
+	)
+{
+	m_identifier.assign(identifier, length);
+	std::unordered_map<std::string, Postings>::iterator it = m_postings.find(m_identifier);
+	if (it == m_postings.end())
+	{
+		Postings newPostings;
+		newPostings.numberOfReferences = 0;
+		newPostings.lastFileId = 0;
+		newPostings.lastOffset = 0;
+		it = m_postings.insert(std::make_pair(m_identifier, newPostings)).first;
+		m_memoryUsage += length + sizeof(Postings) + 64;
+	}
+	Postings& postings = it->second;
+	std::size_t previousLength = postings.data.length();
+	BinaryWriter writer(postings.data);
+	EncodeReference(
+		writer, fileId, offset, postings.numberOfReferences == 0, postings.lastFileId, postings.lastOffset);
+	++postings.numberOfReferences;
+	m_memoryUsage += postings.data.length() - previousLength;
+}
+
+bool CrossReferenceSegment::IsEmpty() const
+{
+	return m_fileNames.empty();
+}
+
+std::size_t CrossReferenceSegment::GetMemoryUsage() const
+{
+	return m_memoryUsage;
+}
+
+bool CrossReferenceSegment::Write(const std::string& indexFileName) const
+{
+	std::vector<std::unordered_map<std::string, Postings>::const_iterator> identifiers;
+	identifiers.reserve(m_postings.size());
+	for (
+		std::unordered_map<std::string, Postings>::const_iterator it = m_postings.begin();
+		it != m_postings.end();
+		++it
+		)
+	{
+		identifiers.push_back(it);
+	}
+	std::sort(identifiers.begin(), identifiers.end(),
+		[](std::unordered_map<std::string, Postings>::const_iterator first,
+			std::unordered_map<std::string, Postings>::const_iterator second)
+		{
+			return first->first < second->first;
+		});
+
+	CrossReferenceWriter writer(indexFileName);
+	if (!writer.IsOpen())
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < identifiers.size(); ++i)
+	{
+		writer.AddIdentifier(identifiers[i]->first, identifiers[i]->second.numberOfReferences, identifiers[i]->second.data);
+	}
+	return writer.Finish(m_fileNames);
+}
+
+void CrossReferenceSegment::Clear()
+{
+	m_fileNames.clear();
+	m_postings.clear();
+	m_memoryUsage = 0;
+}
+
+CrossReferenceIndex::CrossReferenceIndex()
+	: m_names(NULL)
+	, m_directory(NULL)
+	, m_numberOfIdentifiers(0)
+{
+}
+
+bool CrossReferenceIndex::Open(const std::string& indexFileName)
+{
+	m_fileNames.clear();
+	m_names = NULL;
+	m_directory = NULL;
+	m_numberOfIdentifiers = 0;
+	if (!m_file.Open(indexFileName) || m_file.GetLength() < FOOTER_SIZE + sizeof(unsigned int))
+	{
+		return false;
+	}
+
+	const char* data = m_file.GetData();
+	std::size_t length = m_file.GetLength();
+	BinaryReader footerReader(data + length - FOOTER_SIZE, FOOTER_SIZE);
+	unsigned long long namesOffset, fileTableOffset, directoryOffset, numberOfIdentifiers;
+	unsigned int numberOfFiles, magic;
+	footerReader.Read(namesOffset);
+	footerReader.Read(fileTableOffset);
+	footerReader.Read(directoryOffset);
+	footerReader.Read(numberOfIdentifiers);
+	footerReader.Read(numberOfFiles);
+	footerReader.Read(magic);
+	std::size_t footerOffset = length - FOOTER_SIZE;
+	if (
+		magic != CROSS_REFERENCE_MAGIC ||
+		namesOffset > fileTableOffset || fileTableOffset > directoryOffset || directoryOffset > footerOffset ||
+		(footerOffset - directoryOffset) / DIRECTORY_ENTRY_SIZE != numberOfIdentifiers
+		)
+	{
+		return false;
+	}
+
+	BinaryReader fileTableReader(data + fileTableOffset, directoryOffset - fileTableOffset);
+	for (unsigned int i = 0; i < numberOfFiles; ++i)
+	{
+		unsigned long long nameLength;
+		const char* fileName;
+		if (!fileTableReader.ReadVarint(nameLength) || !fileTableReader.ReadBytes(fileName, nameLength))
+		{
+			m_fileNames.clear();
+			return false;
+		}
+		m_fileNames.push_back(std::string(fileName, nameLength));
+	}
+
+	// Every entry must point inside the names section and the posting lists
+	// before it; lookups index the mapping with these offsets unchecked.
+	m_directory = data + directoryOffset;
+	std::size_t namesLength = fileTableOffset - namesOffset;
+	for (std::size_t i = 0; i < numberOfIdentifiers; ++i)
+	{
+		DirectoryEntry entry = GetDirectoryEntry(i);
+		if (
+			entry.nameOffset > namesLength || entry.nameLength > namesLength - entry.nameOffset ||
+			entry.postingsOffset > namesOffset || entry.postingsLength > namesOffset - entry.postingsOffset
+			)
+		{
+			m_fileNames.clear();
+			m_directory = NULL;
+			return false;
+		}
+	}
+
+	m_names = data + namesOffset;
+	m_numberOfIdentifiers = numberOfIdentifiers;
+	return true;
+}
+
+std::size_t CrossReferenceIndex::GetNumberOfFiles() const
+{
+	return m_fileNames.size();
+}
+
+const std::string& CrossReferenceIndex::GetFileName(unsigned int fileId) const
+{
+	return m_fileNames[fileId];
+}
+
+std::size_t CrossReferenceIndex::GetNumberOfIdentifiers() const
+{
+	return m_numberOfIdentifiers;
+}
+
+std::string CrossReferenceIndex::GetIdentifier(std::size_t index) const
+{
+	DirectoryEntry entry = GetDirectoryEntry(index);
+	return std::string(m_names + entry.nameOffset, entry.nameLength);
+}
+
+CrossReferenceIndex::DirectoryEntry CrossReferenceIndex::GetDirectoryEntry(std::size_t index) const
+{
+	BinaryReader reader(m_directory + index * DIRECTORY_ENTRY_SIZE, DIRECTORY_ENTRY_SIZE);
+	DirectoryEntry entry;
+	reader.Read(entry.nameOffset);
+	reader.Read(entry.nameLength);
+	reader.Read(entry.numberOfReferences);
+	reader.Read(entry.postingsOffset);
+	reader.Read(entry.postingsLength);
+	return entry;
+}
+
+bool CrossReferenceIndex::Lookup(const std::string& identifier, std::vector<CrossReference>& references) const
+{
+	std::size_t first = 0;
+	std::size_t last = m_numberOfIdentifiers;
+	while (first < last)
+	{
+		std::size_t middle = first + (last - first) / 2;
+		DirectoryEntry entry = GetDirectoryEntry(middle);
+		int comparison = identifier.compare(0, std::string::npos, m_names + entry.nameOffset, entry.nameLength);
+		if (comparison == 0)
+		{
+			return GetReferences(middle, references);
+		}
+		if (comparison > 0)
+		{
+			first = middle + 1;
+		}
+		else
+		{
+			last = middle;
+		}
+	}
+	return false;
+}
+
+bool CrossReferenceIndex::GetReferences(std::size_t index, std::vector<CrossReference>& references) const
+{
+	DirectoryEntry entry = GetDirectoryEntry(index);
+	std::size_t length = m_file.GetLength();
+	if (entry.postingsOffset > length || entry.postingsLength > length - entry.postingsOffset)
+	{
+		return false;
+	}
+	return DecodeReferences(
+		m_file.GetData() + entry.postingsOffset, entry.postingsLength, entry.numberOfReferences,
+		m_fileNames.size(), references);
+}
+
+CrossReferenceBuilder::CrossReferenceBuilder(std::size_t memoryBudget)
+	: m_memoryBudget(memoryBudget)
+	, m_numberOfReferences(0)
+	, m_numberOfSegments(0)
+	, m_status(true)
+{
+}
+
+bool CrossReferenceBuilder::Build(
+	const std::vector<std::string>& fileNames,
+	std::size_t numberOfThreads,
+	const std::string& indexFileName
+	)
+{
+	if (numberOfThreads == 0)
+	{
+		numberOfThreads = 1;
+	}
+	m_numberOfReferences = 0;
+	m_status = true;
+
+	std::vector<std::vector<std::string> > segmentFileNames(numberOfThreads);
+	std::atomic<std::size_t> nextFile(0);
+	std::vector<std::thread> workers;
+	for (std::size_t i = 0; i < numberOfThreads; ++i)
+	{
+		char segmentSuffix[32];
+		std::snprintf(segmentSuffix, sizeof(segmentSuffix), ".segment-%lu-", static_cast<unsigned long>(i));
+		workers.push_back(std::thread(
+			&CrossReferenceBuilder::IndexFiles, this, std::cref(fileNames), std::ref(nextFile),
+			indexFileName + segmentSuffix, m_memoryBudget / numberOfThreads, std::ref(segmentFileNames[i])));
+	}
+	for (std::vector<std::thread>::iterator it = workers.begin(); it != workers.end(); ++it)
+	{
+		it->join();
+	}
+
+	std::vector<std::string> segments;
+	for (std::size_t i = 0; i < numberOfThreads; ++i)
+	{
+		segments.insert(segments.end(), segmentFileNames[i].begin(), segmentFileNames[i].end());
+	}
+	m_numberOfSegments = segments.size();
+
+	bool status;
+	if (segments.size() == 1)
+	{
+		status = std::rename(segments[0].c_str(), indexFileName.c_str()) == 0;
+	}
+	else
+	{
+		status = Merge(segments, indexFileName);
+	}
+	for (std::vector<std::string>::iterator it = segments.begin(); it != segments.end(); ++it)
+	{
+		std::remove(it->c_str());
+	}
+	return status && m_status;
+}
+
+void CrossReferenceBuilder::IndexFiles(
+	const std::vector<std::string>& fileNames,
+	std::atomic<std::size_t>& nextFile,
+	const std::string& segmentPrefix,
+	std::size_t memoryBudget,
+	std::vector<std::string>& segmentFileNames
+	)
+{
+	LexicalAnalyzer lex;
+	lex.SetErrorRecovery(true);
+	lex.SetLexemeFilter(~LexicalAnalyzer::MaskForLexemeType(LexicalAnalyzer::IDENTIFIER));
+
+	CrossReferenceSegment segment;
+	unsigned int fileId = 0;
+	std::size_t numberOfReferences = 0;
+	LexicalAnalyzer::LexemeHandler handler =
+		[&segment, &fileId, &numberOfReferences](
+			LexicalAnalyzer::LexemeType, const char* lexeme, std::size_t lexemeLength, std::size_t offset)
+		{
+			segment.AddReference(lexeme, lexemeLength, fileId, offset);
+			++numberOfReferences;
+		};
+
+	MappedFile inputFile;
+	for (std::size_t i = nextFile++; i < fileNames.size(); i = nextFile++)
+	{
+		if (!inputFile.Open(fileNames[i]))
+		{
+			m_status = false;
+			continue;
+		}
+		fileId = segment.AddFile(fileNames[i]);
+		lex.ScanLexemes(inputFile.GetData(), inputFile.GetLength(), handler);
+		inputFile.Close();
+		if (segment.GetMemoryUsage() > memoryBudget)
+		{
+			WriteSegment(segment, segmentPrefix, segmentFileNames);
+		}
+	}
+	if (!segment.IsEmpty())
+	{
+		WriteSegment(segment, segmentPrefix, segmentFileNames);
+	}
+	m_numberOfReferences += numberOfReferences;
+}
+
+void CrossReferenceBuilder::WriteSegment(
+	CrossReferenceSegment& segment,
+	const std::string& segmentPrefix,
+	std::vector<std::string>& segmentFileNames
+	)
+{
+	char segmentNumber[32];
+	std::snprintf(segmentNumber, sizeof(segmentNumber), "%lu", static_cast<unsigned long>(segmentFileNames.size()));
+	segmentFileNames.push_back(segmentPrefix + segmentNumber);
+	if (!segment.Write(segmentFileNames.back()))
+	{
+		m_status = false;
+	}
+	segment.Clear();
+}
+
+std::size_t CrossReferenceBuilder::GetNumberOfReferences() const
+{
+	return m_numberOfReferences;
+}
+
+std::size_t CrossReferenceBuilder::GetNumberOfSegments() const
+{
+	return m_numberOfSegments;
+}
+
+bool CrossReferenceBuilder::Merge(const std::vector<std::string>& inputFileNames, const std::string& indexFileName)
+{
+	// Inputs keep their order: file ids of input i are shifted past the files
+	// of the previous inputs, so concatenating the posting lists of an
+	// identifier in input order keeps them sorted.
+	std::vector<CrossReferenceIndex> inputs(inputFileNames.size());
+	std::vector<unsigned int> fileIdBases(inputFileNames.size());
+	std::vector<std::string> fileNames;
+	for (std::size_t i = 0; i < inputFileNames.size(); ++i)
+	{
+		if (!inputs[i].Open(inputFileNames[i]))
+		{
+			return false;
+		}
+		fileIdBases[i] = static_cast<unsigned int>(fileNames.size());
+		for (std::size_t j = 0; j < inputs[i].GetNumberOfFiles(); ++j)
+		{
+			fileNames.push_back(inputs[i].GetFileName(static_cast<unsigned int>(j)));
+		}
+	}
+
+	CrossReferenceWriter writer(indexFileName);
+	if (!writer.IsOpen())
+	{
+		return false;
+	}
+	std::vector<std::size_t> positions(inputs.size(), 0);
+	std::vector<std::string> identifiers(inputs.size());
+	for (std::size_t i = 0; i < inputs.size(); ++i)
+	{
+		if (inputs[i].GetNumberOfIdentifiers() != 0)
+		{
+			identifiers[i] = inputs[i].GetIdentifier(0);
+		}
+	}
+
+	std::vector<CrossReference> references;
+	std::string postings;
+	for (;;)
+	{
+		std::size_t smallest = inputs.size();
+		for (std::size_t i = 0; i < inputs.size(); ++i)
+		{
+			if (
+				positions[i] < inputs[i].GetNumberOfIdentifiers() &&
+				(smallest == inputs.size() || identifiers[i] < identifiers[smallest])
+				)
+			{
+				smallest = i;
+			}
+		}
+		if (smallest == inputs.size())
+		{
+			break;
+		}
+
+		std::string identifier = identifiers[smallest];
+		postings.clear();
+		BinaryWriter postingsWriter(postings);
+		unsigned int numberOfReferences = 0;
+		unsigned int lastFileId = 0;
+		unsigned long long lastOffset = 0;
+		for (std::size_t i = smallest; i < inputs.size(); ++i)
+		{
+			if (positions[i] >= inputs[i].GetNumberOfIdentifiers() || identifiers[i] != identifier)
+			{
+				continue;
+			}
+			references.clear();
+			if (!inputs[i].GetReferences(positions[i], references))
+			{
+				return false;
+			}
+			for (std::vector<CrossReference>::iterator it = references.begin(); it != references.end(); ++it)
+			{
+				EncodeReference(
+					postingsWriter, it->fileId + fileIdBases[i], it->offset, numberOfReferences == 0, lastFileId, lastOffset);
+				++numberOfReferences;
+			}
+			if (++positions[i] < inputs[i].GetNumberOfIdentifiers())
+			{
+				identifiers[i] = inputs[i].GetIdentifier(positions[i]);
+			}
+		}
+		writer.AddIdentifier(identifier, numberOfReferences, postings);
+	}
+	return writer.Finish(fileNames);
+}
@@ -4,21 +4,24 @@ Creation date: 21.02.2018
 **************************************************************************/
 
 #include <cstddef>
-#include <iostream>
 
 #include "../Headers/DFA.hpp"
+#include "../Headers/Hash.hpp"
 
-DFA::DFA()
-	: m_numberOfStates(0)
+DFA::DFA(std::pmr::memory_resource* resource)
+	: m_resource(resource)
+	, m_numberOfStates(0)
 	, m_numberOfTransitionSymbols(0)
 	, m_transitionTable(NULL)
 	, m_acceptingStates(NULL)
-	, m_currentState(0)
 {
 }
 
-DFA::DFA(int numberOfStates, int alphabetLength)
-	: m_transitionTable(NULL)
+DFA::DFA(int numberOfStates, int alphabetLength, std::pmr::memory_resource* resource)
+	: m_resource(resource)
+	, m_numberOfStates(0)
+	, m_numberOfTransitionSymbols(0)
+	, m_transitionTable(NULL)
 	, m_acceptingStates(NULL)
 {
 	Initialize(numberOfStates, alphabetLength);
@@ -36,122 +39,54 @@ void DFA::Initialize(int numberOfStates, int alphabetLength)
 	m_numberOfStates = numberOfStates;
 	m_numberOfTransitionSymbols = alphabetLength;
 
-	m_transitionTable = new int*[m_numberOfStates];
+	std::size_t tableSize = static_cast<std::size_t>(m_numberOfStates) * m_numberOfTransitionSymbols;
+	m_transitionTable = static_cast<int*>(m_resource->allocate(tableSize * sizeof(int), alignof(int)));
+	for (std::size_t i = 0; i < tableSize; ++i)
+	{
+		m_transitionTable[i] = -1;
+	}
+	m_acceptingStates = static_cast<bool*>(m_resource->allocate(m_numberOfStates * sizeof(bool), alignof(bool)));
 	for (int i = 0; i < m_numberOfStates; ++i)
 	{
-		m_transitionTable[i] = new int[m_numberOfTransitionSymbols];
-		for (int j = 0; j < m_numberOfTransitionSymbols; ++j)
-		{
-			m_transitionTable[i][j] = -1;
-		}
+		m_acceptingStates[i] = false;
 	}
-	m_acceptingStates = new bool[m_numberOfStates];
 }
 
 void DFA::Reset()
 {
 	if (m_transitionTable != NULL)
 	{
-		for (int i = 0; i < m_numberOfStates; ++i)
-		{
-			delete[] m_transitionTable[i];
-		}
-		delete[] m_transitionTable;
+		std::size_t tableSize = static_cast<std::size_t>(m_numberOfStates) * m_numberOfTransitionSymbols;
+		m_resource->deallocate(m_transitionTable, tableSize * sizeof(int), alignof(int));
 		m_transitionTable = NULL;
 	}
 	if (m_acceptingStates != NULL)
 	{
-		delete[] m_acceptingStates;
+		m_resource->deallocate(m_acceptingStates, m_numberOfStates * sizeof(bool), alignof(bool));
+		m_acceptingStates = NULL;
 	}
 	m_numberOfStates = 0;
 	m_numberOfTransitionSymbols = 0;
-	m_currentState = 0;
 }
 
-bool DFA::IsValidState(int state)
+bool DFA::IsValidState(int state) const
 {
 	return state >= 0 && state < m_numberOfStates;
 }
 
-void DFA::ResetState()
-{
-	m_currentState = 0;
-}
-
 int DFA::GetNumberOfStates() const
 {
 	return m_numberOfStates;
 }
 
-void DFA::Transition(int transitionSymbol)
-{
-	m_currentState = m_transitionTable[m_currentState][transitionSymbol];
-}
-
-bool DFA::ParseLexeme(
-	std::string initialText,
-	std::string& remainingText,
-	std::string& lexeme
-	)
-{
-	for (unsigned int i = 0; i <= initialText.length(); ++i)
-	{
-		Transition(initialText[i]);
-		if (m_currentState == -1)
-		{
-			return false;
-		}
-		if (IsAccepting())
-		{
-			lexeme = initialText.substr(0, i);
-			remainingText = initialText.substr(i, initialText.length() - 1);
-			return true;
-		}
-	}
-	return true;
-}
-
-bool DFA::ParseLexeme(
-	std::ifstream& inputFile,
-	std::string& lexeme
-	)
-{
-	char currentCharacter;
-	while (inputFile >> std::noskipws >> currentCharacter)
-	{
-		Transition(currentCharacter);
-		if (m_currentState == -1)
-		{
-			//std::cout << lexeme << '\n';
-			return false;
-		}
-		if (IsAccepting())
-		{
-			inputFile.unget();
-			//std::cout << lexeme << '\n';
-			return true;
-		}
-		lexeme.push_back(currentCharacter);
-	}
-	Transition('\0');
-	if (m_currentState == -1)
-	{
-		return false;
-	}
-	if (IsAccepting())
-	{
-		return true;
-	}
-}
-
 int DFA::GetNumberOfTransitionSymbols() const
 {
 	return m_numberOfTransitionSymbols;
 }
 
-int DFA::GetTransition(int sourceState, int transitionSymbol)
+int DFA::GetTransition(int sourceState, int transitionSymbol) const
 {
-	return m_transitionTable[sourceState][transitionSymbol];
+	return m_transitionTable[sourceState * m_numberOfTransitionSymbols + transitionSymbol];
 }
 
 bool DFA::SetTransition(int sourceState, int destinationState, int transitionSymbol)
@@ -161,13 +96,13 @@ bool DFA::SetTransition(int sourceState, int destinationState, int transitionSym
 		return false;
 	}
 
-	m_transitionTable[sourceState][transitionSymbol] = destinationState;
+	m_transitionTable[sourceState * m_numberOfTransitionSymbols + transitionSymbol] = destinationState;
 	return true;
 }
 
-bool DFA::IsAccepting()
+bool DFA::IsAcceptingState(int state) const
 {
-	return m_currentState != -1 && m_acceptingStates[m_currentState];
+	return state >= 0 && state < m_numberOfStates && m_acceptingStates[state];
 }
 
 void DFA::SetAcceptingState(int state)
@@ -175,7 +110,23 @@ void DFA::SetAcceptingState(int state)
 	m_acceptingStates[state] = true;
 }
 
-int DFA::GetCurrentState() const
+const int* DFA::GetTransitionTable() const
+{
+	return m_transitionTable;
+}
+
+const bool* DFA::GetAcceptingStates() const
+{
+	return m_acceptingStates;
+}
+
+unsigned long long DFA::ComputeTableHash() const
 {
-	return m_currentState;
+	unsigned long long hash = ComputeHash64(&m_numberOfStates, sizeof(m_numberOfStates));
+	hash = ComputeHash64(
+		m_transitionTable,
+		static_cast<std::size_t>(m_numberOfStates) * m_numberOfTransitionSymbols * sizeof(int),
+		hash
+		);
+	return ComputeHash64(m_acceptingStates, m_numberOfStates * sizeof(bool), hash);
 }
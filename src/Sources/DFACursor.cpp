@@ -0,0 +1,166 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/DFACursor.hpp"
+
+DFACursor::DFACursor(const DFA& dfa)
+	: m_transitionTable(dfa.GetTransitionTable())
+	, m_acceptingStates(dfa.GetAcceptingStates())
+	, m_numberOfTransitionSymbols(dfa.GetNumberOfTransitionSymbols())
+	, m_currentState(0)
+{
+}
+
+int DFACursor::GetCurrentState() const
+{
+	return m_currentState;
+}
+
+bool DFACursor::IsAccepting() const
+{
+	return m_currentState != -1 && m_acceptingStates[m_currentState];
+}
+
+void DFACursor::ResetState()
+{
+	m_currentState = 0;
+}
+
+void DFACursor::ResetState(int initialState)
+{
+	m_currentState = initialState;
+}
+
+void DFACursor::Transition(int transitionSymbol)
+{
+	m_currentState = m_transitionTable[m_currentState * m_numberOfTransitionSymbols + transitionSymbol];
+}
+
+bool DFACursor::ParseLexeme(
+	std::string initialText,
+	std::string& remainingText,
+	std::string& lexeme
+	)
+{
+	for (unsigned int i = 0; i <= initialText.length(); ++i)
+	{
+		Transition(static_cast<unsigned char>(initialText[i]));
+		if (m_currentState == -1)
+		{
+			return false;
+		}
+		if (IsAccepting())
+		{
+			lexeme = initialText.substr(0, i);
+			remainingText = initialText.substr(i, initialText.length() - 1);
+			return true;
+		}
+	}
+	return true;
+}
+
+bool DFACursor::ParseLexeme(
+	std::ifstream& inputFile,
+	std::string& lexeme
+	)
+{
+	char currentCharacter;
+	while (inputFile >> std::noskipws >> currentCharacter)
+	{
+		Transition(static_cast<unsigned char>(currentCharacter));
+		if (m_currentState == -1)
+		{
+			return false;
+		}
+		if (IsAccepting())
+		{
+			inputFile.unget();
+			return true;
+		}
+		lexeme.push_back(currentCharacter);
+	}
+	Transition('\0');
+	if (m_currentState == -1)
+	{
+		return false;
+	}
+	return IsAccepting();
+}
+
+bool DFACursor::ParseLexeme(
+	const char* text,
+	std::size_t length,
+	std::size_t& position
+	)
+{
+	ParseStatus status = ResumeLexeme(text, length, position);
+	if (status != LEXEME_INCOMPLETE)
+	{
+		return status == LEXEME_ACCEPTED;
+	}
+	return FinishLexeme();
+}
+
+bool DFACursor::ParseLexeme(
+	const SourceView& source,
+	std::size_t& position
+	)
+{
+	if (!source.HasSplices())
+	{
+		return ParseLexeme(source.GetText(), source.GetLength(), position);
+	}
+
+	const char* text = source.GetText();
+	std::size_t length = source.GetLength();
+	std::size_t spliceIndex = source.FindSpliceIndex(position);
+	std::size_t nextSplice = source.GetNextSplice(position, spliceIndex);
+	for (std::size_t i = position; ; ++i)
+	{
+		while (i == nextSplice && i < length)
+		{
+			i = source.GetSpliceEnd(spliceIndex);
+			nextSplice = source.GetNextSplice(i, spliceIndex);
+		}
+		if (i >= length)
+		{
+			break;
+		}
+		Transition(static_cast<unsigned char>(text[i]));
+		if (m_currentState == -1 || IsAccepting())
+		{
+			position = i;
+			return m_currentState != -1;
+		}
+	}
+	position = length;
+	Transition('\0');
+	return IsAccepting();
+}
+
+DFACursor::ParseStatus DFACursor::ResumeLexeme(
+	const char* text,
+	std::size_t length,
+	std::size_t& position
+	)
+{
+	for (std::size_t i = position; i < length; ++i)
+	{
+		Transition(static_cast<unsigned char>(text[i]));
+		if (m_currentState == -1 || IsAccepting())
+		{
+			position = i;
+			return m_currentState != -1 ? LEXEME_ACCEPTED : LEXEME_REJECTED;
+		}
+	}
+	position = length;
+	return LEXEME_INCOMPLETE;
+}
+
+bool DFACursor::FinishLexeme()
+{
+	Transition('\0');
+	return IsAccepting();
+}
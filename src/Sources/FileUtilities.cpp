@@ -0,0 +1,128 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/FileUtilities.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool ReadFileContents(const std::string& fileName, std::string& text)
+{
+	std::ifstream inputFile(fileName.c_str(), std::ios::in | std::ios::binary);
+	if (!inputFile.is_open())
+	{
+		return false;
+	}
+	inputFile.seekg(0, std::ios::end);
+	std::streamoff fileLength = inputFile.tellg();
+	if (fileLength < 0)
+	{
+		return false;
+	}
+	inputFile.seekg(0, std::ios::beg);
+
+	std::string::size_type textStart = text.length();
+	text.resize(textStart + static_cast<std::string::size_type>(fileLength));
+	if (!inputFile.read(&text[textStart], fileLength))
+	{
+		text.resize(textStart);
+		return false;
+	}
+	return true;
+}
+
+void CollectSourceFiles(const std::string& path, std::vector<std::string>& fileNames)
+{
+	std::error_code error;
+	if (!std::filesystem::is_directory(path, error))
+	{
+		fileNames.push_back(path);
+		return;
+	}
+	for (
+		std::filesystem::recursive_directory_iterator it(path, error);
+		it != std::filesystem::recursive_directory_iterator();
+		it.increment(error)
+		)
+	{
+		if (error)
+		{
+			break;
+		}
+		std::string extension = it->path().extension().string();
+		if (it->is_regular_file(error) && (extension == ".c" || extension == ".h"))
+		{
+			fileNames.push_back(it->path().string());
+		}
+	}
+}
+
+MappedFile::MappedFile()
+	: m_data(NULL)
+	, m_length(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(const std::string& fileName)
+{
+	Close();
+
+	int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+	if (fileDescriptor == -1)
+	{
+		return false;
+	}
+	struct stat fileStatus;
+	if (fstat(fileDescriptor, &fileStatus) == -1)
+	{
+		close(fileDescriptor);
+		return false;
+	}
+	m_length = static_cast<std::size_t>(fileStatus.st_size);
+	if (m_length != 0)
+	{
+		void* data = mmap(NULL, m_length, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		if (data == MAP_FAILED)
+		{
+			m_length = 0;
+			close(fileDescriptor);
+			return false;
+		}
+		madvise(data, m_length, MADV_SEQUENTIAL);
+		m_data = data;
+	}
+	close(fileDescriptor);
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_data != NULL)
+	{
+		munmap(m_data, m_length);
+		m_data = NULL;
+	}
+	m_length = 0;
+}
+
+const char* MappedFile::GetData() const
+{
+	return m_data != NULL ? static_cast<const char*>(m_data) : "";
+}
+
+std::size_t MappedFile::GetLength() const
+{
+	return m_length;
+}
@@ -0,0 +1,36 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 19.10.2026
+**************************************************************************/
+
+#include "../Headers/ForwardingResource.hpp"
+
+ForwardingResource::ForwardingResource(std::pmr::memory_resource* upstream)
+	: m_upstream(upstream)
+{
+}
+
+std::pmr::memory_resource* ForwardingResource::GetUpstream() const
+{
+	return m_upstream;
+}
+
+void ForwardingResource::SetUpstream(std::pmr::memory_resource* upstream)
+{
+	m_upstream = upstream;
+}
+
+void* ForwardingResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+	return m_upstream->allocate(bytes, alignment);
+}
+
+void ForwardingResource::do_deallocate(void* data, std::size_t bytes, std::size_t alignment)
+{
+	m_upstream->deallocate(data, bytes, alignment);
+}
+
+bool ForwardingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+	return this == &other;
+}
@@ -0,0 +1,105 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/Hash.hpp"
+
+#include <cstring>
+
+static const unsigned long long PRIME1 = 11400714785074694791ULL;
+static const unsigned long long PRIME2 = 14029467366897019727ULL;
+static const unsigned long long PRIME3 = 1609587929392839161ULL;
+static const unsigned long long PRIME4 = 9650029242287828579ULL;
+static const unsigned long long PRIME5 = 2870177450012600261ULL;
+
+static inline unsigned long long RotateLeft(unsigned long long value, int bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+static inline unsigned long long Read64(const unsigned char* data)
+{
+	unsigned long long value;
+	std::memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+static inline unsigned long long Read32(const unsigned char* data)
+{
+	unsigned int value;
+	std::memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+static inline unsigned long long Round(unsigned long long accumulator, unsigned long long input)
+{
+	accumulator += input * PRIME2;
+	accumulator = RotateLeft(accumulator, 31);
+	return accumulator * PRIME1;
+}
+
+static inline unsigned long long MergeRound(unsigned long long accumulator, unsigned long long value)
+{
+	accumulator ^= Round(0, value);
+	return accumulator * PRIME1 + PRIME4;
+}
+
+unsigned long long ComputeHash64(const void* data, std::size_t length, unsigned long long seed)
+{
+	const unsigned char* current = static_cast<const unsigned char*>(data);
+	const unsigned char* end = current + length;
+	unsigned long long hash;
+
+	if (length >= 32)
+	{
+		unsigned long long v1 = seed + PRIME1 + PRIME2;
+		unsigned long long v2 = seed + PRIME2;
+		unsigned long long v3 = seed;
+		unsigned long long v4 = seed - PRIME1;
+		const unsigned char* limit = end - 32;
+		do
+		{
+			v1 = Round(v1, Read64(current));
+			v2 = Round(v2, Read64(current + 8));
+			v3 = Round(v3, Read64(current + 16));
+			v4 = Round(v4, Read64(current + 24));
+			current += 32;
+		} while (current <= limit);
+
+		hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+		hash = MergeRound(hash, v1);
+		hash = MergeRound(hash, v2);
+		hash = MergeRound(hash, v3);
+		hash = MergeRound(hash, v4);
+	}
+	else
+	{
+		hash = seed + PRIME5;
+	}
+
+	hash += length;
+	for (; current + 8 <= end; current += 8)
+	{
+		hash ^= Round(0, Read64(current));
+		hash = RotateLeft(hash, 27) * PRIME1 + PRIME4;
+	}
+	if (current + 4 <= end)
+	{
+		hash ^= Read32(current) * PRIME1;
+		hash = RotateLeft(hash, 23) * PRIME2 + PRIME3;
+		current += 4;
+	}
+	for (; current < end; ++current)
+	{
+		hash ^= *current * PRIME5;
+		hash = RotateLeft(hash, 11) * PRIME1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= PRIME2;
+	hash ^= hash >> 29;
+	hash *= PRIME3;
+	hash ^= hash >> 32;
+	return hash;
+}
@@ -0,0 +1,117 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/HeavyHitters.hpp"
+
+#include <algorithm>
+#include <functional>
+
+HeavyHitters::HeavyHitters(std::size_t capacity)
+	: m_capacity(capacity)
+{
+}
+
+void HeavyHitters::Add(const std::string& item, unsigned long long count)
+{
+	Counters::iterator it = m_counters.find(item);
+	if (it != m_counters.end())
+	{
+		SetCount(it, it->second + count);
+		return;
+	}
+	if (m_counters.size() < m_capacity)
+	{
+		Insert(item, count);
+		return;
+	}
+	if (m_capacity == 0)
+	{
+		return;
+	}
+
+	CounterOrder::iterator minimum = m_order.begin();
+	unsigned long long minimumCount = minimum->first;
+	m_counters.erase(*minimum->second);
+	m_order.erase(minimum);
+	Insert(item, minimumCount + count);
+}
+
+void HeavyHitters::Merge(const HeavyHitters& other)
+{
+	// Items monitored on one side only may have occurred up to the other
+	// side's minimum count, which is added as their error bound.
+	unsigned long long minimumCount = GetMinimumCount();
+	unsigned long long otherMinimumCount = other.GetMinimumCount();
+
+	Counters merged;
+	for (Counters::const_iterator it = m_counters.begin(); it != m_counters.end(); ++it)
+	{
+		Counters::const_iterator otherIt = other.m_counters.find(it->first);
+		merged[it->first] = it->second +
+			(otherIt != other.m_counters.end() ? otherIt->second : otherMinimumCount);
+	}
+	for (Counters::const_iterator it = other.m_counters.begin(); it != other.m_counters.end(); ++it)
+	{
+		if (m_counters.find(it->first) == m_counters.end())
+		{
+			merged[it->first] = it->second + minimumCount;
+		}
+	}
+
+	std::vector<std::pair<unsigned long long, const std::string*> > ranked;
+	ranked.reserve(merged.size());
+	for (Counters::const_iterator it = merged.begin(); it != merged.end(); ++it)
+	{
+		ranked.push_back(std::make_pair(it->second, &it->first));
+	}
+	std::size_t kept = ranked.size() < m_capacity ? ranked.size() : m_capacity;
+	std::partial_sort(ranked.begin(), ranked.begin() + kept, ranked.end(),
+		std::greater<std::pair<unsigned long long, const std::string*> >());
+
+	Counters counters;
+	CounterOrder order;
+	m_counters.swap(counters);
+	m_order.swap(order);
+	for (std::size_t i = 0; i < kept; ++i)
+	{
+		Insert(*ranked[i].second, ranked[i].first);
+	}
+}
+
+std::vector<std::pair<std::string, unsigned long long> > HeavyHitters::GetTop(std::size_t count) const
+{
+	std::vector<std::pair<std::string, unsigned long long> > top;
+	for (
+		CounterOrder::const_reverse_iterator it = m_order.rbegin();
+		it != m_order.rend() && top.size() < count;
+		++it
+		)
+	{
+		top.push_back(std::make_pair(*it->second, it->first));
+	}
+	return top;
+}
+
+unsigned long long HeavyHitters::GetMinimumCount() const
+{
+	if (m_counters.size() < m_capacity || m_order.empty())
+	{
+		return 0;
+	}
+	return m_order.begin()->first;
+}
+
+void HeavyHitters::SetCount(Counters::iterator it, unsigned long long count)
+{
+	m_order.erase(std::make_pair(it->second, &it->first));
+	it->second = count;
+	m_order.insert(std::make_pair(it->second, &it->first));
+}
+
+void HeavyHitters::Insert(const std::string& item, unsigned long long count)
+{
+	Counters::iterator it = m_counters.insert(std::make_pair(item, count)).first;
+	m_order.insert(std::make_pair(it->second, &it->first));
+}
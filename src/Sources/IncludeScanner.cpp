@@ -0,0 +1,296 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/IncludeScanner.hpp"
+#include "../Headers/FileUtilities.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iostream>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Bytes that can open a comment, a literal or a line splice.
+static bool IsSpecialCharacter(char character)
+{
+	return character == '/' || character == '"' || character == '\'' || character == '\\';
+}
+
+// Returns the first special byte in [position, lineEnd), or lineEnd. Whole
+// 16-byte chunks are tested at once as long as they stay inside the buffer.
+static std::size_t FindSpecialCharacter(const char* text, std::size_t position, std::size_t lineEnd, std::size_t length)
+{
+#if defined(__SSE2__)
+	const __m128i slash = _mm_set1_epi8('/');
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i apostrophe = _mm_set1_epi8('\'');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	while (position < lineEnd && position + 16 <= length)
+	{
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + position));
+		__m128i matches = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(chunk, slash), _mm_cmpeq_epi8(chunk, quote)),
+			_mm_or_si128(_mm_cmpeq_epi8(chunk, apostrophe), _mm_cmpeq_epi8(chunk, backslash)));
+		unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(matches));
+		if (mask != 0)
+		{
+			return std::min(position + __builtin_ctz(mask), lineEnd);
+		}
+		position += 16;
+	}
+	position = std::min(position, lineEnd);
+#endif
+	while (position < lineEnd && !IsSpecialCharacter(text[position]))
+	{
+		++position;
+	}
+	return position;
+}
+
+IncludeScanner::IncludeScanner()
+{
+}
+
+bool IncludeScanner::ScanFile(const std::string& fileName)
+{
+	m_text.clear();
+	if (!ReadFileContents(fileName, m_text))
+	{
+		return false;
+	}
+	Scan(m_text.data(), m_text.length());
+	return true;
+}
+
+// A directive starts with '#' as the first lexeme of a line; comments do
+// not end a line even when they span several. Past its first lexeme a line
+// is jumped over with memchr, and only the bytes that can open a comment, a
+// literal or a splice go through the state machine.
+void IncludeScanner::Scan(const char* text, std::size_t length)
+{
+	bool lineStart = true;
+	std::size_t position = 0;
+	while (position < length)
+	{
+		if (lineStart)
+		{
+			position = SkipBlanks(text, position, length);
+			if (position >= length)
+			{
+				break;
+			}
+			if (text[position] == '\n')
+			{
+				++position;
+				continue;
+			}
+			if (text[position] == '#')
+			{
+				position = ScanDirective(text, position, length);
+				lineStart = false;
+				continue;
+			}
+			lineStart = false;
+		}
+
+		const char* newline = static_cast<const char*>(std::memchr(text + position, '\n', length - position));
+		std::size_t lineEnd = newline == NULL ? length : newline - text;
+		position = FindSpecialCharacter(text, position, lineEnd, length);
+		if (position == lineEnd)
+		{
+			position = lineEnd + 1;
+			lineStart = true;
+			continue;
+		}
+
+		std::size_t next = text[position] == '/' ? SkipComment(text, position, length) :
+			text[position] == '\\' ? SkipSplices(text, position, length) :
+			SkipLiteral(text, position, length);
+		position = next != position ? next : position + 1;
+	}
+}
+
+void IncludeScanner::Clear()
+{
+	m_includes.clear();
+}
+
+const std::vector<IncludeScanner::Include>& IncludeScanner::GetIncludes() const
+{
+	return m_includes;
+}
+
+void IncludeScanner::DisplayIncludes(const std::string& fileName)
+{
+	for (
+		std::vector<Include>::iterator it = m_includes.begin();
+		it != m_includes.end();
+		++it
+		)
+	{
+		std::cout << fileName << ": " << (it->isSystemHeader ? '<' : '"') << it->headerName <<
+				(it->isSystemHeader ? '>' : '"') << '\n';
+	}
+}
+
+std::size_t IncludeScanner::ScanDirective(const char* text, std::size_t directiveStart, std::size_t length)
+{
+	std::size_t position = SkipBlanks(text, GetNextCharacter(text, directiveStart, length), length);
+	std::string name;
+	while (position < length && (std::isalnum(static_cast<unsigned char>(text[position])) || text[position] == '_'))
+	{
+		name.push_back(text[position]);
+		position = GetNextCharacter(text, position, length);
+	}
+	if (name != "include" && name != "include_next" && name != "import")
+	{
+		return position;
+	}
+
+	position = SkipBlanks(text, position, length);
+	if (position >= length || (text[position] != '<' && text[position] != '"'))
+	{
+		return position;
+	}
+	char closing = text[position] == '<' ? '>' : '"';
+	std::string headerName;
+	for (position = GetNextCharacter(text, position, length); position < length; )
+	{
+		if (text[position] == '\n' || text[position] == '\0')
+		{
+			return position;
+		}
+		if (text[position] == closing)
+		{
+			break;
+		}
+		headerName.push_back(text[position]);
+		position = GetNextCharacter(text, position, length);
+	}
+	if (position >= length)
+	{
+		return position;
+	}
+
+	Include include;
+	include.headerName = headerName;
+	include.isSystemHeader = closing == '>';
+	include.offset = directiveStart;
+	m_includes.push_back(include);
+	return GetNextCharacter(text, position, length);
+}
+
+// Skips whitespace other than newlines, line splices and block comments.
+std::size_t IncludeScanner::SkipBlanks(const char* text, std::size_t position, std::size_t length)
+{
+	position = SkipSplices(text, position, length);
+	while (position < length)
+	{
+		char current = text[position];
+		if (current == ' ' || current == '\t' || current == '\r' || current == '\f' || current == '\v')
+		{
+			position = GetNextCharacter(text, position, length);
+		}
+		else
+		{
+			std::size_t next = GetNextCharacter(text, position, length);
+			if (current != '/' || next >= length || text[next] != '*')
+			{
+				break;
+			}
+			position = SkipComment(text, position, length);
+		}
+	}
+	return position;
+}
+
+// Returns position itself when no comment starts there. A line comment ends
+// before the newline that terminates it.
+std::size_t IncludeScanner::SkipComment(const char* text, std::size_t position, std::size_t length)
+{
+	std::size_t next = GetNextCharacter(text, position, length);
+	if (next >= length || (text[next] != '/' && text[next] != '*'))
+	{
+		return position;
+	}
+	char terminator = text[next] == '/' ? '\n' : '*';
+	position = GetNextCharacter(text, next, length);
+	while (position < length)
+	{
+		const char* found = static_cast<const char*>(std::memchr(text + position, terminator, length - position));
+		if (found == NULL)
+		{
+			return length;
+		}
+		position = found - text;
+		if (terminator == '\n')
+		{
+			std::size_t spliceStart = position > 0 && text[position - 1] == '\r' ? position - 1 : position;
+			if (spliceStart == 0 || text[spliceStart - 1] != '\\')
+			{
+				return position;
+			}
+			++position;
+			continue;
+		}
+		position = GetNextCharacter(text, position, length);
+		if (position < length && text[position] == '/')
+		{
+			return GetNextCharacter(text, position, length);
+		}
+	}
+	return length;
+}
+
+// An unterminated literal ends before the newline, as in the lexical
+// analyzer's error recovery.
+std::size_t IncludeScanner::SkipLiteral(const char* text, std::size_t position, std::size_t length)
+{
+	char quote = text[position];
+	for (position = GetNextCharacter(text, position, length); position < length; )
+	{
+		char current = text[position];
+		if (current == '\n')
+		{
+			return position;
+		}
+		position = GetNextCharacter(text, position, length);
+		if (current == quote)
+		{
+			return position;
+		}
+		if (current == '\\' && position < length && text[position] != '\n')
+		{
+			position = GetNextCharacter(text, position, length);
+		}
+	}
+	return length;
+}
+
+std::size_t IncludeScanner::SkipSplices(const char* text, std::size_t position, std::size_t length)
+{
+	while (position + 1 < length && text[position] == '\\')
+	{
+		std::size_t next = position + 1;
+		if (text[next] == '\r' && next + 1 < length && text[next + 1] == '\n')
+		{
+			++next;
+		}
+		if (text[next] != '\n')
+		{
+			break;
+		}
+		position = next + 1;
+	}
+	return position;
+}
+
+std::size_t IncludeScanner::GetNextCharacter(const char* text, std::size_t position, std::size_t length)
+{
+	return SkipSplices(text, position + 1, length);
+}
@@ -0,0 +1,221 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/IoUring.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define IOURING_AVAILABLE
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+IoUring::IoUring()
+	: m_ringDescriptor(-1)
+	, m_numberOfEntries(0)
+	, m_pendingSubmissions(0)
+	, m_submissionRing(NULL)
+	, m_submissionRingSize(0)
+	, m_completionRing(NULL)
+	, m_completionRingSize(0)
+	, m_submissionEntries(NULL)
+	, m_submissionEntriesSize(0)
+	, m_submissionHead(NULL)
+	, m_submissionTail(NULL)
+	, m_submissionMask(NULL)
+	, m_submissionArray(NULL)
+	, m_completionHead(NULL)
+	, m_completionTail(NULL)
+	, m_completionMask(NULL)
+	, m_completionEntries(NULL)
+{
+}
+
+IoUring::~IoUring()
+{
+	Close();
+}
+
+#ifdef IOURING_AVAILABLE
+
+bool IoUring::Initialize(unsigned int entries)
+{
+	Close();
+
+	io_uring_params parameters;
+	std::memset(&parameters, 0, sizeof(parameters));
+	m_ringDescriptor = static_cast<int>(syscall(__NR_io_uring_setup, entries, &parameters));
+	if (m_ringDescriptor < 0)
+	{
+		m_ringDescriptor = -1;
+		return false;
+	}
+
+	m_submissionRingSize = parameters.sq_off.array + parameters.sq_entries * sizeof(unsigned int);
+	m_completionRingSize = parameters.cq_off.cqes + parameters.cq_entries * sizeof(io_uring_cqe);
+	bool singleMapping = (parameters.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	if (singleMapping && m_completionRingSize > m_submissionRingSize)
+	{
+		m_submissionRingSize = m_completionRingSize;
+	}
+	m_submissionRing = mmap(NULL, m_submissionRingSize, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_POPULATE, m_ringDescriptor, IORING_OFF_SQ_RING);
+	if (m_submissionRing == MAP_FAILED)
+	{
+		m_submissionRing = NULL;
+		Close();
+		return false;
+	}
+	if (singleMapping)
+	{
+		m_completionRing = m_submissionRing;
+	}
+	else
+	{
+		m_completionRing = mmap(NULL, m_completionRingSize, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, m_ringDescriptor, IORING_OFF_CQ_RING);
+		if (m_completionRing == MAP_FAILED)
+		{
+			m_completionRing = NULL;
+			Close();
+			return false;
+		}
+	}
+	m_submissionEntriesSize = parameters.sq_entries * sizeof(io_uring_sqe);
+	m_submissionEntries = mmap(NULL, m_submissionEntriesSize, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_POPULATE, m_ringDescriptor, IORING_OFF_SQES);
+	if (m_submissionEntries == MAP_FAILED)
+	{
+		m_submissionEntries = NULL;
+		Close();
+		return false;
+	}
+
+	char* submissionRing = static_cast<char*>(m_submissionRing);
+	char* completionRing = static_cast<char*>(m_completionRing);
+	m_submissionHead = reinterpret_cast<unsigned int*>(submissionRing + parameters.sq_off.head);
+	m_submissionTail = reinterpret_cast<unsigned int*>(submissionRing + parameters.sq_off.tail);
+	m_submissionMask = reinterpret_cast<unsigned int*>(submissionRing + parameters.sq_off.ring_mask);
+	m_submissionArray = reinterpret_cast<unsigned int*>(submissionRing + parameters.sq_off.array);
+	m_completionHead = reinterpret_cast<unsigned int*>(completionRing + parameters.cq_off.head);
+	m_completionTail = reinterpret_cast<unsigned int*>(completionRing + parameters.cq_off.tail);
+	m_completionMask = reinterpret_cast<unsigned int*>(completionRing + parameters.cq_off.ring_mask);
+	m_completionEntries = completionRing + parameters.cq_off.cqes;
+	m_numberOfEntries = parameters.sq_entries;
+	return true;
+}
+
+bool IoUring::PrepareRead(int fileDescriptor, void* buffer, unsigned int length,
+	unsigned long long offset, unsigned long long userData)
+{
+	unsigned int tail = *m_submissionTail;
+	if (tail - __atomic_load_n(m_submissionHead, __ATOMIC_ACQUIRE) >= m_numberOfEntries)
+	{
+		return false;
+	}
+	unsigned int index = tail & *m_submissionMask;
+	io_uring_sqe* entry = static_cast<io_uring_sqe*>(m_submissionEntries) + index;
+	std::memset(entry, 0, sizeof(*entry));
+	entry->opcode = IORING_OP_READ;
+	entry->fd = fileDescriptor;
+	entry->addr = reinterpret_cast<unsigned long long>(buffer);
+	entry->len = length;
+	entry->off = offset;
+	entry->user_data = userData;
+	m_submissionArray[index] = index;
+	__atomic_store_n(m_submissionTail, tail + 1, __ATOMIC_RELEASE);
+	++m_pendingSubmissions;
+	return true;
+}
+
+bool IoUring::SubmitAndWait(unsigned long long& userData, int& result)
+{
+	while (true)
+	{
+		unsigned int head = *m_completionHead;
+		if (head != __atomic_load_n(m_completionTail, __ATOMIC_ACQUIRE) && m_pendingSubmissions == 0)
+		{
+			io_uring_cqe* entry = static_cast<io_uring_cqe*>(m_completionEntries) + (head & *m_completionMask);
+			userData = entry->user_data;
+			result = entry->res;
+			__atomic_store_n(m_completionHead, head + 1, __ATOMIC_RELEASE);
+			return true;
+		}
+		long submitted = syscall(__NR_io_uring_enter, m_ringDescriptor, m_pendingSubmissions, 1,
+			IORING_ENTER_GETEVENTS, NULL, 0);
+		if (submitted < 0)
+		{
+			if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+			{
+				continue;
+			}
+			return false;
+		}
+		m_pendingSubmissions -= static_cast<unsigned int>(submitted);
+	}
+}
+
+void IoUring::Close()
+{
+	if (m_submissionEntries != NULL)
+	{
+		munmap(m_submissionEntries, m_submissionEntriesSize);
+	}
+	if (m_completionRing != NULL && m_completionRing != m_submissionRing)
+	{
+		munmap(m_completionRing, m_completionRingSize);
+	}
+	if (m_submissionRing != NULL)
+	{
+		munmap(m_submissionRing, m_submissionRingSize);
+	}
+	if (m_ringDescriptor != -1)
+	{
+		close(m_ringDescriptor);
+	}
+	m_submissionEntries = NULL;
+	m_completionRing = NULL;
+	m_submissionRing = NULL;
+	m_ringDescriptor = -1;
+	m_numberOfEntries = 0;
+	m_pendingSubmissions = 0;
+}
+
+#else
+
+bool IoUring::Initialize(unsigned int)
+{
+	return false;
+}
+
+bool IoUring::PrepareRead(int, void*, unsigned int, unsigned long long, unsigned long long)
+{
+	return false;
+}
+
+bool IoUring::SubmitAndWait(unsigned long long&, int&)
+{
+	return false;
+}
+
+void IoUring::Close()
+{
+}
+
+#endif
+
+bool IoUring::IsInitialized() const
+{
+	return m_ringDescriptor != -1;
+}
+
+unsigned int IoUring::GetNumberOfEntries() const
+{
+	return m_numberOfEntries;
+}
@@ -0,0 +1,128 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 19.10.2026
+**************************************************************************/
+
+#include "../Headers/LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+static const unsigned long long HALF_SUB_BUCKET_COUNT = LatencyHistogram::SUB_BUCKET_COUNT / 2;
+static const std::size_t NUMBER_OF_BUCKETS = static_cast<std::size_t>(
+	LatencyHistogram::SUB_BUCKET_COUNT + (64 - LatencyHistogram::SUB_BUCKET_BITS) * HALF_SUB_BUCKET_COUNT);
+
+LatencyHistogram::LatencyHistogram()
+	: m_counts(NUMBER_OF_BUCKETS, 0)
+	, m_count(0)
+	, m_minimum(0)
+	, m_maximum(0)
+	, m_total(0)
+{
+}
+
+std::size_t LatencyHistogram::GetBucketIndex(unsigned long long value)
+{
+	if (value < SUB_BUCKET_COUNT)
+	{
+		return static_cast<std::size_t>(value);
+	}
+	unsigned int exponent = 63 - __builtin_clzll(value);
+	unsigned long long subBucket = value >> (exponent - (SUB_BUCKET_BITS - 1));
+	return static_cast<std::size_t>(SUB_BUCKET_COUNT + (exponent - SUB_BUCKET_BITS) * HALF_SUB_BUCKET_COUNT +
+		subBucket - HALF_SUB_BUCKET_COUNT);
+}
+
+unsigned long long LatencyHistogram::GetBucketUpperBound(std::size_t bucketIndex)
+{
+	if (bucketIndex < SUB_BUCKET_COUNT)
+	{
+		return bucketIndex;
+	}
+	unsigned long long offset = bucketIndex - SUB_BUCKET_COUNT;
+	unsigned int exponent = static_cast<unsigned int>(SUB_BUCKET_BITS + offset / HALF_SUB_BUCKET_COUNT);
+	unsigned long long subBucket = HALF_SUB_BUCKET_COUNT + offset % HALF_SUB_BUCKET_COUNT;
+	return ((subBucket + 1) << (exponent - (SUB_BUCKET_BITS - 1))) - 1;
+}
+
+void LatencyHistogram::Record(long long value)
+{
+	if (value < 0)
+	{
+		value = 0;
+	}
+	++m_counts[GetBucketIndex(static_cast<unsigned long long>(value))];
+	m_minimum = m_count == 0 ? value : std::min(m_minimum, value);
+	m_maximum = std::max(m_maximum, value);
+	m_total += value;
+	++m_count;
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other)
+{
+	if (other.m_count == 0)
+	{
+		return;
+	}
+	for (std::size_t i = 0; i < m_counts.size(); ++i)
+	{
+		m_counts[i] += other.m_counts[i];
+	}
+	m_minimum = m_count == 0 ? other.m_minimum : std::min(m_minimum, other.m_minimum);
+	m_maximum = std::max(m_maximum, other.m_maximum);
+	m_total += other.m_total;
+	m_count += other.m_count;
+}
+
+void LatencyHistogram::Clear()
+{
+	std::fill(m_counts.begin(), m_counts.end(), 0);
+	m_count = 0;
+	m_minimum = 0;
+	m_maximum = 0;
+	m_total = 0;
+}
+
+unsigned long long LatencyHistogram::GetCount() const
+{
+	return m_count;
+}
+
+long long LatencyHistogram::GetMinimum() const
+{
+	return m_minimum;
+}
+
+long long LatencyHistogram::GetMaximum() const
+{
+	return m_maximum;
+}
+
+long long LatencyHistogram::GetTotal() const
+{
+	return m_total;
+}
+
+long long LatencyHistogram::GetPercentile(double percentile) const
+{
+	if (m_count == 0)
+	{
+		return 0;
+	}
+	// Reports the highest value equivalent to the bucket holding the rank,
+	// clamped to the exact extremes.
+	unsigned long long rank = static_cast<unsigned long long>(std::ceil(percentile / 100.0 * m_count));
+	rank = std::max(1ULL, std::min(rank, m_count));
+	unsigned long long cumulative = 0;
+	for (std::size_t i = 0; i < m_counts.size(); ++i)
+	{
+		cumulative += m_counts[i];
+		if (cumulative >= rank)
+		{
+			long long value = static_cast<long long>(std::min(GetBucketUpperBound(i),
+				static_cast<unsigned long long>(m_maximum)));
+			return std::max(value, m_minimum);
+		}
+	}
+	return m_maximum;
+}
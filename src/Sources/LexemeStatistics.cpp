@@ -0,0 +1,195 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/LexemeStatistics.hpp"
+
+#include <algorithm>
+#include <functional>
+
+static const std::size_t MAXIMUM_SKETCH_WIDTH = 1 << 16;
+static const std::size_t MINIMUM_SKETCH_WIDTH = 1 << 10;
+static const std::size_t SKETCH_DEPTH = 4;
+static const std::size_t SKETCH_COUNTER_SIZE = sizeof(unsigned long long);
+static const std::size_t EXACT_ENTRY_OVERHEAD = 64;
+// A monitored lexeme costs a hash map node and an ordered set node.
+static const std::size_t HEAVY_HITTER_ENTRY_SIZE = 160;
+
+// The summaries take at most half of the budget, the sketch what is left.
+LexemeStatistics::LexemeStatistics(int numberOfLexemeTypes, std::size_t memoryBudget, std::size_t heavyHitterCapacity)
+	: m_memoryBudget(memoryBudget)
+	, m_heavyHitterCapacity(std::min(heavyHitterCapacity,
+		memoryBudget / 2 / (numberOfLexemeTypes * HEAVY_HITTER_ENTRY_SIZE)))
+	, m_sketchWidth(0)
+	, m_exactMemoryUsage(0)
+	, m_exact(true)
+	, m_exactCounts(numberOfLexemeTypes)
+	, m_totalCounts(numberOfLexemeTypes, 0)
+	, m_sketch(0, 0)
+{
+	m_heavyHitterCapacity = std::max<std::size_t>(m_heavyHitterCapacity, 1);
+	std::size_t heavyHitterMemory = numberOfLexemeTypes * m_heavyHitterCapacity * HEAVY_HITTER_ENTRY_SIZE;
+	std::size_t sketchMemory = memoryBudget > heavyHitterMemory ? memoryBudget - heavyHitterMemory : 0;
+	m_sketchWidth = std::min(MAXIMUM_SKETCH_WIDTH, sketchMemory / (SKETCH_DEPTH * SKETCH_COUNTER_SIZE));
+	m_sketchWidth = std::max(m_sketchWidth, MINIMUM_SKETCH_WIDTH);
+}
+
+// The smallest budget that keeps `heavyHitterCapacity` lexemes per type once
+// the counts turn approximate.
+std::size_t LexemeStatistics::GetMinimumMemoryBudget(int numberOfLexemeTypes, std::size_t heavyHitterCapacity)
+{
+	std::size_t heavyHitterMemory = numberOfLexemeTypes * heavyHitterCapacity * HEAVY_HITTER_ENTRY_SIZE;
+	return std::max(2 * heavyHitterMemory,
+		heavyHitterMemory + MINIMUM_SKETCH_WIDTH * SKETCH_DEPTH * SKETCH_COUNTER_SIZE);
+}
+
+void LexemeStatistics::Add(int lexemeType, const char* text, std::size_t length)
+{
+	m_lexeme.assign(text, length);
+	++m_totalCounts[lexemeType];
+	if (!m_exact)
+	{
+		AddApproximate(lexemeType, m_lexeme, 1);
+		return;
+	}
+
+	ExactCounts::iterator it = m_exactCounts[lexemeType].find(m_lexeme);
+	if (it != m_exactCounts[lexemeType].end())
+	{
+		++it->second;
+		return;
+	}
+	m_exactCounts[lexemeType].insert(std::make_pair(m_lexeme, 1ULL));
+	m_exactMemoryUsage += length + EXACT_ENTRY_OVERHEAD;
+	if (m_exactMemoryUsage > m_memoryBudget)
+	{
+		SwitchToApproximate();
+	}
+}
+
+void LexemeStatistics::Merge(const LexemeStatistics& other)
+{
+	for (std::size_t type = 0; type < m_totalCounts.size(); ++type)
+	{
+		m_totalCounts[type] += other.m_totalCounts[type];
+	}
+
+	if (other.m_exact)
+	{
+		for (std::size_t type = 0; type < other.m_exactCounts.size(); ++type)
+		{
+			const ExactCounts& counts = other.m_exactCounts[type];
+			for (ExactCounts::const_iterator it = counts.begin(); it != counts.end(); ++it)
+			{
+				if (!m_exact)
+				{
+					AddApproximate(type, it->first, it->second);
+					continue;
+				}
+				std::pair<ExactCounts::iterator, bool> inserted =
+					m_exactCounts[type].insert(std::make_pair(it->first, 0ULL));
+				inserted.first->second += it->second;
+				if (inserted.second)
+				{
+					m_exactMemoryUsage += it->first.length() + EXACT_ENTRY_OVERHEAD;
+					if (m_exactMemoryUsage > m_memoryBudget)
+					{
+						SwitchToApproximate();
+					}
+				}
+			}
+		}
+		return;
+	}
+
+	if (m_exact)
+	{
+		SwitchToApproximate();
+	}
+	m_sketch.Merge(other.m_sketch);
+	for (std::size_t type = 0; type < m_heavyHitters.size(); ++type)
+	{
+		m_heavyHitters[type].Merge(other.m_heavyHitters[type]);
+	}
+}
+
+bool LexemeStatistics::IsExact() const
+{
+	return m_exact;
+}
+
+unsigned long long LexemeStatistics::GetCount(int lexemeType, const std::string& lexeme) const
+{
+	if (!m_exact)
+	{
+		return m_sketch.Estimate(Hash(lexemeType, lexeme));
+	}
+	ExactCounts::const_iterator it = m_exactCounts[lexemeType].find(lexeme);
+	return it != m_exactCounts[lexemeType].end() ? it->second : 0;
+}
+
+unsigned long long LexemeStatistics::GetTotalCount(int lexemeType) const
+{
+	return m_totalCounts[lexemeType];
+}
+
+std::vector<std::pair<std::string, unsigned long long> > LexemeStatistics::GetTop(int lexemeType, std::size_t count) const
+{
+	if (!m_exact)
+	{
+		return m_heavyHitters[lexemeType].GetTop(count);
+	}
+
+	std::vector<std::pair<unsigned long long, std::string> > ranked;
+	const ExactCounts& counts = m_exactCounts[lexemeType];
+	ranked.reserve(counts.size());
+	for (ExactCounts::const_iterator it = counts.begin(); it != counts.end(); ++it)
+	{
+		ranked.push_back(std::make_pair(it->second, it->first));
+	}
+	std::size_t kept = std::min(count, ranked.size());
+	std::partial_sort(ranked.begin(), ranked.begin() + kept, ranked.end(),
+		std::greater<std::pair<unsigned long long, std::string> >());
+
+	std::vector<std::pair<std::string, unsigned long long> > top;
+	for (std::size_t i = 0; i < kept; ++i)
+	{
+		top.push_back(std::make_pair(ranked[i].second, ranked[i].first));
+	}
+	return top;
+}
+
+void LexemeStatistics::AddApproximate(int lexemeType, const std::string& lexeme, unsigned long long count)
+{
+	m_sketch.Add(Hash(lexemeType, lexeme), count);
+	m_heavyHitters[lexemeType].Add(lexeme, count);
+}
+
+void LexemeStatistics::SwitchToApproximate()
+{
+	m_exact = false;
+	m_sketch = CountMinSketch(m_sketchWidth, SKETCH_DEPTH);
+	m_heavyHitters.assign(m_exactCounts.size(), HeavyHitters(m_heavyHitterCapacity));
+
+	std::vector<ExactCounts> exactCounts(m_exactCounts.size());
+	m_exactCounts.swap(exactCounts);
+	for (std::size_t type = 0; type < exactCounts.size(); ++type)
+	{
+		for (ExactCounts::iterator it = exactCounts[type].begin(); it != exactCounts[type].end(); ++it)
+		{
+			AddApproximate(type, it->first, it->second);
+		}
+	}
+	m_exactMemoryUsage = 0;
+}
+
+unsigned long long LexemeStatistics::Hash(int lexemeType, const std::string& lexeme)
+{
+	unsigned long long hash = std::hash<std::string>()(lexeme);
+	hash ^= (static_cast<unsigned long long>(lexemeType) + 1) * 0x9E3779B97F4A7C15ULL;
+	hash ^= hash >> 33;
+	hash *= 0xFF51AFD7ED558CCDULL;
+	hash ^= hash >> 33;
+	return hash;
+}
@@ -0,0 +1,74 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/LexerClient.hpp"
+
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+LexerClient::LexerClient()
+	: m_socket(-1)
+{
+}
+
+LexerClient::~LexerClient()
+{
+	Close();
+}
+
+bool LexerClient::Connect(const std::string& socketPath)
+{
+	Close();
+
+	sockaddr_un address;
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (socketPath.length() >= sizeof(address.sun_path))
+	{
+		return false;
+	}
+	std::strcpy(address.sun_path, socketPath.c_str());
+
+	m_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (m_socket == -1)
+	{
+		return false;
+	}
+	if (connect(m_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+	{
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void LexerClient::Close()
+{
+	if (m_socket != -1)
+	{
+		close(m_socket);
+		m_socket = -1;
+	}
+}
+
+bool LexerClient::Lex(const std::vector<LexerRequest>& requests, std::vector<LexerResponse>& responses)
+{
+	if (m_socket == -1)
+	{
+		return false;
+	}
+	m_buffer.clear();
+	EncodeRequests(requests, m_buffer);
+	if (!WriteFrame(m_socket, m_buffer) || !ReadFrame(m_socket, m_buffer))
+	{
+		Close();
+		return false;
+	}
+	return DecodeResponses(m_buffer.data(), m_buffer.length(), responses) &&
+		responses.size() == requests.size();
+}
@@ -0,0 +1,177 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/LexerProtocol.hpp"
+
+#include <cerrno>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+static const unsigned int FRAME_MAGIC = 0x4C584652;
+static const unsigned int MAXIMUM_FRAME_LENGTH = 1U << 30;
+
+static bool ReadFully(int socket, char* data, std::size_t length)
+{
+	while (length != 0)
+	{
+		ssize_t count = recv(socket, data, length, 0);
+		if (count < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (count <= 0)
+		{
+			return false;
+		}
+		data += count;
+		length -= count;
+	}
+	return true;
+}
+
+static bool WriteFully(int socket, const char* data, std::size_t length)
+{
+	while (length != 0)
+	{
+		ssize_t count = send(socket, data, length, MSG_NOSIGNAL);
+		if (count < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (count <= 0)
+		{
+			return false;
+		}
+		data += count;
+		length -= count;
+	}
+	return true;
+}
+
+bool ReadFrame(int socket, std::string& payload)
+{
+	unsigned int header[2];
+	if (!ReadFully(socket, reinterpret_cast<char*>(header), sizeof(header)))
+	{
+		return false;
+	}
+	if (header[0] != FRAME_MAGIC || header[1] > MAXIMUM_FRAME_LENGTH)
+	{
+		return false;
+	}
+	payload.resize(header[1]);
+	return ReadFully(socket, &payload[0], payload.length());
+}
+
+bool WriteFrame(int socket, const std::string& payload)
+{
+	if (payload.length() > MAXIMUM_FRAME_LENGTH)
+	{
+		return false;
+	}
+	unsigned int header[2] = { FRAME_MAGIC, static_cast<unsigned int>(payload.length()) };
+	return WriteFully(socket, reinterpret_cast<const char*>(header), sizeof(header)) &&
+		WriteFully(socket, payload.data(), payload.length());
+}
+
+void EncodeRequests(const std::vector<LexerRequest>& requests, std::string& payload)
+{
+	BinaryWriter writer(payload);
+	writer.WriteVarint(requests.size());
+	for (std::vector<LexerRequest>::const_iterator it = requests.begin(); it != requests.end(); ++it)
+	{
+		writer.Write<unsigned char>(static_cast<unsigned char>(it->kind));
+		writer.WriteVarint(it->data.length());
+		writer.WriteBytes(it->data.data(), it->data.length());
+	}
+}
+
+bool DecodeRequests(const char* payload, std::size_t length, std::vector<LexerRequest>& requests)
+{
+	BinaryReader reader(payload, length);
+	unsigned long long numberOfRequests = 0;
+	if (!reader.ReadVarint(numberOfRequests) || numberOfRequests > reader.GetRemaining())
+	{
+		return false;
+	}
+	requests.resize(numberOfRequests);
+	for (std::size_t i = 0; i < requests.size(); ++i)
+	{
+		unsigned char kind = 0;
+		unsigned long long dataLength = 0;
+		const char* data = NULL;
+		if (!reader.Read(kind) || kind > LEXER_REQUEST_BUFFER ||
+			!reader.ReadVarint(dataLength) || dataLength > reader.GetRemaining() ||
+			!reader.ReadBytes(data, dataLength))
+		{
+			return false;
+		}
+		requests[i].kind = static_cast<LexerRequestKind>(kind);
+		requests[i].data.assign(data, dataLength);
+	}
+	return reader.GetRemaining() == 0;
+}
+
+void EncodeToken(BinaryWriter& writer, int type, const char* text, std::size_t length, std::size_t offset)
+{
+	writer.WriteVarint(type + 1);
+	writer.WriteVarint(offset);
+	writer.WriteVarint(length);
+	writer.WriteBytes(text, length);
+}
+
+void EncodeEndOfTokens(BinaryWriter& writer)
+{
+	writer.WriteVarint(0);
+}
+
+bool DecodeResponses(const char* payload, std::size_t length, std::vector<LexerResponse>& responses)
+{
+	BinaryReader reader(payload, length);
+	unsigned long long numberOfResponses = 0;
+	if (!reader.ReadVarint(numberOfResponses) || numberOfResponses > reader.GetRemaining())
+	{
+		return false;
+	}
+	responses.resize(numberOfResponses);
+	for (std::size_t i = 0; i < responses.size(); ++i)
+	{
+		unsigned char success = 0;
+		if (!reader.Read(success))
+		{
+			return false;
+		}
+		responses[i].success = success != 0;
+		responses[i].tokens.clear();
+		while (true)
+		{
+			unsigned long long type = 0;
+			if (!reader.ReadVarint(type))
+			{
+				return false;
+			}
+			if (type == 0)
+			{
+				break;
+			}
+			unsigned long long offset = 0;
+			unsigned long long textLength = 0;
+			const char* text = NULL;
+			if (!reader.ReadVarint(offset) || !reader.ReadVarint(textLength) ||
+				textLength > reader.GetRemaining() || !reader.ReadBytes(text, textLength))
+			{
+				return false;
+			}
+			LexerToken token;
+			token.type = static_cast<int>(type - 1);
+			token.offset = offset;
+			token.text.assign(text, textLength);
+			responses[i].tokens.push_back(token);
+		}
+	}
+	return reader.GetRemaining() == 0;
+}
@@ -0,0 +1,230 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/LexerServer.hpp"
+#include "../Headers/FileUtilities.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+LexerServer::LexerServer(const std::string& socketPath, std::size_t numberOfWorkers)
+	: m_socketPath(socketPath)
+	, m_numberOfWorkers(numberOfWorkers == 0 ? 1 : numberOfWorkers)
+	, m_listener(-1)
+{
+	if (pipe(m_stopPipe) != 0)
+	{
+		m_stopPipe[0] = -1;
+		m_stopPipe[1] = -1;
+		return;
+	}
+	fcntl(m_stopPipe[1], F_SETFL, O_NONBLOCK);
+}
+
+LexerServer::~LexerServer()
+{
+	if (m_listener != -1)
+	{
+		close(m_listener);
+		unlink(m_socketPath.c_str());
+	}
+	if (m_stopPipe[0] != -1)
+	{
+		close(m_stopPipe[0]);
+		close(m_stopPipe[1]);
+	}
+}
+
+void LexerServer::Stop()
+{
+	int savedErrno = errno;
+	char byte = 0;
+	ssize_t written = write(m_stopPipe[1], &byte, 1);
+	(void)written;
+	errno = savedErrno;
+}
+
+bool LexerServer::Run()
+{
+	sockaddr_un address;
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (m_socketPath.length() >= sizeof(address.sun_path))
+	{
+		return false;
+	}
+	std::strcpy(address.sun_path, m_socketPath.c_str());
+
+	if (m_stopPipe[0] == -1)
+	{
+		return false;
+	}
+	m_listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (m_listener == -1)
+	{
+		return false;
+	}
+	unlink(m_socketPath.c_str());
+	if (bind(m_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+		listen(m_listener, SOMAXCONN) != 0 ||
+		fcntl(m_listener, F_SETFL, O_NONBLOCK) != 0)
+	{
+		close(m_listener);
+		m_listener = -1;
+		unlink(m_socketPath.c_str());
+		return false;
+	}
+
+	std::vector<std::thread> workers;
+	for (std::size_t i = 0; i < m_numberOfWorkers; ++i)
+	{
+		workers.push_back(std::thread(&LexerServer::ServeConnections, this));
+	}
+
+	// The listener is non-blocking so that a connection reset between poll
+	// and accept cannot block the loop past a stop request.
+	pollfd descriptors[2];
+	descriptors[0].fd = m_listener;
+	descriptors[0].events = POLLIN;
+	descriptors[1].fd = m_stopPipe[0];
+	descriptors[1].events = POLLIN;
+	bool status = true;
+	while (true)
+	{
+		if (poll(descriptors, 2, -1) == -1)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			status = false;
+			break;
+		}
+		if (descriptors[1].revents != 0)
+		{
+			break;
+		}
+		int connection = accept(m_listener, NULL, NULL);
+		if (connection == -1)
+		{
+			if (errno == EINTR || errno == ECONNABORTED || errno == EAGAIN || errno == EWOULDBLOCK)
+			{
+				continue;
+			}
+			status = false;
+			break;
+		}
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_connections.push_back(connection);
+		m_condition.notify_one();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_connections.push_back(-1);
+		m_condition.notify_all();
+	}
+	for (std::size_t i = 0; i < workers.size(); ++i)
+	{
+		workers[i].join();
+	}
+	close(m_listener);
+	m_listener = -1;
+	unlink(m_socketPath.c_str());
+	return status;
+}
+
+void LexerServer::ServeConnections()
+{
+	LexicalAnalyzer lex;
+	lex.SetErrorRecovery(true);
+
+	while (true)
+	{
+		int connection = -1;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			while (m_connections.empty())
+			{
+				m_condition.wait(lock);
+			}
+			connection = m_connections.front();
+			if (connection == -1)
+			{
+				return;
+			}
+			m_connections.pop_front();
+		}
+		ServeConnection(connection, lex);
+		close(connection);
+	}
+}
+
+void LexerServer::ServeConnection(int connection, LexicalAnalyzer& lex)
+{
+	std::string request;
+	std::string response;
+	std::vector<LexerRequest> requests;
+	while (ReadFrame(connection, request))
+	{
+		if (!DecodeRequests(request.data(), request.length(), requests))
+		{
+			return;
+		}
+		response.clear();
+		HandleRequests(lex, requests, response);
+		if (!WriteFrame(connection, response))
+		{
+			return;
+		}
+	}
+}
+
+void LexerServer::HandleRequests(
+	LexicalAnalyzer& lex,
+	const std::vector<LexerRequest>& requests,
+	std::string& response
+	)
+{
+	BinaryWriter writer(response);
+	writer.WriteVarint(requests.size());
+	for (std::vector<LexerRequest>::const_iterator it = requests.begin(); it != requests.end(); ++it)
+	{
+		MappedFile inputFile;
+		const char* text = it->data.data();
+		std::size_t length = it->data.length();
+		if (it->kind == LEXER_REQUEST_PATH)
+		{
+			if (!inputFile.Open(it->data))
+			{
+				writer.Write<unsigned char>(0);
+				EncodeEndOfTokens(writer);
+				continue;
+			}
+			text = inputFile.GetData();
+			length = inputFile.GetLength();
+		}
+
+		std::size_t statusPosition = response.length();
+		writer.Write<unsigned char>(1);
+		bool status = lex.ScanLexemes(text, length,
+			[&writer](LexicalAnalyzer::LexemeType lexemeType, const char* lexeme, std::size_t lexemeLength, std::size_t offset)
+			{
+				EncodeToken(writer, lexemeType, lexeme, lexemeLength, offset);
+			});
+		if (!status)
+		{
+			response[statusPosition] = 0;
+		}
+		EncodeEndOfTokens(writer);
+	}
+}
@@ -4,765 +4,2930 @@ Creation date: 21.02.2018
 **************************************************************************/
 
 #include "../Headers/LexicalAnalyzer.hpp"
+#include "../Headers/FileUtilities.hpp"
+#include "../Headers/BinaryStream.hpp"
+#include "../Headers/Hash.hpp"
+#include "../Headers/StringLiteral.hpp"
+#include "../Headers/Utf8.hpp"
 
 #include <iostream>
 #include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <tuple>
+
+static const std::size_t DEFAULT_DICTIONARY_RETENTION = 1 << 16;
+static const std::size_t BYTES_PER_TOKEN_HINT = 8;
+static const std::size_t DICTIONARY_ENTRY_OVERHEAD = 96;
+static const std::size_t BOUNDED_READ_SIZE = 1 << 16;
+static const std::size_t NO_CHECKPOINT = static_cast<std::size_t>(-1);
+
+static const std::vector<std::string>& GetKeywords()
+{
+	static const std::vector<std::string> keywords({"auto", "break", "case", "char", "const", "continue",
+		"default", "do", "double", "else", "enum", "extern", "float", "for",
+		"goto", "static", "int", "long", "register", "return", "short", "signed",
+		"sizeof", "switch", "typedef", "union", "unsigned", "void", "volatile"});
+	return keywords;
+}
+
+static long long ReadPhaseClock()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+LexicalAnalyzer::LexicalAnalyzer()
+	: LexicalAnalyzer(GetSharedAutomaton())
+{
+}
+
+LexicalAnalyzer::LexicalAnalyzer(const std::shared_ptr<const DFA>& automaton)
+	: m_dfa(automaton)
+	, m_cursor(*automaton)
+	, m_lexemeDictionary(&m_resource)
+	, m_dictionaryRetention(DEFAULT_DICTIONARY_RETENTION)
+	, m_source(NULL, 0)
+	, m_lexemes(&m_resource)
+	, m_keywords(GetKeywords())
+	, m_indexedInput(0)
+	, m_inputOffset(0)
+	, m_errorRecovery(false)
+	, m_validateUtf8(false)
+	, m_structuralScan(false)
+	, m_phaseTiming(false)
+	, m_checkpointInterval(0)
+	, m_nextCheckpoint(NO_CHECKPOINT)
+	, m_tableHash(0)
+	, m_filteredTypes(0)
+	, m_filteredStates(NUMBER_OF_STATES, false)
+	, m_filterIdentifiers(false)
+	, m_decodeNumericLiterals(false)
+	, m_dictionaryBytes(0)
+	, m_memoryBudget(0)
+	, m_numberOfSpilledTokens(0)
+	, m_numberOfSpilledErrors(0)
+	, m_boundedInputLength(0)
+	, m_spillFailed(false)
+	, m_streamOffset(0)
+	, m_streamHeldBackOffset(0)
+	, m_streamLexemeStart(0)
+	, m_streamInputStart(0)
+	, m_streamAtInputStart(true)
+	, m_streamState(INITIAL_STATE)
+	, m_streamInLexeme(false)
+	, m_streamInError(false)
+	, m_streamFailed(false)
+	, m_streamLineStart(true)
+	, m_streamExpectHeaderName(false)
+	, m_streamRecordErrors(false)
+{
+	ResetPhaseTimes();
+}
+
+std::shared_ptr<const DFA> LexicalAnalyzer::BuildAutomaton()
+{
+	std::shared_ptr<DFA> dfa = std::make_shared<DFA>(NUMBER_OF_STATES, 256);
+	RegisterLexemeParsing(*dfa);
+	return dfa;
+}
+
+const std::shared_ptr<const DFA>& LexicalAnalyzer::GetSharedAutomaton()
+{
+	static const std::shared_ptr<const DFA> automaton = BuildAutomaton();
+	return automaton;
+}
+
+const std::shared_ptr<const DFA>& LexicalAnalyzer::GetAutomaton() const
+{
+	return m_dfa;
+}
+
+// Copies the settings that decide which tokens and errors an input produces,
+// so that both analyzers lex it the same way given the same automaton.
+void LexicalAnalyzer::CopyConfiguration(const LexicalAnalyzer& other)
+{
+	m_errorRecovery = other.m_errorRecovery;
+	m_validateUtf8 = other.m_validateUtf8;
+	m_structuralScan = other.m_structuralScan;
+	m_decodeNumericLiterals = other.m_decodeNumericLiterals;
+	SetLexemeFilter(other.m_filteredTypes);
+}
+
+bool LexicalAnalyzer::Analyze(std::string text)
+{
+	return AnalyzeBuffer(text.data(), text.length());
+}
+
+bool LexicalAnalyzer::AnalyzeBuffer(const char* text, std::size_t length)
+{
+	if (m_memoryBudget != 0)
+	{
+		return AnalyzeBufferWithinBudget(text, length);
+	}
+	m_inputOffset = m_text.length();
+	m_text.append(text, length);
+	BeginInput();
+	return AnalyzeText(m_text.data() + m_inputOffset, length);
+}
+
+bool LexicalAnalyzer::AnalyzeFile(std::string fileName)
+{
+	if (m_memoryBudget != 0)
+	{
+		return AnalyzeFileWithinBudget(fileName);
+	}
+	m_inputOffset = m_text.length();
+	BeginInput();
+	if (!ReadFileContents(fileName, m_text))
+	{
+		return false;
+	}
+	return AnalyzeText(m_text.data() + m_inputOffset, m_text.length() - m_inputOffset);
+}
+
+void LexicalAnalyzer::BeginInput()
+{
+	m_inputStarts.push_back(m_inputOffset);
+	m_lineIndex.Clear();
+}
+
+bool LexicalAnalyzer::AnalyzeText(const char* text, std::size_t length)
+{
+	ReserveForInput(length);
+	std::size_t firstError = m_errors.size();
+	std::size_t invalidOffset = m_validateUtf8 ? FindInvalidUtf8(text, length) : length;
+	if (invalidOffset != length && !m_errorRecovery)
+	{
+		return false;
+	}
+	m_source.Assign(text, length);
+	const SourceView& source = m_source;
+	bool lineStart = true;
+	bool expectHeaderName = false;
+	std::size_t position = 0;
+	BeginCheckpoints();
+	while (position < source.GetLogicalEnd())
+	{
+		std::size_t lexemeStart = position;
+		if (position >= m_nextCheckpoint)
+		{
+			RecordCheckpoint(position, lineStart, expectHeaderName);
+		}
+		m_cursor.ResetState(GetInitialState(lineStart, expectHeaderName));
+		bool status = m_cursor.ParseLexeme(source, position);
+		if (!status)
+		{
+			if (!m_errorRecovery)
+			{
+				m_cursor.ResetState();
+				return false;
+			}
+			position = RecoverFromError(source, lexemeStart, position);
+			lineStart = false;
+			expectHeaderName = false;
+			continue;
+		}
+
+		int state = m_cursor.GetCurrentState();
+		UpdateLineState(source, state, lexemeStart, position, lineStart, expectHeaderName);
+		if (state == WHITESPACE_END || m_filteredStates[state])
+		{
+			continue;
+		}
+
+		if (source.HasSplices())
+		{
+			source.GetLogicalText(lexemeStart, position, m_lexemeBuffer);
+		}
+		else
+		{
+			m_lexemeBuffer.assign(text + lexemeStart, position - lexemeStart);
+		}
+		if (m_filterIdentifiers && state == IDENTIFIER_END &&
+			IsLexemeTypeFiltered(GetIdentifierType(m_lexemeBuffer)))
+		{
+			continue;
+		}
+		long long dictionaryStart = m_phaseTiming ? ReadPhaseClock() : 0;
+		AddLexemeToDictionary(m_lexemeBuffer, m_inputOffset + lexemeStart);
+		if (m_phaseTiming)
+		{
+			m_phaseTimes.dictionaryTime += ReadPhaseClock() - dictionaryStart;
+		}
+	}
+	m_cursor.ResetState();
+	if (invalidOffset != length)
+	{
+		AddUtf8Errors(text, length, invalidOffset, firstError);
+	}
+	return true;
+}
+
+static bool CompareErrorOffsets(const LexicalAnalyzer::LexicalError& first, const LexicalAnalyzer::LexicalError& second)
+{
+	return first.offset < second.offset;
+}
+
+void LexicalAnalyzer::AddUtf8Errors(const char* text, std::size_t length, std::size_t invalidOffset, std::size_t firstError)
+{
+	// Each ill-formed sequence (a stray byte and the continuation bytes after
+	// it) becomes one error unless the scanner already reported that byte.
+	std::size_t lexerErrors = m_errors.size();
+	while (invalidOffset < length)
+	{
+		std::size_t errorEnd = invalidOffset + 1;
+		while (errorEnd < length && (static_cast<unsigned char>(text[errorEnd]) & 0xC0) == 0x80)
+		{
+			++errorEnd;
+		}
+		LexicalError error = { m_inputOffset + invalidOffset, errorEnd - invalidOffset };
+		std::vector<LexicalError>::iterator it = std::upper_bound(
+			m_errors.begin() + firstError, m_errors.begin() + lexerErrors, error, CompareErrorOffsets);
+		if (it == m_errors.begin() + firstError || (it - 1)->offset + (it - 1)->length <= error.offset)
+		{
+			m_errors.push_back(error);
+		}
+		invalidOffset = errorEnd + FindInvalidUtf8(text + errorEnd, length - errorEnd);
+	}
+	std::inplace_merge(m_errors.begin() + firstError, m_errors.begin() + lexerErrors, m_errors.end(), CompareErrorOffsets);
+}
+
+int LexicalAnalyzer::GetInitialState(bool lineStart, bool expectHeaderName) const
+{
+	if (lineStart)
+	{
+		return LINE_START_STATE;
+	}
+	if (expectHeaderName)
+	{
+		return HEADER_NAME_INITIAL_STATE;
+	}
+	return INITIAL_STATE;
+}
+
+void LexicalAnalyzer::UpdateLineState(
+	const SourceView& source,
+	int state,
+	std::size_t lexemeStart,
+	std::size_t lexemeEnd,
+	bool& lineStart,
+	bool& expectHeaderName
+	)
+{
+	if (state == WHITESPACE_END)
+	{
+		if (source.ContainsNewline(lexemeStart, lexemeEnd))
+		{
+			lineStart = true;
+			expectHeaderName = false;
+		}
+		return;
+	}
+	if (state == LINE_COMMENT_END || state == BLOCK_COMMENT_END)
+	{
+		return;
+	}
+	lineStart = false;
+	expectHeaderName = state == DIRECTIVE_END &&
+		IsIncludeDirective(source.GetLogicalText(lexemeStart, lexemeEnd));
+}
+
+void LexicalAnalyzer::UpdateLineState(
+	int state,
+	const char* lexeme,
+	std::size_t lexemeLength,
+	bool& lineStart,
+	bool& expectHeaderName
+	)
+{
+	if (state == WHITESPACE_END)
+	{
+		if (std::memchr(lexeme, '\n', lexemeLength) != NULL)
+		{
+			lineStart = true;
+			expectHeaderName = false;
+		}
+		return;
+	}
+	if (state == LINE_COMMENT_END || state == BLOCK_COMMENT_END)
+	{
+		return;
+	}
+	lineStart = false;
+	expectHeaderName = state == DIRECTIVE_END && IsIncludeDirective(std::string(lexeme, lexemeLength));
+}
+
+std::size_t LexicalAnalyzer::FindErrorEnd(
+	const SourceView& source,
+	std::size_t lexemeStart,
+	std::size_t errorPosition
+	)
+{
+	// The error spans the rejected prefix (or the offending byte when nothing was
+	// accepted) and every following byte that cannot start a lexeme.
+	const char* text = source.GetText();
+	std::size_t length = source.GetLength();
+	std::size_t errorEnd = errorPosition;
+	if (errorEnd == lexemeStart)
+	{
+		++errorEnd;
+	}
+	std::size_t spliceIndex = source.FindSpliceIndex(errorEnd);
+	std::size_t nextSplice = source.GetNextSplice(errorEnd, spliceIndex);
+	while (errorEnd < length)
+	{
+		if (errorEnd == nextSplice)
+		{
+			errorEnd = source.GetSpliceEnd(spliceIndex);
+			nextSplice = source.GetNextSplice(errorEnd, spliceIndex);
+			continue;
+		}
+		if (m_dfa->GetTransition(INITIAL_STATE, static_cast<unsigned char>(text[errorEnd])) != -1)
+		{
+			break;
+		}
+		++errorEnd;
+	}
+	return errorEnd;
+}
+
+std::size_t LexicalAnalyzer::RecoverFromError(
+	const SourceView& source,
+	std::size_t lexemeStart,
+	std::size_t errorPosition
+	)
+{
+	std::size_t errorEnd = FindErrorEnd(source, lexemeStart, errorPosition);
+
+	LexicalError error;
+	error.offset = m_inputOffset + lexemeStart;
+	error.length = errorEnd - lexemeStart;
+	m_errors.push_back(error);
+
+	if (IsLexemeTypeFiltered(ERROR))
+	{
+		return errorEnd;
+	}
+	std::string lexeme = source.HasSplices() ?
+		source.GetLogicalText(lexemeStart, errorEnd) :
+		std::string(source.GetText() + lexemeStart, error.length);
+	AddLexemeToDictionary(lexeme, ERROR, error.offset);
+	return errorEnd;
+}
+
+bool LexicalAnalyzer::MinifyFile(std::string fileName, std::ostream& output)
+{
+	MappedFile inputFile;
+	if (!inputFile.Open(fileName))
+	{
+		return false;
+	}
+	return Minify(inputFile.GetData(), inputFile.GetLength(), output);
+}
+
+bool LexicalAnalyzer::Minify(const char* text, std::size_t length, std::ostream& output)
+{
+	static const std::size_t OUTPUT_BUFFER_SIZE = 1 << 16;
+
+	SourceView source(text, length);
+	std::string buffer;
+	buffer.reserve(OUTPUT_BUFFER_SIZE + 256);
+
+	bool lineStart = true;
+	bool expectHeaderName = false;
+	bool inDirective = false;
+	bool separated = false;
+	char previous = '\n';
+	std::size_t position = 0;
+	while (position < source.GetLogicalEnd())
+	{
+		std::size_t lexemeStart = position;
+		m_cursor.ResetState(GetInitialState(lineStart, expectHeaderName));
+		bool status = m_cursor.ParseLexeme(source, position);
+		int state = m_cursor.GetCurrentState();
+		if (!status)
+		{
+			if (!m_errorRecovery)
+			{
+				m_cursor.ResetState();
+				output.write(buffer.data(), buffer.length());
+				return false;
+			}
+			position = FindErrorEnd(source, lexemeStart, position);
+			lineStart = false;
+			expectHeaderName = false;
+		}
+		else
+		{
+			UpdateLineState(source, state, lexemeStart, position, lineStart, expectHeaderName);
+			if (state == WHITESPACE_END && inDirective && lineStart)
+			{
+				buffer.push_back('\n');
+				previous = '\n';
+				inDirective = false;
+				separated = false;
+				continue;
+			}
+			if (state == WHITESPACE_END || state == LINE_COMMENT_END || state == BLOCK_COMMENT_END)
+			{
+				separated = true;
+				continue;
+			}
+		}
+
+		std::string logicalText;
+		const char* lexemeText = text + lexemeStart;
+		std::size_t lexemeLength = position - lexemeStart;
+		if (status && source.HasSplices())
+		{
+			logicalText = source.GetLogicalText(lexemeStart, position);
+			lexemeText = logicalText.data();
+			lexemeLength = logicalText.length();
+		}
+
+		std::string directive;
+		if (status && state == DIRECTIVE_END)
+		{
+			if (previous != '\n')
+			{
+				buffer.push_back('\n');
+			}
+			inDirective = true;
+			directive = "#" + GetDirectiveName(lexemeText, lexemeLength);
+			lexemeText = directive.data();
+			lexemeLength = directive.length();
+		}
+		else if (separated && (inDirective || NeedsSeparator(previous, lexemeText[0])))
+		{
+			buffer.push_back(' ');
+		}
+		buffer.append(lexemeText, lexemeLength);
+		previous = lexemeText[lexemeLength - 1];
+		separated = false;
+
+		if (buffer.length() >= OUTPUT_BUFFER_SIZE)
+		{
+			output.write(buffer.data(), buffer.length());
+			buffer.clear();
+		}
+	}
+	if (previous != '\n')
+	{
+		buffer.push_back('\n');
+	}
+	output.write(buffer.data(), buffer.length());
+	m_cursor.ResetState();
+	return true;
+}
+
+bool LexicalAnalyzer::CountLexemesInFile(std::string fileName, LexemeStatistics& statistics)
+{
+	MappedFile inputFile;
+	if (!inputFile.Open(fileName))
+	{
+		return false;
+	}
+	return CountLexemes(inputFile.GetData(), inputFile.GetLength(), statistics);
+}
+
+bool LexicalAnalyzer::CountLexemes(const char* text, std::size_t length, LexemeStatistics& statistics)
+{
+	return ScanLexemes(text, length,
+		[&statistics](LexemeType lexemeType, const char* lexeme, std::size_t lexemeLength, std::size_t)
+		{
+			statistics.Add(lexemeType, lexeme, lexemeLength);
+		});
+}
+
+bool LexicalAnalyzer::ScanLexemes(const char* text, std::size_t length, const LexemeHandler& handler)
+{
+	m_source.Assign(text, length);
+	if (m_structuralScan)
+	{
+		return ScanStructural(handler);
+	}
+	const SourceView& source = m_source;
+	bool lineStart = true;
+	bool expectHeaderName = false;
+	std::size_t position = 0;
+	BeginCheckpoints();
+	while (position < source.GetLogicalEnd())
+	{
+		std::size_t lexemeStart = position;
+		if (position >= m_nextCheckpoint)
+		{
+			RecordCheckpoint(position, lineStart, expectHeaderName);
+		}
+		m_cursor.ResetState(GetInitialState(lineStart, expectHeaderName));
+		bool status = m_cursor.ParseLexeme(source, position);
+		if (!DeliverScannedLexeme(source, source.HasSplices(), status, m_cursor.GetCurrentState(), lexemeStart, position,
+			lineStart, expectHeaderName, handler))
+		{
+			m_cursor.ResetState();
+			return false;
+		}
+	}
+	m_cursor.ResetState();
+	return true;
+}
+
+// Lexemes that end before the next line splice (including the lookahead
+// byte) are matched on the raw text; only the ones touching a splice are
+// rescanned through the logical view.
+bool LexicalAnalyzer::ScanStructural(const LexemeHandler& handler)
+{
+	const char* text = m_source.GetText();
+	std::size_t length = m_source.GetLength();
+	m_structuralIndex.Assign(text, length);
+	std::size_t spliceIndex = 0;
+	std::size_t nextSplice = m_source.GetNextSplice(0, spliceIndex);
+	bool lineStart = true;
+	bool expectHeaderName = false;
+	std::size_t position = 0;
+	BeginCheckpoints();
+	while (position < m_source.GetLogicalEnd())
+	{
+		std::size_t lexemeStart = position;
+		if (position >= m_nextCheckpoint)
+		{
+			RecordCheckpoint(position, lineStart, expectHeaderName);
+		}
+		int state = expectHeaderName ? -1 : MatchStructuralLexeme(position);
+		bool accepted = true;
+		if (state == -1)
+		{
+			position = lexemeStart;
+			m_cursor.ResetState(GetInitialState(lineStart, expectHeaderName));
+			accepted = m_cursor.ParseLexeme(text, length, position);
+			state = m_cursor.GetCurrentState();
+		}
+		bool spliced = position >= nextSplice && nextSplice < length;
+		if (spliced)
+		{
+			position = lexemeStart;
+			m_cursor.ResetState(GetInitialState(lineStart, expectHeaderName));
+			accepted = m_cursor.ParseLexeme(m_source, position);
+			state = m_cursor.GetCurrentState();
+			spliced = position > nextSplice;
+		}
+		if (!DeliverScannedLexeme(m_source, spliced, accepted, state, lexemeStart, position,
+			lineStart, expectHeaderName, handler))
+		{
+			m_cursor.ResetState();
+			return false;
+		}
+		if (position > nextSplice)
+		{
+			nextSplice = m_source.GetNextSplice(position, spliceIndex);
+		}
+	}
+	m_cursor.ResetState();
+	return true;
+}
+
+// Scans the lexemes of text that overlap [begin, end), starting from a
+// checkpoint recorded while scanning the same text. Only the bytes from the
+// checkpoint on are read, so length may stop anywhere past the lexeme
+// boundary that follows end, as long as the lookahead byte is included;
+// offsets are relative to text.
+bool LexicalAnalyzer::ScanRange(
+	const char* text,
+	std::size_t length,
+	const ScanCheckpoint& checkpoint,
+	std::size_t begin,
+	std::size_t end,
+	const LexemeHandler& handler
+	)
+{
+	if (checkpoint.offset > length)
+	{
+		return false;
+	}
+	std::size_t base = checkpoint.offset;
+	m_source.Assign(text + base, length - base);
+	const SourceView& source = m_source;
+	LexemeHandler rangeHandler =
+		[&handler, base](LexemeType lexemeType, const char* lexeme, std::size_t lexemeLength, std::size_t offset)
+		{
+			handler(lexemeType, lexeme, lexemeLength, base + offset);
+		};
+	LexemeHandler skipHandler = [](LexemeType, const char*, std::size_t, std::size_t) {};
+	bool lineStart = checkpoint.lineStart;
+	bool expectHeaderName = checkpoint.expectHeaderName;
+	std::size_t position = 0;
+	while (position < source.GetLogicalEnd() && base + position < end)
+	{
+		std::size_t lexemeStart = position;
+		m_cursor.ResetState(GetInitialState(lineStart, expectHeaderName));
+		bool status = m_cursor.ParseLexeme(source, position);
+		std::size_t lexemeEnd = status || !m_errorRecovery ? position : FindErrorEnd(source, lexemeStart, position);
+		bool overlapping = base + lexemeEnd > begin;
+		if (!DeliverScannedLexeme(source, source.HasSplices(), status, m_cursor.GetCurrentState(), lexemeStart, position,
+			lineStart, expectHeaderName, overlapping ? rangeHandler : skipHandler))
+		{
+			m_cursor.ResetState();
+			return false;
+		}
+	}
+	m_cursor.ResetState();
+	return true;
+}
+
+// Ends whitespace runs, identifiers, comments and string literals from the
+// structural bitmasks and returns the state the automaton would accept them
+// in. Everything else (numbers, operators, character literals, directives,
+// non-ASCII bytes and malformed input) returns -1 and goes through the
+// automaton, which keeps the result identical to the byte-wise scan.
+int LexicalAnalyzer::MatchStructuralLexeme(std::size_t& position)
+{
+	const char* text = m_source.GetText();
+	std::size_t length = m_source.GetLength();
+	StructuralIndex& index = m_structuralIndex;
+	char first = text[position];
+
+	if (index.Test(position, &StructuralBlock::whitespace))
+	{
+		position = index.FindFirstNot(position, &StructuralBlock::whitespace);
+		return WHITESPACE_END;
+	}
+	if (index.Test(position, &StructuralBlock::identifier))
+	{
+		std::size_t end = index.FindFirstNot(position, &StructuralBlock::identifier);
+		if ((first >= '0' && first <= '9') || (end < length && static_cast<unsigned char>(text[end]) >= 0x80))
+		{
+			return -1;
+		}
+		position = end;
+		return IDENTIFIER_END;
+	}
+	if (first == '"')
+	{
+		bool escaped = false;
+		std::size_t i = position + 1;
+		while (true)
+		{
+			i = index.FindFirst(i, &StructuralBlock::stringStops);
+			if (i >= length || text[i] == '\n' || text[i] == '\0')
+			{
+				return -1;
+			}
+			if (text[i] == '"')
+			{
+				break;
+			}
+			escaped = true;
+			++i;
+			while (i < length && text[i] == '\r')
+			{
+				++i;
+			}
+			if (i >= length || text[i] == '\0')
+			{
+				return -1;
+			}
+			++i;
+		}
+		position = i + 1;
+		return escaped ? STRING_LITERAL_ESCAPED_END : STRING_LITERAL_END;
+	}
+	if (index.Test(position, &StructuralBlock::commentOpeners))
+	{
+		if (text[position + 1] == '/')
+		{
+			position = index.FindFirst(position + 2, &StructuralBlock::lineEnds);
+			return LINE_COMMENT_END;
+		}
+		for (std::size_t i = position + 2; ; ++i)
+		{
+			i = index.FindFirst(i, &StructuralBlock::blockCommentStops);
+			if (i >= length || text[i] == '\0')
+			{
+				return -1;
+			}
+			if (i + 1 < length && text[i + 1] == '/')
+			{
+				position = i + 2;
+				return BLOCK_COMMENT_END;
+			}
+		}
+	}
+	return -1;
+}
+
+bool LexicalAnalyzer::DeliverScannedLexeme(
+	const SourceView& source,
+	bool spliced,
+	bool accepted,
+	int state,
+	std::size_t lexemeStart,
+	std::size_t& position,
+	bool& lineStart,
+	bool& expectHeaderName,
+	const LexemeHandler& handler
+	)
+{
+	const char* text = source.GetText();
+	if (!accepted)
+	{
+		if (!m_errorRecovery)
+		{
+			return false;
+		}
+		position = FindErrorEnd(source, lexemeStart, position);
+		lineStart = false;
+		expectHeaderName = false;
+		if (!IsLexemeTypeFiltered(ERROR))
+		{
+			if (source.HasSplices())
+			{
+				source.GetLogicalText(lexemeStart, position, m_lexemeBuffer);
+				handler(ERROR, m_lexemeBuffer.data(), m_lexemeBuffer.length(), lexemeStart);
+			}
+			else
+			{
+				handler(ERROR, text + lexemeStart, position - lexemeStart, lexemeStart);
+			}
+		}
+		return true;
+	}
+
+	const char* lexeme = text + lexemeStart;
+	std::size_t lexemeLength = position - lexemeStart;
+	if (spliced)
+	{
+		UpdateLineState(source, state, lexemeStart, position, lineStart, expectHeaderName);
+	}
+	else
+	{
+		UpdateLineState(state, lexeme, lexemeLength, lineStart, expectHeaderName);
+	}
+	if (state == WHITESPACE_END || m_filteredStates[state])
+	{
+		return true;
+	}
+
+	if (spliced)
+	{
+		source.GetLogicalText(lexemeStart, position, m_lexemeBuffer);
+		lexeme = m_lexemeBuffer.data();
+		lexemeLength = m_lexemeBuffer.length();
+	}
+	else if (state == IDENTIFIER_END)
+	{
+		m_lexemeBuffer.assign(lexeme, lexemeLength);
+	}
+	long long classifyStart = m_phaseTiming ? ReadPhaseClock() : 0;
+	LexemeType lexemeType = state == IDENTIFIER_END ?
+		GetIdentifierType(m_lexemeBuffer) :
+		GetLexemeTypeForState(state, std::string());
+	if (m_phaseTiming)
+	{
+		m_phaseTimes.classifyTime += ReadPhaseClock() - classifyStart;
+	}
+	if (!IsLexemeTypeFiltered(lexemeType))
+	{
+		handler(lexemeType, lexeme, lexemeLength, lexemeStart);
+	}
+	return true;
+}
+
+// Up to numberOfLanes splice-free streams are scanned in lockstep, one byte
+// per lane per round, so the table loads of independent streams overlap
+// instead of forming a single dependency chain. Each stream's handler sees
+// exactly the lexemes ScanLexemes would report for it; streams with line
+// splices are scanned serially.
+bool LexicalAnalyzer::ScanInterleaved(std::vector<ScanStream>& streams, std::size_t numberOfLanes)
+{
+	if (numberOfLanes <= 1)
+	{
+		ScanLanes<1>(streams);
+	}
+	else if (numberOfLanes == 2)
+	{
+		ScanLanes<2>(streams);
+	}
+	else if (numberOfLanes <= 4)
+	{
+		ScanLanes<4>(streams);
+	}
+	else
+	{
+		ScanLanes<MAXIMUM_INTERLEAVED_LANES>(streams);
+	}
+	for (std::vector<ScanStream>::iterator it = streams.begin(); it != streams.end(); ++it)
+	{
+		if (!it->status)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+template <std::size_t NumberOfLanes>
+void LexicalAnalyzer::ScanLanes(std::vector<ScanStream>& streams)
+{
+	const int* transitionTable = m_dfa->GetTransitionTable();
+	const bool* acceptingStates = m_dfa->GetAcceptingStates();
+	const int numberOfSymbols = m_dfa->GetNumberOfTransitionSymbols();
+
+	InterleavedLane lanes[NumberOfLanes];
+	std::size_t nextStream = 0;
+	std::size_t activeLanes = 0;
+	for (std::size_t k = 0; k < NumberOfLanes; ++k)
+	{
+		if (StartLane(lanes[k], streams, nextStream))
+		{
+			++activeLanes;
+		}
+	}
+
+	while (activeLanes != 0)
+	{
+		for (std::size_t k = 0; k < NumberOfLanes; ++k)
+		{
+			InterleavedLane& lane = lanes[k];
+			if (lane.stream == NULL)
+			{
+				continue;
+			}
+			int state;
+			bool accepted;
+			if (lane.position < lane.length)
+			{
+				state = transitionTable[lane.state * numberOfSymbols +
+					static_cast<unsigned char>(lane.text[lane.position])];
+				if (state != -1 && !acceptingStates[state])
+				{
+					lane.state = state;
+					++lane.position;
+					continue;
+				}
+				accepted = state != -1;
+			}
+			else
+			{
+				state = transitionTable[lane.state * numberOfSymbols + '\0'];
+				accepted = state != -1 && acceptingStates[state];
+			}
+
+			bool status = DeliverScannedLexeme(lane.source, false, accepted, state, lane.lexemeStart, lane.position,
+				lane.lineStart, lane.expectHeaderName, lane.stream->handler);
+			if (!status || lane.position >= lane.length)
+			{
+				lane.stream->status = status;
+				if (!StartLane(lane, streams, nextStream))
+				{
+					--activeLanes;
+				}
+				continue;
+			}
+			lane.lexemeStart = lane.position;
+			lane.state = GetInitialState(lane.lineStart, lane.expectHeaderName);
+		}
+	}
+}
+
+bool LexicalAnalyzer::StartLane(InterleavedLane& lane, std::vector<ScanStream>& streams, std::size_t& nextStream)
+{
+	lane.stream = NULL;
+	while (nextStream < streams.size())
+	{
+		ScanStream& stream = streams[nextStream++];
+		stream.status = true;
+		lane.source.Assign(stream.text, stream.length);
+		if (stream.length == 0)
+		{
+			continue;
+		}
+		if (lane.source.HasSplices())
+		{
+			stream.status = ScanLexemes(stream.text, stream.length, stream.handler);
+			continue;
+		}
+		lane.stream = &stream;
+		lane.text = stream.text;
+		lane.length = stream.length;
+		lane.position = 0;
+		lane.lexemeStart = 0;
+		lane.lineStart = true;
+		lane.expectHeaderName = false;
+		lane.state = GetInitialState(lane.lineStart, lane.expectHeaderName);
+		return true;
+	}
+	return false;
+}
+
+static std::size_t GetSpliceLength(const char* text, std::size_t length, std::size_t position, bool& incomplete)
+{
+	incomplete = false;
+	if (position + 1 < length && text[position + 1] == '\n')
+	{
+		return 2;
+	}
+	if (position + 2 < length && text[position + 1] == '\r' && text[position + 2] == '\n')
+	{
+		return 3;
+	}
+	incomplete = position + 1 == length || (position + 2 == length && text[position + 1] == '\r');
+	return 0;
+}
+
+// Forgets the analyzed input but keeps every buffer's capacity. Interned
+// lexemes are keyed by text and type, so neither they nor their decoded
+// payloads depend on the input they came from; the dictionary is kept as
+// long as it is within the retention limit.
+void LexicalAnalyzer::Clear()
+{
+	m_lexemes.clear();
+	m_errors.clear();
+	m_text.clear();
+	m_inputStarts.clear();
+	m_lineIndex.Clear();
+	m_inputOffset = 0;
+	m_cursor.ResetState();
+	BeginStream(LexemeHandler());
+	m_streamRecordErrors = false;
+	m_spillFile.Truncate();
+	m_numberOfSpilledTokens = 0;
+	m_numberOfSpilledErrors = 0;
+	m_boundedInputLength = 0;
+	m_spillFailed = false;
+
+	if (m_lexemeDictionary.size() > m_dictionaryRetention)
+	{
+		DropDictionary();
+	}
+}
+
+// With an arena the token buffer is dropped too, since its memory is given
+// back together with the dictionary's.
+void LexicalAnalyzer::DropDictionary()
+{
+	Lexemes(&m_resource).swap(m_lexemeDictionary);
+	m_dictionaryBytes = 0;
+	ClearLexemeSideTables();
+	if (m_arena)
+	{
+		Tokens(&m_resource).swap(m_lexemes);
+		m_arena->release();
+	}
+}
+
+// The tokens and the dictionary are dropped and the containers allocate
+// from resource (NULL for the default resource) from then on. The resource
+// must outlive the analyzer or the next call.
+void LexicalAnalyzer::SetMemoryResource(std::pmr::memory_resource* resource)
+{
+	Clear();
+	Tokens(&m_resource).swap(m_lexemes);
+	Lexemes(&m_resource).swap(m_lexemeDictionary);
+	m_dictionaryBytes = 0;
+	ClearLexemeSideTables();
+	m_resource.SetUpstream(resource != NULL ? resource : std::pmr::get_default_resource());
+	m_arena.reset();
+}
+
+// With the arena the tokens and the dictionary are bump-allocated from
+// blocks owned by the analyzer and freed only together, by ReleaseMemory or
+// when Clear drops the dictionary. Memory of grown or erased nodes is not
+// reused until then.
+void LexicalAnalyzer::SetArenaAllocation(bool enabled)
+{
+	if (!enabled)
+	{
+		SetMemoryResource(NULL);
+		return;
+	}
+	std::unique_ptr<std::pmr::monotonic_buffer_resource> arena(
+		new std::pmr::monotonic_buffer_resource(std::pmr::new_delete_resource()));
+	SetMemoryResource(arena.get());
+	m_arena = std::move(arena);
+}
+
+// Drops the tokens and the dictionary and gives their memory back at once.
+void LexicalAnalyzer::ReleaseMemory()
+{
+	Clear();
+	Tokens(&m_resource).swap(m_lexemes);
+	DropDictionary();
+}
+
+void LexicalAnalyzer::ClearLexemeSideTables()
+{
+	m_numericLiteralIndices.clear();
+	m_numericLiterals.clear();
+	m_escapedLiterals.clear();
+	m_decodedLiterals.clear();
+	m_literalArena.Reset();
+}
+
+void LexicalAnalyzer::ReserveForInput(std::size_t length)
+{
+	std::size_t expectedTokens = m_lexemes.size() + length / BYTES_PER_TOKEN_HINT;
+	if (expectedTokens > m_lexemes.capacity())
+	{
+		m_lexemes.reserve(std::max(expectedTokens, 2 * m_lexemes.capacity()));
+	}
+}
+
+void LexicalAnalyzer::BeginStream(const LexemeHandler& handler)
+{
+	m_streamHandler = handler;
+	m_streamCarry.clear();
+	m_streamHeldBack.clear();
+	m_streamOffset = 0;
+	m_streamHeldBackOffset = 0;
+	m_streamLexemeStart = 0;
+	m_streamInputStart = 0;
+	m_streamAtInputStart = true;
+	m_streamState = INITIAL_STATE;
+	m_streamInLexeme = false;
+	m_streamInError = false;
+	m_streamFailed = false;
+	m_streamLineStart = true;
+	m_streamExpectHeaderName = false;
+}
+
+bool LexicalAnalyzer::Feed(const char* data, std::size_t length)
+{
+	if (m_streamFailed)
+	{
+		return false;
+	}
+
+	// A backslash at the end of the previous chunk may start a line splice;
+	// it was held back until the following bytes are known.
+	std::size_t position = 0;
+	if (!m_streamHeldBack.empty())
+	{
+		std::size_t heldBackLength = m_streamHeldBack.length();
+		while (position < length && m_streamHeldBack.length() < 3)
+		{
+			m_streamHeldBack.push_back(data[position++]);
+		}
+		bool incomplete = false;
+		std::size_t spliceLength = GetSpliceLength(m_streamHeldBack.data(), m_streamHeldBack.length(), 0, incomplete);
+		if (incomplete)
+		{
+			m_streamOffset += length;
+			return true;
+		}
+		position = spliceLength != 0 ? spliceLength - heldBackLength : 0;
+		if (spliceLength == 0)
+		{
+			std::string heldBack;
+			heldBack.swap(m_streamHeldBack);
+			if (!FeedSegment(heldBack.data(), heldBackLength, m_streamHeldBackOffset))
+			{
+				return false;
+			}
+		}
+		m_streamHeldBack.clear();
+	}
+
+	std::size_t segmentStart = position;
+	while (true)
+	{
+		const char* backslash = static_cast<const char*>(std::memchr(data + position, '\\', length - position));
+		if (backslash == NULL)
+		{
+			break;
+		}
+		position = backslash - data;
+		bool incomplete = false;
+		std::size_t spliceLength = GetSpliceLength(data, length, position, incomplete);
+		if (incomplete)
+		{
+			m_streamHeldBack.assign(data + position, length - position);
+			m_streamHeldBackOffset = m_streamOffset + position;
+			length = position;
+			break;
+		}
+		if (spliceLength == 0)
+		{
+			++position;
+			continue;
+		}
+		if (!FeedSegment(data + segmentStart, position - segmentStart, m_streamOffset + segmentStart))
+		{
+			return false;
+		}
+		position += spliceLength;
+		segmentStart = position;
+	}
+	bool status = FeedSegment(data + segmentStart, length - segmentStart, m_streamOffset + segmentStart);
+	m_streamOffset += length + m_streamHeldBack.length();
+	return status;
+}
+
+bool LexicalAnalyzer::FeedSegment(const char* text, std::size_t length, std::size_t offset)
+{
+	std::size_t position = 0;
+	while (position < length)
+	{
+		std::size_t segmentStart = position;
+		if (m_streamInError)
+		{
+			while (position < length &&
+				m_dfa->GetTransition(INITIAL_STATE, static_cast<unsigned char>(text[position])) == -1)
+			{
+				++position;
+			}
+			m_streamCarry.append(text + segmentStart, position - segmentStart);
+			if (position < length)
+			{
+				DeliverStreamError();
+			}
+			continue;
+		}
+
+		if (!m_streamInLexeme)
+		{
+			// Line splices are skipped before a lexeme's first byte, except
+			// at the start of the input, where the buffered scanners begin the
+			// first lexeme.
+			m_streamState = GetInitialState(m_streamLineStart, m_streamExpectHeaderName);
+			m_streamLexemeStart = m_streamAtInputStart ? m_streamInputStart : offset + position;
+			m_streamAtInputStart = false;
+			m_streamInLexeme = true;
+		}
+		m_cursor.ResetState(m_streamState);
+		DFACursor::ParseStatus status = m_cursor.ResumeLexeme(text, length, position);
+		if (status == DFACursor::LEXEME_INCOMPLETE)
+		{
+			m_streamState = m_cursor.GetCurrentState();
+			m_streamCarry.append(text + segmentStart, length - segmentStart);
+			break;
+		}
+		if (status == DFACursor::LEXEME_REJECTED)
+		{
+			if (!m_errorRecovery)
+			{
+				m_streamFailed = true;
+				m_cursor.ResetState();
+				return false;
+			}
+			if (position == segmentStart && m_streamCarry.empty())
+			{
+				++position;
+			}
+			m_streamCarry.append(text + segmentStart, position - segmentStart);
+			m_streamInLexeme = false;
+			m_streamInError = true;
+			continue;
+		}
+
+		const char* lexeme = text + segmentStart;
+		std::size_t lexemeLength = position - segmentStart;
+		if (!m_streamCarry.empty())
+		{
+			m_streamCarry.append(lexeme, lexemeLength);
+			lexeme = m_streamCarry.data();
+			lexemeLength = m_streamCarry.length();
+		}
+		DeliverStreamLexeme(m_cursor.GetCurrentState(), lexeme, lexemeLength);
+		m_streamCarry.clear();
+		m_streamInLexeme = false;
+	}
+	m_cursor.ResetState();
+	return true;
+}
+
+bool LexicalAnalyzer::Finish()
+{
+	if (m_streamFailed)
+	{
+		return false;
+	}
+	if (!m_streamHeldBack.empty())
+	{
+		std::string heldBack;
+		heldBack.swap(m_streamHeldBack);
+		if (!FeedSegment(heldBack.data(), heldBack.length(), m_streamHeldBackOffset))
+		{
+			return false;
+		}
+	}
+	if (m_streamInLexeme)
+	{
+		m_cursor.ResetState(m_streamState);
+		bool status = m_cursor.FinishLexeme();
+		int state = m_cursor.GetCurrentState();
+		m_cursor.ResetState();
+		if (status)
+		{
+			DeliverStreamLexeme(state, m_streamCarry.data(), m_streamCarry.length());
+		}
+		else if (!m_errorRecovery)
+		{
+			m_streamFailed = true;
+			return false;
+		}
+		else
+		{
+			m_streamInError = true;
+		}
+		m_streamInLexeme = false;
+	}
+	if (m_streamInError)
+	{
+		DeliverStreamError();
+	}
+	m_streamCarry.clear();
+	m_streamLineStart = true;
+	m_streamExpectHeaderName = false;
+	m_streamInputStart = m_streamOffset;
+	m_streamAtInputStart = true;
+	return true;
+}
+
+void LexicalAnalyzer::DeliverStreamLexeme(int state, const char* lexeme, std::size_t lexemeLength)
+{
+	UpdateLineState(state, lexeme, lexemeLength, m_streamLineStart, m_streamExpectHeaderName);
+	if (state == WHITESPACE_END || m_filteredStates[state])
+	{
+		return;
+	}
+	LexemeType lexemeType = state == IDENTIFIER_END ?
+		GetIdentifierType(std::string(lexeme, lexemeLength)) :
+		GetLexemeTypeForState(state, std::string());
+	if (!IsLexemeTypeFiltered(lexemeType))
+	{
+		m_streamHandler(lexemeType, lexeme, lexemeLength, m_streamLexemeStart);
+	}
+}
+
+void LexicalAnalyzer::DeliverStreamError()
+{
+	if (m_streamRecordErrors)
+	{
+		LexicalError error = { m_inputOffset + m_streamLexemeStart, m_streamCarry.length() };
+		m_errors.push_back(error);
+	}
+	if (!IsLexemeTypeFiltered(ERROR))
+	{
+		m_streamHandler(ERROR, m_streamCarry.data(), m_streamCarry.length(), m_streamLexemeStart);
+	}
+	m_streamCarry.clear();
+	m_streamInError = false;
+	m_streamLineStart = false;
+	m_streamExpectHeaderName = false;
+}
+
+bool LexicalAnalyzer::AnalyzeBufferWithinBudget(const char* text, std::size_t length)
+{
+	BeginBoundedStream();
+	bool status = Feed(text, length) && Finish();
+	return EndBoundedStream(status, length);
+}
+
+bool LexicalAnalyzer::AnalyzeFileWithinBudget(const std::string& fileName)
+{
+	std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+	std::vector<char> chunk(BOUNDED_READ_SIZE);
+	std::size_t length = 0;
+	bool status = true;
+	BeginBoundedStream();
+	while (status && file)
+	{
+		file.read(&chunk[0], chunk.size());
+		std::size_t chunkLength = static_cast<std::size_t>(file.gcount());
+		status = Feed(&chunk[0], chunkLength);
+		length += chunkLength;
+	}
+	status = status && !file.bad() && Finish();
+	return EndBoundedStream(status, length);
+}
+
+void LexicalAnalyzer::BeginBoundedStream()
+{
+	m_inputOffset = m_boundedInputLength;
+	m_lineIndex.Clear();
+	BeginStream([this](LexemeType lexemeType, const char* lexeme, std::size_t lexemeLength, std::size_t offset)
+		{
+			AddStreamedLexeme(lexemeType, lexeme, lexemeLength, m_inputOffset + offset);
+		});
+	m_streamRecordErrors = true;
+}
+
+bool LexicalAnalyzer::EndBoundedStream(bool status, std::size_t length)
+{
+	m_boundedInputLength += length;
+	m_streamRecordErrors = false;
+	BeginStream(LexemeHandler());
+	return status && !m_spillFailed;
+}
+
+void LexicalAnalyzer::AddStreamedLexeme(LexemeType lexemeType, const char* lexeme, std::size_t lexemeLength, std::size_t offset)
+{
+	m_lexemeBuffer.assign(lexeme, lexemeLength);
+	Token token = { InternLexeme(m_lexemeBuffer, lexemeType), offset };
+	m_lexemes.push_back(token);
+	if (!m_spillFailed && GetMemoryUsage() > m_memoryBudget && !SpillTokens())
+	{
+		m_spillFailed = true;
+	}
+}
+
+std::size_t LexicalAnalyzer::GetMemoryUsage() const
+{
+	return m_lexemes.size() * sizeof(Token) + m_errors.size() * sizeof(LexicalError) + m_dictionaryBytes;
+}
+
+bool LexicalAnalyzer::SpillTokens()
+{
+	if (!m_spillFile.IsOpen() && !m_spillFile.Open(m_spillDirectory))
+	{
+		return false;
+	}
+
+	// A segment carries its own table of the lexemes it references, so it can
+	// be replayed after the dictionary has dropped them.
+	static const unsigned int NO_SPILL_ENTRY = ~0u;
+	m_spillEntries.clear();
+	m_spillEntryIndices.assign(m_lexemeDictionary.size(), NO_SPILL_ENTRY);
+	for (Tokens::iterator it = m_lexemes.begin(); it != m_lexemes.end(); ++it)
+	{
+		LexemeId lexemeId = it->lexeme->second.second;
+		if (m_spillEntryIndices[lexemeId] == NO_SPILL_ENTRY)
+		{
+			m_spillEntryIndices[lexemeId] = static_cast<unsigned int>(m_spillEntries.size());
+			m_spillEntries.push_back(it->lexeme);
+		}
+	}
+
+	m_spillBuffer.clear();
+	BinaryWriter writer(m_spillBuffer);
+	unsigned long long payloadLength = 0;
+	writer.Write(payloadLength);
+	writer.WriteVarint(m_spillEntries.size());
+	for (std::vector<Lexemes::iterator>::iterator it = m_spillEntries.begin(); it != m_spillEntries.end(); ++it)
+	{
+		writer.WriteVarint((*it)->second.first);
+		writer.WriteVarint((*it)->first.length());
+		writer.WriteBytes((*it)->first.data(), (*it)->first.length());
+	}
+	writer.WriteVarint(m_lexemes.size());
+	std::size_t previousOffset = 0;
+	for (Tokens::iterator it = m_lexemes.begin(); it != m_lexemes.end(); ++it)
+	{
+		writer.WriteVarint(m_spillEntryIndices[it->lexeme->second.second]);
+		writer.WriteVarint(it->offset - previousOffset);
+		previousOffset = it->offset;
+	}
+	writer.WriteVarint(m_errors.size());
+	previousOffset = 0;
+	for (std::vector<LexicalError>::iterator it = m_errors.begin(); it != m_errors.end(); ++it)
+	{
+		writer.WriteVarint(it->offset - previousOffset);
+		writer.WriteVarint(it->length);
+		previousOffset = it->offset;
+	}
+	payloadLength = m_spillBuffer.length() - sizeof(payloadLength);
+	std::memcpy(&m_spillBuffer[0], &payloadLength, sizeof(payloadLength));
+	if (!m_spillFile.Append(m_spillBuffer.data(), m_spillBuffer.length()))
+	{
+		return false;
+	}
+
+	m_numberOfSpilledTokens += m_lexemes.size();
+	m_numberOfSpilledErrors += m_errors.size();
+	m_lexemes.clear();
+	m_errors.clear();
+	EvictColdLexemes();
+	return true;
+}
+
+// Literals, comments and errors rarely repeat, so they leave the dictionary
+// once their tokens are on disk; the remaining lexemes are renumbered densely.
+void LexicalAnalyzer::EvictColdLexemes()
+{
+	LexemeId lexemeId = 0;
+	m_dictionaryBytes = 0;
+	for (Lexemes::iterator it = m_lexemeDictionary.begin(); it != m_lexemeDictionary.end(); )
+	{
+		LexemeType lexemeType = it->second.first;
+		if (lexemeType == STRING_LITERAL || lexemeType == CHAR_LITERAL ||
+			lexemeType == INTEGER_LITERAL || lexemeType == FLOATING_LITERAL ||
+			lexemeType == LINE_COMMENT || lexemeType == BLOCK_COMMENT || lexemeType == ERROR)
+		{
+			m_lexemeDictionary.erase(it++);
+			continue;
+		}
+		it->second.second = lexemeId++;
+		m_dictionaryBytes += it->first.length() + DICTIONARY_ENTRY_OVERHEAD;
+		++it;
+	}
+	// Everything else left resident is the dictionary; keeping it under half
+	// the budget makes the next spill at least that far away, so a large
+	// resident remainder cannot cause a spill per token.
+	if (m_dictionaryBytes > m_memoryBudget / 2)
+	{
+		m_lexemeDictionary.clear();
+		m_dictionaryBytes = 0;
+	}
+	ClearLexemeSideTables();
+}
+
+bool LexicalAnalyzer::ForEachToken(const LexemeHandler& handler)
+{
+	std::vector<std::pair<LexemeType, std::pair<const char*, std::size_t> > > entries;
+	std::string segment;
+	unsigned long long position = 0;
+	while (position < m_spillFile.GetLength())
+	{
+		unsigned long long payloadLength = 0;
+		if (!m_spillFile.Read(position, reinterpret_cast<char*>(&payloadLength), sizeof(payloadLength)))
+		{
+			return false;
+		}
+		segment.resize(payloadLength);
+		if (!m_spillFile.Read(position + sizeof(payloadLength), &segment[0], payloadLength))
+		{
+			return false;
+		}
+		position += sizeof(payloadLength) + payloadLength;
+
+		BinaryReader reader(segment.data(), segment.length());
+		unsigned long long numberOfEntries = 0;
+		if (!reader.ReadVarint(numberOfEntries))
+		{
+			return false;
+		}
+		entries.clear();
+		for (unsigned long long i = 0; i < numberOfEntries; ++i)
+		{
+			unsigned long long lexemeType = 0;
+			unsigned long long lexemeLength = 0;
+			const char* lexeme = NULL;
+			if (!reader.ReadVarint(lexemeType) || lexemeType >= NUMBER_OF_LEXEME_TYPES ||
+				!reader.ReadVarint(lexemeLength) || !reader.ReadBytes(lexeme, lexemeLength))
+			{
+				return false;
+			}
+			entries.push_back(std::make_pair(static_cast<LexemeType>(lexemeType), std::make_pair(lexeme, lexemeLength)));
+		}
+		unsigned long long numberOfTokens = 0;
+		if (!reader.ReadVarint(numberOfTokens))
+		{
+			return false;
+		}
+		std::size_t offset = 0;
+		for (unsigned long long i = 0; i < numberOfTokens; ++i)
+		{
+			unsigned long long entryIndex = 0;
+			unsigned long long offsetDelta = 0;
+			if (!reader.ReadVarint(entryIndex) || entryIndex >= entries.size() || !reader.ReadVarint(offsetDelta))
+			{
+				return false;
+			}
+			offset += offsetDelta;
+			handler(entries[entryIndex].first, entries[entryIndex].second.first, entries[entryIndex].second.second, offset);
+		}
+		unsigned long long numberOfErrors = 0;
+		if (!reader.ReadVarint(numberOfErrors))
+		{
+			return false;
+		}
+		for (unsigned long long i = 0; i < numberOfErrors; ++i)
+		{
+			unsigned long long offsetDelta = 0;
+			unsigned long long errorLength = 0;
+			if (!reader.ReadVarint(offsetDelta) || !reader.ReadVarint(errorLength))
+			{
+				return false;
+			}
+		}
+	}
+
+	for (Tokens::iterator it = m_lexemes.begin(); it != m_lexemes.end(); ++it)
+	{
+		handler(it->lexeme->second.first, it->lexeme->first.data(), it->lexeme->first.length(), it->offset);
+	}
+	return true;
+}
+
+bool LexicalAnalyzer::NeedsSeparator(char previous, char next)
+{
+	// Whitespace is kept only where dropping it would merge two lexemes.
+	static const std::string operatorCharacters = "+-*/%<>=!&|^~#:.";
+	bool previousIsWord = std::isalnum(static_cast<unsigned char>(previous)) ||
+		previous == '_' || previous == '.' || static_cast<unsigned char>(previous) >= 0x80;
+	bool nextIsWord = std::isalnum(static_cast<unsigned char>(next)) ||
+		next == '_' || next == '.' || static_cast<unsigned char>(next) >= 0x80;
+	if (previousIsWord && (nextIsWord || next == '"' || next == '\''))
+	{
+		return true;
+	}
+	if ((previous == 'e' || previous == 'E' || previous == 'p' || previous == 'P') && (next == '+' || next == '-'))
+	{
+		return true;
+	}
+	return operatorCharacters.find(previous) != std::string::npos &&
+		operatorCharacters.find(next) != std::string::npos;
+}
+
+void LexicalAnalyzer::AddLexemeToDictionary(const std::string& lexeme, std::size_t offset)
+{
+	// Identifiers and keywords are told apart by their text alone, so known
+	// ones skip the classification.
+	int state = m_cursor.GetCurrentState();
+	if (state == IDENTIFIER_END)
+	{
+		Lexemes::iterator lexemeIt = m_lexemeDictionary.find(lexeme);
+		if (lexemeIt != m_lexemeDictionary.end() &&
+			(lexemeIt->second.first == IDENTIFIER || lexemeIt->second.first == KEYWORD))
+		{
+			Token token = { lexemeIt, offset };
+			m_lexemes.push_back(token);
+			return;
+		}
+	}
+
+	long long classifyStart = m_phaseTiming ? ReadPhaseClock() : 0;
+	LexemeType lexemeType = GetLexemeTypeForState(state, lexeme);
+	if (m_phaseTiming)
+	{
+		// Reported as classification rather than as part of the insert
+		// that AnalyzeText is timing around this call.
+		long long classifyTime = ReadPhaseClock() - classifyStart;
+		m_phaseTimes.classifyTime += classifyTime;
+		m_phaseTimes.dictionaryTime -= classifyTime;
+	}
+	std::size_t dictionarySize = m_lexemeDictionary.size();
+	AddLexemeToDictionary(lexeme, lexemeType, offset);
+	if (m_lexemeDictionary.size() != dictionarySize &&
+		(state == STRING_LITERAL_ESCAPED_END || state == CHAR_LITERAL_ESCAPED_END))
+	{
+		MarkEscapedLiteral(m_lexemes.back().lexeme->second.second);
+	}
+}
+
+void LexicalAnalyzer::AddLexemeToDictionary(const std::string& lexeme, LexemeType lexemeType, std::size_t offset)
+{
+	// Nodes are only built for new lexemes; with an arena a discarded node
+	// would stay allocated until the arena is released.
+	Lexemes::iterator lexemeIt;
+	if (!FindLexeme(lexeme, lexemeType, lexemeIt))
+	{
+		lexemeIt = EmplaceLexeme(lexemeIt, lexeme, lexemeType);
+		m_dictionaryBytes += lexeme.length() + DICTIONARY_ENTRY_OVERHEAD;
+		if (m_decodeNumericLiterals)
+		{
+			DecodeLexemePayload(lexemeIt);
+		}
+	}
+	Token token = { lexemeIt, offset };
+	m_lexemes.push_back(token);
+}
+
+// Finds the entry of lexeme with the given type. When there is none,
+// lexemeIt is set to the insertion hint for it.
+bool LexicalAnalyzer::FindLexeme(const std::string& lexeme, LexemeType lexemeType, Lexemes::iterator& lexemeIt)
+{
+	lexemeIt = m_lexemeDictionary.lower_bound(lexeme);
+	while (lexemeIt != m_lexemeDictionary.end() && !m_lexemeDictionary.key_comp()(lexeme, lexemeIt->first))
+	{
+		if (lexemeIt->second.first == lexemeType)
+		{
+			return true;
+		}
+		++lexemeIt;
+	}
+	return false;
+}
+
+LexicalAnalyzer::Lexemes::iterator LexicalAnalyzer::EmplaceLexeme(
+	Lexemes::iterator hint,
+	const std::string& lexeme,
+	LexemeType lexemeType
+	)
+{
+	return m_lexemeDictionary.emplace_hint(
+		hint,
+		std::piecewise_construct,
+		std::forward_as_tuple(lexeme.data(), lexeme.length()),
+		std::forward_as_tuple(lexemeType, static_cast<LexemeId>(m_lexemeDictionary.size()))
+		);
+}
+
+LexicalAnalyzer::Lexemes::iterator LexicalAnalyzer::InternLexeme(const std::string& lexeme, LexemeType lexemeType)
+{
+	Lexemes::iterator lexemeIt;
+	if (FindLexeme(lexeme, lexemeType, lexemeIt))
+	{
+		return lexemeIt;
+	}
+	lexemeIt = EmplaceLexeme(lexemeIt, lexeme, lexemeType);
+	m_dictionaryBytes += lexeme.length() + DICTIONARY_ENTRY_OVERHEAD;
+	if (m_decodeNumericLiterals)
+	{
+		DecodeLexemePayload(lexemeIt);
+	}
+	if ((lexemeType == STRING_LITERAL || lexemeType == CHAR_LITERAL) &&
+		lexeme.find('\\') != std::string::npos)
+	{
+		MarkEscapedLiteral(lexemeIt->second.second);
+	}
+	return lexemeIt;
+}
 
-LexicalAnalyzer::LexicalAnalyzer()
-	: m_dfa(LexicalAnalyzer::NUMBER_OF_STATES, 256)
-	, m_keywords({"auto", "break", "case", "char", "const", "continue",
-		"default", "do", "double", "else", "enum", "extern", "float", "for",
-		"goto", "static", "int", "long", "register", "return", "short", "signed",
-		"sizeof", "switch", "typedef", "union", "unsigned", "void", "volatile"})
+void LexicalAnalyzer::DecodeLexemePayload(Lexemes::iterator lexemeIt)
 {
-	RegisterLexemeParsing();
+	LexemeType lexemeType = lexemeIt->second.first;
+	if (lexemeType != INTEGER_LITERAL && lexemeType != FLOATING_LITERAL)
+	{
+		return;
+	}
+	NumericLiteral literal;
+	if (!DecodeNumericLiteral(lexemeIt->first.data(), lexemeIt->first.length(), literal))
+	{
+		return;
+	}
+	LexemeId lexemeId = lexemeIt->second.second;
+	if (static_cast<std::size_t>(lexemeId) >= m_numericLiteralIndices.size())
+	{
+		m_numericLiteralIndices.resize(std::max<std::size_t>(lexemeId + 1, 2 * m_numericLiteralIndices.size()), -1);
+	}
+	m_numericLiteralIndices[lexemeId] = static_cast<int>(m_numericLiterals.size());
+	m_numericLiterals.push_back(literal);
 }
 
-bool LexicalAnalyzer::Analyze(std::string text)
+void LexicalAnalyzer::MarkEscapedLiteral(LexemeId lexemeId)
 {
-	while (!text.empty())
+	if (static_cast<std::size_t>(lexemeId) >= m_escapedLiterals.size())
 	{
-		Lexeme lexeme;
-		bool status = m_dfa.ParseLexeme(text, text, lexeme);
-		if (!status)
-		{
-			std::cout << lexeme << '\n';
-			return false;
-		}
-		if (m_dfa.GetCurrentState() == WHITESPACE_END)
+		m_escapedLiterals.resize(std::max<std::size_t>(lexemeId + 1, 2 * m_escapedLiterals.size()), false);
+	}
+	m_escapedLiterals[lexemeId] = true;
+}
+
+bool LexicalAnalyzer::HasEscapeSequences(LexemeId lexemeId) const
+{
+	return lexemeId >= 0 && static_cast<std::size_t>(lexemeId) < m_escapedLiterals.size() &&
+		m_escapedLiterals[lexemeId];
+}
+
+bool LexicalAnalyzer::GetLiteralValue(const Token& token, const char*& data, std::size_t& length)
+{
+	LexemeType lexemeType = token.lexeme->second.first;
+	const Lexeme& lexeme = token.lexeme->first;
+	if ((lexemeType != STRING_LITERAL && lexemeType != CHAR_LITERAL) || lexeme.length() < 2)
+	{
+		return false;
+	}
+
+	// Literals without escapes are returned as a view of their dictionary
+	// entry; the others are decoded on first use into the arena.
+	data = lexeme.data() + 1;
+	length = lexeme.length() - 2;
+	LexemeId lexemeId = token.lexeme->second.second;
+	if (!HasEscapeSequences(lexemeId))
+	{
+		return true;
+	}
+	if (static_cast<std::size_t>(lexemeId) >= m_decodedLiterals.size())
+	{
+		m_decodedLiterals.resize(std::max<std::size_t>(lexemeId + 1, 2 * m_decodedLiterals.size()),
+			std::pair<const char*, std::size_t>(NULL, 0));
+	}
+	if (m_decodedLiterals[lexemeId].first == NULL)
+	{
+		char* output = m_literalArena.Allocate(length);
+		m_decodedLiterals[lexemeId] = std::make_pair(output, DecodeEscapeSequences(data, length, output));
+	}
+	data = m_decodedLiterals[lexemeId].first;
+	length = m_decodedLiterals[lexemeId].second;
+	return true;
+}
+
+void LexicalAnalyzer::SetDictionaryRetention(std::size_t maximumLexemes)
+{
+	m_dictionaryRetention = maximumLexemes;
+}
+
+// With a non-zero budget the input is analyzed in chunks and not retained;
+// completed tokens are spilled to an anonymous file in spillDirectory when the
+// tokens, errors and the dictionary outgrow the budget. GetTokens and
+// GetErrors then hold only what is still in memory; ForEachToken replays
+// all the tokens and GetNumberOfErrors counts all the errors.
+void LexicalAnalyzer::SetMemoryBudget(std::size_t memoryBudget, const std::string& spillDirectory)
+{
+	m_memoryBudget = memoryBudget;
+	m_spillDirectory = spillDirectory;
+}
+
+void LexicalAnalyzer::SetNumericLiteralDecoding(bool enabled)
+{
+	m_decodeNumericLiterals = enabled;
+}
+
+bool LexicalAnalyzer::GetNumericLiteral(LexemeId lexemeId, NumericLiteral& literal) const
+{
+	if (lexemeId < 0 || static_cast<std::size_t>(lexemeId) >= m_numericLiteralIndices.size() ||
+		m_numericLiteralIndices[lexemeId] == -1)
+	{
+		return false;
+	}
+	literal = m_numericLiterals[m_numericLiteralIndices[lexemeId]];
+	return true;
+}
+
+unsigned long long LexicalAnalyzer::GetConfigurationHash() const
+{
+	if (m_tableHash == 0)
+	{
+		m_tableHash = m_dfa->ComputeTableHash();
+	}
+	unsigned long long hash = m_tableHash;
+	hash = ComputeHash64(&m_filteredTypes, sizeof(m_filteredTypes), hash);
+	hash = ComputeHash64(&m_errorRecovery, sizeof(m_errorRecovery), hash);
+	hash = ComputeHash64(&m_validateUtf8, sizeof(m_validateUtf8), hash);
+	for (std::vector<std::string>::const_iterator it = m_keywords.begin(); it != m_keywords.end(); ++it)
+	{
+		hash = ComputeHash64(it->data(), it->length(), hash);
+	}
+	return hash;
+}
+
+// Token stream format: header, the distinct lexemes in order of first use,
+// then one (lexeme index, relative offset) pair per token and the errors.
+static const unsigned int TOKEN_STREAM_MAGIC = 0x43545858;
+static const unsigned int TOKEN_STREAM_VERSION = 1;
+
+void LexicalAnalyzer::SerializeTokens(std::size_t firstToken, std::size_t firstError, std::string& data)
+{
+	std::size_t inputOffset = m_inputOffset;
+	std::map<LexemeId, unsigned int> entryIndices;
+	std::vector<Lexemes::iterator> entries;
+	for (std::size_t i = firstToken; i < m_lexemes.size(); ++i)
+	{
+		Lexemes::iterator lexemeIt = m_lexemes[i].lexeme;
+		if (entryIndices.insert(std::make_pair(lexemeIt->second.second, entries.size())).second)
 		{
-			m_dfa.ResetState();
-			continue;
+			entries.push_back(lexemeIt);
 		}
-		AddLexemeToDictionary(lexeme);
+	}
 
-		m_dfa.ResetState();
+	BinaryWriter writer(data);
+	writer.Write<unsigned int>(TOKEN_STREAM_MAGIC);
+	writer.Write<unsigned int>(TOKEN_STREAM_VERSION);
+	writer.Write<unsigned long long>(m_text.length() - inputOffset);
+	writer.Write<unsigned long long>(entries.size());
+	writer.Write<unsigned long long>(m_lexemes.size() - firstToken);
+	writer.Write<unsigned long long>(m_errors.size() - firstError);
+	for (std::vector<Lexemes::iterator>::iterator it = entries.begin(); it != entries.end(); ++it)
+	{
+		writer.Write<unsigned int>((*it)->second.first);
+		writer.Write<unsigned int>((*it)->first.length());
+		writer.WriteBytes((*it)->first.data(), (*it)->first.length());
+	}
+	for (std::size_t i = firstToken; i < m_lexemes.size(); ++i)
+	{
+		writer.Write<unsigned int>(entryIndices[m_lexemes[i].lexeme->second.second]);
+		writer.Write<unsigned long long>(m_lexemes[i].offset - inputOffset);
+	}
+	for (std::size_t i = firstError; i < m_errors.size(); ++i)
+	{
+		writer.Write<unsigned long long>(m_errors[i].offset - inputOffset);
+		writer.Write<unsigned long long>(m_errors[i].length);
 	}
-	return true;
 }
 
-bool LexicalAnalyzer::AnalyzeFile(std::string fileName)
+bool LexicalAnalyzer::DeserializeTokens(const char* data, std::size_t length, const char* text, std::size_t textLength)
 {
-	std::ifstream inputFile(fileName.c_str());
-	if (!inputFile.is_open())
+	BinaryReader reader(data, length);
+	unsigned int magic;
+	unsigned int version;
+	unsigned long long storedTextLength;
+	unsigned long long numberOfEntries;
+	unsigned long long numberOfTokens;
+	unsigned long long numberOfErrors;
+	if (!reader.Read(magic) || magic != TOKEN_STREAM_MAGIC ||
+		!reader.Read(version) || version != TOKEN_STREAM_VERSION ||
+		!reader.Read(storedTextLength) || storedTextLength != textLength ||
+		!reader.Read(numberOfEntries) || !reader.Read(numberOfTokens) || !reader.Read(numberOfErrors))
 	{
 		return false;
 	}
-	while (!inputFile.eof())
+
+	// Validate the whole stream before the dictionary is touched.
+	std::vector<std::pair<LexemeType, std::string> > entries;
+	for (unsigned long long i = 0; i < numberOfEntries; ++i)
 	{
-		Lexeme lexeme;
-		bool status = m_dfa.ParseLexeme(inputFile, lexeme);
-		if (!status)
+		unsigned int lexemeType;
+		unsigned int lexemeLength;
+		const char* lexeme;
+		if (!reader.Read(lexemeType) || lexemeType >= NUMBER_OF_LEXEME_TYPES ||
+			!reader.Read(lexemeLength) || !reader.ReadBytes(lexeme, lexemeLength))
 		{
 			return false;
 		}
-		if (m_dfa.GetCurrentState() == WHITESPACE_END)
+		entries.push_back(std::make_pair(static_cast<LexemeType>(lexemeType), std::string(lexeme, lexemeLength)));
+	}
+	std::size_t tokenRecordSize = sizeof(unsigned int) + sizeof(unsigned long long);
+	std::size_t errorRecordSize = 2 * sizeof(unsigned long long);
+	if (reader.GetRemaining() != numberOfTokens * tokenRecordSize + numberOfErrors * errorRecordSize)
+	{
+		return false;
+	}
+	BinaryReader tokenReader = reader;
+	for (unsigned long long i = 0; i < numberOfTokens; ++i)
+	{
+		unsigned int entryIndex = 0;
+		unsigned long long offset = 0;
+		tokenReader.Read(entryIndex);
+		tokenReader.Read(offset);
+		if (entryIndex >= entries.size() || offset >= textLength)
 		{
-			m_dfa.ResetState();
-			continue;
+			return false;
 		}
-		AddLexemeToDictionary(lexeme);
+	}
+
+	std::vector<Lexemes::iterator> lexemes;
+	lexemes.reserve(entries.size());
+	for (std::size_t i = 0; i < entries.size(); ++i)
+	{
+		lexemes.push_back(InternLexeme(entries[i].second, entries[i].first));
+	}
 
-		m_dfa.ResetState();
+	m_inputOffset = m_text.length();
+	m_text.append(text, textLength);
+	BeginInput();
+	m_lexemes.reserve(m_lexemes.size() + numberOfTokens);
+	for (unsigned long long i = 0; i < numberOfTokens; ++i)
+	{
+		unsigned int entryIndex = 0;
+		unsigned long long offset = 0;
+		reader.Read(entryIndex);
+		reader.Read(offset);
+		Token token = { lexemes[entryIndex], m_inputOffset + offset };
+		m_lexemes.push_back(token);
+	}
+	for (unsigned long long i = 0; i < numberOfErrors; ++i)
+	{
+		unsigned long long offset = 0;
+		unsigned long long errorLength = 0;
+		reader.Read(offset);
+		reader.Read(errorLength);
+		LexicalError error = { m_inputOffset + offset, errorLength };
+		m_errors.push_back(error);
 	}
 	return true;
 }
 
-void LexicalAnalyzer::AddLexemeToDictionary(const std::string& lexeme)
+void LexicalAnalyzer::SetErrorRecovery(bool enabled)
+{
+	m_errorRecovery = enabled;
+}
+
+// Lets ScanLexemes end whitespace, identifiers, comments and string literals
+// from SIMD character-class bitmasks; lexemes touching a line splice still
+// go through the automaton.
+void LexicalAnalyzer::SetStructuralScan(bool enabled)
+{
+	m_structuralScan = enabled;
+}
+
+// With a non-zero interval, AnalyzeBuffer, AnalyzeFile and ScanLexemes
+// record the scanner state at the first lexeme boundary of every interval
+// bytes of their input, starting with offset 0, for ScanRange.
+void LexicalAnalyzer::SetCheckpointInterval(std::size_t interval)
+{
+	m_checkpointInterval = interval;
+}
+
+const std::vector<LexicalAnalyzer::ScanCheckpoint>& LexicalAnalyzer::GetCheckpoints() const
 {
-	Lexemes::iterator lexemeIt = m_lexemeDictionary.find(lexeme);
-	if (lexemeIt == m_lexemeDictionary.end())
+	return m_checkpoints;
+}
+
+// The checkpoint at the start is recorded up front so that input without
+// any lexeme (such as a run of line splices) still gets one.
+void LexicalAnalyzer::BeginCheckpoints()
+{
+	m_checkpoints.clear();
+	m_nextCheckpoint = NO_CHECKPOINT;
+	if (m_checkpointInterval != 0)
 	{
-		Lexemes::iterator it = m_lexemeDictionary.insert(
-			std::make_pair(
-				lexeme,
-				std::make_pair(
-					GetLexemeTypeForState(m_dfa.GetCurrentState(), lexeme),
-					m_lexemeDictionary.size()
-					)
-				)
-			).first;
-		m_lexemes.push_back(it);
+		RecordCheckpoint(0, true, false);
 	}
-	else
+}
+
+void LexicalAnalyzer::RecordCheckpoint(std::size_t position, bool lineStart, bool expectHeaderName)
+{
+	ScanCheckpoint checkpoint = { position, lineStart, expectHeaderName };
+	m_checkpoints.push_back(checkpoint);
+	m_nextCheckpoint = (position / m_checkpointInterval + 1) * m_checkpointInterval;
+}
+
+// Accumulates the time spent classifying lexemes (GetLexemeTypeForState and
+// GetIdentifierType) and inserting them into the dictionary. Each phase
+// reads the clock twice per lexeme, so this is meant for profiling runs.
+void LexicalAnalyzer::SetPhaseTiming(bool enabled)
+{
+	m_phaseTiming = enabled;
+}
+
+const LexicalAnalyzer::PhaseTimes& LexicalAnalyzer::GetPhaseTimes() const
+{
+	return m_phaseTimes;
+}
+
+void LexicalAnalyzer::ResetPhaseTimes()
+{
+	m_phaseTimes.classifyTime = 0;
+	m_phaseTimes.dictionaryTime = 0;
+}
+
+// Checks AnalyzeBuffer and AnalyzeFile input for well-formed UTF-8. Invalid
+// input fails the analysis, or is reported through the error list when
+// error recovery is enabled.
+void LexicalAnalyzer::SetUtf8Validation(bool enabled)
+{
+	m_validateUtf8 = enabled;
+}
+
+void LexicalAnalyzer::SetLexemeFilter(LexemeTypeMask filteredTypes)
+{
+	m_filteredTypes = filteredTypes;
+
+	// Resolve the filter per accepting state so that filtered lexemes are
+	// skipped before their text is built or looked up.
+	for (int state = 0; state < NUMBER_OF_STATES; ++state)
+	{
+		m_filteredStates[state] = m_dfa->IsAcceptingState(state) &&
+			state != IDENTIFIER_END && state != WHITESPACE_END &&
+			IsLexemeTypeFiltered(GetLexemeTypeForState(state, ""));
+	}
+	bool identifiersFiltered = IsLexemeTypeFiltered(IDENTIFIER);
+	bool keywordsFiltered = IsLexemeTypeFiltered(KEYWORD);
+	m_filteredStates[IDENTIFIER_END] = identifiersFiltered && keywordsFiltered;
+	m_filterIdentifiers = identifiersFiltered != keywordsFiltered;
+}
+
+LexicalAnalyzer::LexemeTypeMask LexicalAnalyzer::MaskForLexemeType(LexemeType lexemeType)
+{
+	return 1ULL << lexemeType;
+}
+
+bool LexicalAnalyzer::IsLexemeTypeFiltered(LexemeType lexemeType) const
+{
+	return (m_filteredTypes & MaskForLexemeType(lexemeType)) != 0;
+}
+
+const std::vector<LexicalAnalyzer::LexicalError>& LexicalAnalyzer::GetErrors() const
+{
+	return m_errors;
+}
+
+std::size_t LexicalAnalyzer::GetErrorCount() const
+{
+	return m_errors.size();
+}
+
+const LexicalAnalyzer::Tokens& LexicalAnalyzer::GetTokens() const
+{
+	return m_lexemes;
+}
+
+std::size_t LexicalAnalyzer::GetNumberOfTokens() const
+{
+	return m_numberOfSpilledTokens + m_lexemes.size();
+}
+
+std::size_t LexicalAnalyzer::GetNumberOfSpilledTokens() const
+{
+	return m_numberOfSpilledTokens;
+}
+
+std::size_t LexicalAnalyzer::GetNumberOfErrors() const
+{
+	return m_numberOfSpilledErrors + m_errors.size();
+}
+
+// Lines and columns are counted from the start of the input containing the
+// offset. Only that input is indexed; callers walking offsets in order keep
+// hitting the same index.
+void LexicalAnalyzer::GetSourcePosition(std::size_t offset, std::size_t& line, std::size_t& column)
+{
+	std::size_t inputIndex = 0;
+	std::size_t inputStart = 0;
+	std::size_t inputEnd = m_text.length();
+	std::vector<std::size_t>::const_iterator input =
+		std::upper_bound(m_inputStarts.begin(), m_inputStarts.end(), offset);
+	if (input != m_inputStarts.begin())
+	{
+		inputIndex = input - m_inputStarts.begin() - 1;
+		inputStart = m_inputStarts[inputIndex];
+		if (input != m_inputStarts.end())
+		{
+			inputEnd = *input;
+		}
+	}
+	if (!m_lineIndex.IsBuilt() || m_indexedInput != inputIndex)
 	{
-		m_lexemes.push_back(lexemeIt);
+		m_lineIndex.Build(m_text.data() + inputStart, inputEnd - inputStart);
+		m_indexedInput = inputIndex;
 	}
+	m_lineIndex.GetPosition(offset - inputStart, line, column);
 }
 
-void LexicalAnalyzer::RegisterLexemeParsing()
+void LexicalAnalyzer::RegisterLexemeParsing(DFA& dfa)
 {
-	RegisterWhitespaces();
-	RegisterDelimiter();
-	RegisterOperators();
-	RegisterLineComment();
-	RegisterBlockComment();
-	RegisterIdentifier();
-	RegisterStringLiteral();
-	RegisterCharLiteral();
-	RegisterIntegerLiteral();
-	RegisterFloatingLiteral();
-	RegisterParentheses();
+	RegisterWhitespaces(dfa);
+	RegisterDelimiter(dfa);
+	RegisterOperators(dfa);
+	RegisterLineComment(dfa);
+	RegisterBlockComment(dfa);
+	RegisterIdentifier(dfa);
+	RegisterStringLiteral(dfa);
+	RegisterCharLiteral(dfa);
+	RegisterIntegerLiteral(dfa);
+	RegisterFloatingLiteral(dfa);
+	RegisterParentheses(dfa);
+	RegisterPreprocessorOperators(dfa);
+	RegisterDirective(dfa);
+	RegisterHeaderName(dfa);
+	RegisterStartConditions(dfa);
 }
 
-void LexicalAnalyzer::RegisterWhitespaces()
+void LexicalAnalyzer::RegisterWhitespaces(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, WHITESPACE_BODY, ' ');
-	m_dfa.SetTransition(INITIAL_STATE, WHITESPACE_BODY, '\n');
-	m_dfa.SetTransition(INITIAL_STATE, WHITESPACE_BODY, '\t');
-	m_dfa.SetTransition(INITIAL_STATE, WHITESPACE_BODY, '\r');
-	m_dfa.SetTransition(INITIAL_STATE, WHITESPACE_BODY, '\b');
+	dfa.SetTransition(INITIAL_STATE, WHITESPACE_BODY, ' ');
+	dfa.SetTransition(INITIAL_STATE, WHITESPACE_BODY, '\n');
+	dfa.SetTransition(INITIAL_STATE, WHITESPACE_BODY, '\t');
+	dfa.SetTransition(INITIAL_STATE, WHITESPACE_BODY, '\r');
+	dfa.SetTransition(INITIAL_STATE, WHITESPACE_BODY, '\b');
 
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(WHITESPACE_BODY, WHITESPACE_END, i);
+		dfa.SetTransition(WHITESPACE_BODY, WHITESPACE_END, i);
 	}
 
-	m_dfa.SetTransition(WHITESPACE_BODY, WHITESPACE_BODY, ' ');
-	m_dfa.SetTransition(WHITESPACE_BODY, WHITESPACE_BODY, '\n');
-	m_dfa.SetTransition(WHITESPACE_BODY, WHITESPACE_BODY, '\t');
-	m_dfa.SetTransition(WHITESPACE_BODY, WHITESPACE_BODY, '\r');
-	m_dfa.SetTransition(WHITESPACE_BODY, WHITESPACE_BODY, '\b');
+	dfa.SetTransition(WHITESPACE_BODY, WHITESPACE_BODY, ' ');
+	dfa.SetTransition(WHITESPACE_BODY, WHITESPACE_BODY, '\n');
+	dfa.SetTransition(WHITESPACE_BODY, WHITESPACE_BODY, '\t');
+	dfa.SetTransition(WHITESPACE_BODY, WHITESPACE_BODY, '\r');
+	dfa.SetTransition(WHITESPACE_BODY, WHITESPACE_BODY, '\b');
 
-	m_dfa.SetAcceptingState(WHITESPACE_END);
+	dfa.SetAcceptingState(WHITESPACE_END);
 }
 
-void LexicalAnalyzer::RegisterDelimiter()
+void LexicalAnalyzer::RegisterDelimiter(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, DELIMITER_BODY, ';');
-	m_dfa.SetTransition(INITIAL_STATE, DELIMITER_BODY, ':');
-	m_dfa.SetTransition(INITIAL_STATE, DELIMITER_BODY, ',');
-	m_dfa.SetTransition(INITIAL_STATE, DELIMITER_BODY, '.');
-	for (int i = 0; i < 255; ++i)
+	dfa.SetTransition(INITIAL_STATE, DELIMITER_BODY, ';');
+	dfa.SetTransition(INITIAL_STATE, DELIMITER_BODY, ':');
+	dfa.SetTransition(INITIAL_STATE, DELIMITER_BODY, ',');
+	dfa.SetTransition(INITIAL_STATE, DELIMITER_DOT_BODY, '.');
+	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(DELIMITER_BODY, DELIMITER_END, i);
+		dfa.SetTransition(DELIMITER_BODY, DELIMITER_END, i);
+		dfa.SetTransition(DELIMITER_DOT_BODY, DELIMITER_END, i);
 	}
-	m_dfa.SetTransition(DELIMITER_BODY, DELIMITER_BODY, ';');
+	dfa.SetTransition(DELIMITER_BODY, DELIMITER_BODY, ';');
+	dfa.SetTransition(DELIMITER_DOT_BODY, DELIMITER_BODY, ';');
 
-	m_dfa.SetAcceptingState(DELIMITER_END);
+	dfa.SetAcceptingState(DELIMITER_END);
 }
 
-void LexicalAnalyzer::RegisterOperators()
+void LexicalAnalyzer::RegisterOperators(DFA& dfa)
 {
-	RegisterAssignmentOperator();
-	RegisterArithmeticOperators();
-	RegisterComparisonOperators();
-	RegisterBitwiseOperators();
-	RegisterLogicalOperators();
-	RegisterCompoundAssignmentOperators();
+	RegisterAssignmentOperator(dfa);
+	RegisterArithmeticOperators(dfa);
+	RegisterComparisonOperators(dfa);
+	RegisterBitwiseOperators(dfa);
+	RegisterLogicalOperators(dfa);
+	RegisterCompoundAssignmentOperators(dfa);
 }
 
-void LexicalAnalyzer::RegisterDivisionOperator()
+void LexicalAnalyzer::RegisterDivisionOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, COMMENT_OR_DIVISION_OPERATOR, '/');
+	dfa.SetTransition(INITIAL_STATE, COMMENT_OR_DIVISION_OPERATOR, '/');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(COMMENT_OR_DIVISION_OPERATOR, DIVISION_OPERATOR_END, i);
+		dfa.SetTransition(COMMENT_OR_DIVISION_OPERATOR, DIVISION_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(DIVISION_OPERATOR_END);
+	dfa.SetAcceptingState(DIVISION_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterDivisionAssignmentOperator()
+void LexicalAnalyzer::RegisterDivisionAssignmentOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, COMMENT_OR_DIVISION_OPERATOR, '/');
-	m_dfa.SetTransition(COMMENT_OR_DIVISION_OPERATOR, DIVISION_ASSIGNMENT_OPERATOR_BODY, '=');
+	dfa.SetTransition(INITIAL_STATE, COMMENT_OR_DIVISION_OPERATOR, '/');
+	dfa.SetTransition(COMMENT_OR_DIVISION_OPERATOR, DIVISION_ASSIGNMENT_OPERATOR_BODY, '=');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(DIVISION_ASSIGNMENT_OPERATOR_BODY, DIVISION_ASSIGNMENT_OPERATOR_END, i);
+		dfa.SetTransition(DIVISION_ASSIGNMENT_OPERATOR_BODY, DIVISION_ASSIGNMENT_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(DIVISION_ASSIGNMENT_OPERATOR_END);
+	dfa.SetAcceptingState(DIVISION_ASSIGNMENT_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterMultiplicationOperator()
+void LexicalAnalyzer::RegisterMultiplicationOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, MULTIPLICATION_OPERATOR_BODY, '*');
+	dfa.SetTransition(INITIAL_STATE, MULTIPLICATION_OPERATOR_BODY, '*');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(MULTIPLICATION_OPERATOR_BODY, MULTIPLICATION_OPERATOR_END, i);
+		dfa.SetTransition(MULTIPLICATION_OPERATOR_BODY, MULTIPLICATION_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(MULTIPLICATION_OPERATOR_END);
+	dfa.SetAcceptingState(MULTIPLICATION_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterMultiplicationAssignmentOperator()
+void LexicalAnalyzer::RegisterMultiplicationAssignmentOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, MULTIPLICATION_OPERATOR_BODY, '*');
-	m_dfa.SetTransition(MULTIPLICATION_OPERATOR_BODY, MULTIPLICATION_ASSIGNMENT_OPERATOR_BODY, '=');
+	dfa.SetTransition(INITIAL_STATE, MULTIPLICATION_OPERATOR_BODY, '*');
+	dfa.SetTransition(MULTIPLICATION_OPERATOR_BODY, MULTIPLICATION_ASSIGNMENT_OPERATOR_BODY, '=');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(MULTIPLICATION_ASSIGNMENT_OPERATOR_BODY, MULTIPLICATION_ASSIGNMENT_OPERATOR_END, i);
+		dfa.SetTransition(MULTIPLICATION_ASSIGNMENT_OPERATOR_BODY, MULTIPLICATION_ASSIGNMENT_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(MULTIPLICATION_ASSIGNMENT_OPERATOR_END);
+	dfa.SetAcceptingState(MULTIPLICATION_ASSIGNMENT_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterAssignmentOperator()
+void LexicalAnalyzer::RegisterAssignmentOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, ASSIGNMENT_OPERATOR_BODY, '=');
-	m_dfa.SetTransition(ASSIGNMENT_OPERATOR_BODY, EQUALITY_OPERATOR_BODY, '=');
+	dfa.SetTransition(INITIAL_STATE, ASSIGNMENT_OPERATOR_BODY, '=');
+	dfa.SetTransition(ASSIGNMENT_OPERATOR_BODY, EQUALITY_OPERATOR_BODY, '=');
 	for (int i = 0; i < 256; ++i)
 	{
 		if (i == '=') continue;
-		m_dfa.SetTransition(ASSIGNMENT_OPERATOR_BODY, ASSIGNMENT_OPERATOR_END, i);
-		m_dfa.SetTransition(EQUALITY_OPERATOR_BODY, EQUALITY_OPERATOR_END, i);
+		dfa.SetTransition(ASSIGNMENT_OPERATOR_BODY, ASSIGNMENT_OPERATOR_END, i);
+		dfa.SetTransition(EQUALITY_OPERATOR_BODY, EQUALITY_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(ASSIGNMENT_OPERATOR_END);
-	m_dfa.SetAcceptingState(EQUALITY_OPERATOR_END);
+	dfa.SetAcceptingState(ASSIGNMENT_OPERATOR_END);
+	dfa.SetAcceptingState(EQUALITY_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterAdditionAndIncrementOperators()
+void LexicalAnalyzer::RegisterAdditionAndIncrementOperators(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, ADDITION_OPERATOR_BODY, '+');
-	m_dfa.SetTransition(ADDITION_OPERATOR_BODY, INCREMENT_OPERATOR_BODY, '+');
+	dfa.SetTransition(INITIAL_STATE, ADDITION_OPERATOR_BODY, '+');
+	dfa.SetTransition(ADDITION_OPERATOR_BODY, INCREMENT_OPERATOR_BODY, '+');
 	for (int i = 0; i < 256; ++i)
 	{
 		if (i == '+') continue;
-		m_dfa.SetTransition(ADDITION_OPERATOR_BODY, ADDITION_OPERATOR_END, i);
-		m_dfa.SetTransition(INCREMENT_OPERATOR_BODY, INCREMENT_OPERATOR_END, i);
+		dfa.SetTransition(ADDITION_OPERATOR_BODY, ADDITION_OPERATOR_END, i);
+		dfa.SetTransition(INCREMENT_OPERATOR_BODY, INCREMENT_OPERATOR_END, i);
 	}
-	m_dfa.SetTransition(INCREMENT_OPERATOR_BODY, INCREMENT_OPERATOR_END, '+');
-	m_dfa.SetAcceptingState(ADDITION_OPERATOR_END);
-	m_dfa.SetAcceptingState(INCREMENT_OPERATOR_END);
+	dfa.SetTransition(INCREMENT_OPERATOR_BODY, INCREMENT_OPERATOR_END, '+');
+	dfa.SetAcceptingState(ADDITION_OPERATOR_END);
+	dfa.SetAcceptingState(INCREMENT_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterArithmeticOperators()
+void LexicalAnalyzer::RegisterArithmeticOperators(DFA& dfa)
 {
-	RegisterAdditionAndIncrementOperators();
-	RegisterSubtractionAndDecrementOperators();
-	RegisterDivisionOperator();
-	RegisterMultiplicationOperator();
-	RegisterModuloOperator();
+	RegisterAdditionAndIncrementOperators(dfa);
+	RegisterSubtractionAndDecrementOperators(dfa);
+	RegisterDivisionOperator(dfa);
+	RegisterMultiplicationOperator(dfa);
+	RegisterModuloOperator(dfa);
 }
 
-void LexicalAnalyzer::RegisterModuloOperator()
+void LexicalAnalyzer::RegisterModuloOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, MODULO_OPERATOR_BODY, '%');
+	dfa.SetTransition(INITIAL_STATE, MODULO_OPERATOR_BODY, '%');
 	for (int i = 0; i < 256; ++i)
 	{
 		if (i == '=') continue;
-		m_dfa.SetTransition(MODULO_OPERATOR_BODY, MODULO_OPERATOR_END, i);
+		dfa.SetTransition(MODULO_OPERATOR_BODY, MODULO_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(MODULO_OPERATOR_END);
+	dfa.SetAcceptingState(MODULO_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterComparisonOperators()
+void LexicalAnalyzer::RegisterComparisonOperators(DFA& dfa)
 {
-	RegisterNotEqualToOperator();
-	RegisterGreaterThanOperator();
-	RegisterLessThanOperator();
-	RegisterGreaterThanOrEqualToOperator();
-	RegisterLessThanOrEqualToOperator();
+	RegisterNotEqualToOperator(dfa);
+	RegisterGreaterThanOperator(dfa);
+	RegisterLessThanOperator(dfa);
+	RegisterGreaterThanOrEqualToOperator(dfa);
+	RegisterLessThanOrEqualToOperator(dfa);
 }
 
-void LexicalAnalyzer::RegisterLessThanOperator()
+void LexicalAnalyzer::RegisterLessThanOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, LESS_THAN_OPERATOR_BODY, '<');
+	dfa.SetTransition(INITIAL_STATE, LESS_THAN_OPERATOR_BODY, '<');
 	for (int i = 0; i < 256; ++i)
 	{
 		if (i == '<' || i == '=') continue;
-		m_dfa.SetTransition(LESS_THAN_OPERATOR_BODY, LESS_THAN_OPERATOR_END, i);
+		dfa.SetTransition(LESS_THAN_OPERATOR_BODY, LESS_THAN_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(LESS_THAN_OPERATOR_END);
+	dfa.SetAcceptingState(LESS_THAN_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterGreaterThanOperator()
+void LexicalAnalyzer::RegisterGreaterThanOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, GREATER_THAN_OPERATOR_BODY, '>');
+	dfa.SetTransition(INITIAL_STATE, GREATER_THAN_OPERATOR_BODY, '>');
 	for (int i = 0; i < 256; ++i)
 	{
 		if (i == '>' || i == '=') continue;
-		m_dfa.SetTransition(GREATER_THAN_OPERATOR_BODY, GREATER_THAN_OPERATOR_END, i);
+		dfa.SetTransition(GREATER_THAN_OPERATOR_BODY, GREATER_THAN_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(GREATER_THAN_OPERATOR_END);
+	dfa.SetAcceptingState(GREATER_THAN_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterNotEqualToOperator()
+void LexicalAnalyzer::RegisterNotEqualToOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, LOGICAL_NOT_OPERATOR_BODY, '!');
-	m_dfa.SetTransition(LOGICAL_NOT_OPERATOR_BODY, NOT_EQUAL_TO_OPERATOR_BODY, '=');
+	dfa.SetTransition(INITIAL_STATE, LOGICAL_NOT_OPERATOR_BODY, '!');
+	dfa.SetTransition(LOGICAL_NOT_OPERATOR_BODY, NOT_EQUAL_TO_OPERATOR_BODY, '=');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(NOT_EQUAL_TO_OPERATOR_BODY, NOT_EQUAL_TO_OPERATOR_END, i);
+		dfa.SetTransition(NOT_EQUAL_TO_OPERATOR_BODY, NOT_EQUAL_TO_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(NOT_EQUAL_TO_OPERATOR_END);
+	dfa.SetAcceptingState(NOT_EQUAL_TO_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterGreaterThanOrEqualToOperator()
+void LexicalAnalyzer::RegisterGreaterThanOrEqualToOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, GREATER_THAN_OPERATOR_BODY, '>');
-	m_dfa.SetTransition(GREATER_THAN_OPERATOR_BODY, GREATER_THAN_OR_EQUAL_TO_OPERATOR_BODY, '=');
+	dfa.SetTransition(INITIAL_STATE, GREATER_THAN_OPERATOR_BODY, '>');
+	dfa.SetTransition(GREATER_THAN_OPERATOR_BODY, GREATER_THAN_OR_EQUAL_TO_OPERATOR_BODY, '=');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(GREATER_THAN_OR_EQUAL_TO_OPERATOR_BODY, GREATER_THAN_OR_EQUAL_TO_OPERATOR_END, i);
+		dfa.SetTransition(GREATER_THAN_OR_EQUAL_TO_OPERATOR_BODY, GREATER_THAN_OR_EQUAL_TO_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(GREATER_THAN_OR_EQUAL_TO_OPERATOR_END);
+	dfa.SetAcceptingState(GREATER_THAN_OR_EQUAL_TO_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterLessThanOrEqualToOperator()
+void LexicalAnalyzer::RegisterLessThanOrEqualToOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, LESS_THAN_OPERATOR_BODY, '<');
-	m_dfa.SetTransition(LESS_THAN_OPERATOR_BODY, LESS_THAN_OR_EQUAL_TO_OPERATOR_BODY, '=');
+	dfa.SetTransition(INITIAL_STATE, LESS_THAN_OPERATOR_BODY, '<');
+	dfa.SetTransition(LESS_THAN_OPERATOR_BODY, LESS_THAN_OR_EQUAL_TO_OPERATOR_BODY, '=');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(LESS_THAN_OR_EQUAL_TO_OPERATOR_BODY, LESS_THAN_OR_EQUAL_TO_OPERATOR_END, i);
+		dfa.SetTransition(LESS_THAN_OR_EQUAL_TO_OPERATOR_BODY, LESS_THAN_OR_EQUAL_TO_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(LESS_THAN_OR_EQUAL_TO_OPERATOR_END);
+	dfa.SetAcceptingState(LESS_THAN_OR_EQUAL_TO_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterBitwiseOperators()
+void LexicalAnalyzer::RegisterBitwiseOperators(DFA& dfa)
 {
-	RegisterBitwiseAndOperator();
-	RegisterBitwiseOrOperator();
-	RegisterBitwiseNotOperator();
-	RegisterBitwiseXorOperator();
-	RegisterBitwiseLeftShiftOperator();
-	RegisterBitwiseRightShiftOperator();
+	RegisterBitwiseAndOperator(dfa);
+	RegisterBitwiseOrOperator(dfa);
+	RegisterBitwiseNotOperator(dfa);
+	RegisterBitwiseXorOperator(dfa);
+	RegisterBitwiseLeftShiftOperator(dfa);
+	RegisterBitwiseRightShiftOperator(dfa);
 }
 
-void LexicalAnalyzer::RegisterBitwiseAndOperator()
+void LexicalAnalyzer::RegisterBitwiseAndOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, BITWISE_AND_OPERATOR_BODY, '&');
+	dfa.SetTransition(INITIAL_STATE, BITWISE_AND_OPERATOR_BODY, '&');
 	for (int i = 0; i < 256; ++i)
 	{
 		if (i == '&') continue;
-		m_dfa.SetTransition(BITWISE_AND_OPERATOR_BODY, BITWISE_AND_OPERATOR_END, i);
+		dfa.SetTransition(BITWISE_AND_OPERATOR_BODY, BITWISE_AND_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(BITWISE_AND_OPERATOR_END);
+	dfa.SetAcceptingState(BITWISE_AND_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterBitwiseOrOperator()
+void LexicalAnalyzer::RegisterBitwiseOrOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, BITWISE_OR_OPERATOR_BODY, '|');
+	dfa.SetTransition(INITIAL_STATE, BITWISE_OR_OPERATOR_BODY, '|');
 	for (int i = 0; i < 256; ++i)
 	{
 		if (i == '|') continue;
-		m_dfa.SetTransition(BITWISE_OR_OPERATOR_BODY, BITWISE_OR_OPERATOR_END, i);
+		dfa.SetTransition(BITWISE_OR_OPERATOR_BODY, BITWISE_OR_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(BITWISE_OR_OPERATOR_END);
+	dfa.SetAcceptingState(BITWISE_OR_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterBitwiseNotOperator()
+void LexicalAnalyzer::RegisterBitwiseNotOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, BITWISE_NOT_OPERATOR_BODY, '~');
+	dfa.SetTransition(INITIAL_STATE, BITWISE_NOT_OPERATOR_BODY, '~');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(BITWISE_NOT_OPERATOR_BODY, BITWISE_NOT_OPERATOR_END, i);
+		dfa.SetTransition(BITWISE_NOT_OPERATOR_BODY, BITWISE_NOT_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(BITWISE_NOT_OPERATOR_END);
+	dfa.SetAcceptingState(BITWISE_NOT_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterBitwiseXorOperator()
+void LexicalAnalyzer::RegisterBitwiseXorOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, BITWISE_XOR_OPERATOR_BODY, '^');
+	dfa.SetTransition(INITIAL_STATE, BITWISE_XOR_OPERATOR_BODY, '^');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(BITWISE_XOR_OPERATOR_BODY, BITWISE_XOR_OPERATOR_END, i);
+		dfa.SetTransition(BITWISE_XOR_OPERATOR_BODY, BITWISE_XOR_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(BITWISE_XOR_OPERATOR_END);
+	dfa.SetAcceptingState(BITWISE_XOR_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterBitwiseLeftShiftOperator()
+void LexicalAnalyzer::RegisterBitwiseLeftShiftOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, LESS_THAN_OPERATOR_BODY, '<');
-	m_dfa.SetTransition(LESS_THAN_OPERATOR_BODY, BITWISE_LEFT_SHIFT_OPERATOR_BODY, '<');
+	dfa.SetTransition(INITIAL_STATE, LESS_THAN_OPERATOR_BODY, '<');
+	dfa.SetTransition(LESS_THAN_OPERATOR_BODY, BITWISE_LEFT_SHIFT_OPERATOR_BODY, '<');
 	for (int i = 0; i < 256; ++i)
 	{
 		if (i == '=') continue;
-		m_dfa.SetTransition(BITWISE_LEFT_SHIFT_OPERATOR_BODY, BITWISE_LEFT_SHIFT_OPERATOR_END, i);
+		dfa.SetTransition(BITWISE_LEFT_SHIFT_OPERATOR_BODY, BITWISE_LEFT_SHIFT_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(BITWISE_LEFT_SHIFT_OPERATOR_END);
+	dfa.SetAcceptingState(BITWISE_LEFT_SHIFT_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterBitwiseRightShiftOperator()
+void LexicalAnalyzer::RegisterBitwiseRightShiftOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, GREATER_THAN_OPERATOR_BODY, '>');
-	m_dfa.SetTransition(GREATER_THAN_OPERATOR_BODY, BITWISE_RIGHT_SHIFT_OPERATOR_BODY, '>');
+	dfa.SetTransition(INITIAL_STATE, GREATER_THAN_OPERATOR_BODY, '>');
+	dfa.SetTransition(GREATER_THAN_OPERATOR_BODY, BITWISE_RIGHT_SHIFT_OPERATOR_BODY, '>');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(BITWISE_RIGHT_SHIFT_OPERATOR_BODY, BITWISE_RIGHT_SHIFT_OPERATOR_END, i);
+		dfa.SetTransition(BITWISE_RIGHT_SHIFT_OPERATOR_BODY, BITWISE_RIGHT_SHIFT_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(BITWISE_RIGHT_SHIFT_OPERATOR_END);
+	dfa.SetAcceptingState(BITWISE_RIGHT_SHIFT_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterLogicalOperators()
+void LexicalAnalyzer::RegisterLogicalOperators(DFA& dfa)
 {
-	RegisterLogicalAndOperator();
-	RegisterLogicalOrOperator();
-	RegisterLogicalNotOperator();
+	RegisterLogicalAndOperator(dfa);
+	RegisterLogicalOrOperator(dfa);
+	RegisterLogicalNotOperator(dfa);
 }
 
-void LexicalAnalyzer::RegisterLogicalAndOperator()
+void LexicalAnalyzer::RegisterLogicalAndOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, BITWISE_AND_OPERATOR_BODY, '&');
-	m_dfa.SetTransition(BITWISE_AND_OPERATOR_BODY, LOGICAL_AND_OPERATOR_BODY, '&');
+	dfa.SetTransition(INITIAL_STATE, BITWISE_AND_OPERATOR_BODY, '&');
+	dfa.SetTransition(BITWISE_AND_OPERATOR_BODY, LOGICAL_AND_OPERATOR_BODY, '&');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(LOGICAL_AND_OPERATOR_BODY, LOGICAL_AND_OPERATOR_END, i);
+		dfa.SetTransition(LOGICAL_AND_OPERATOR_BODY, LOGICAL_AND_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(LOGICAL_AND_OPERATOR_END);
+	dfa.SetAcceptingState(LOGICAL_AND_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterLogicalOrOperator()
+void LexicalAnalyzer::RegisterLogicalOrOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, BITWISE_OR_OPERATOR_BODY, '|');
-	m_dfa.SetTransition(BITWISE_OR_OPERATOR_BODY, LOGICAL_OR_OPERATOR_BODY, '|');
+	dfa.SetTransition(INITIAL_STATE, BITWISE_OR_OPERATOR_BODY, '|');
+	dfa.SetTransition(BITWISE_OR_OPERATOR_BODY, LOGICAL_OR_OPERATOR_BODY, '|');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(LOGICAL_OR_OPERATOR_BODY, LOGICAL_OR_OPERATOR_END, i);
+		dfa.SetTransition(LOGICAL_OR_OPERATOR_BODY, LOGICAL_OR_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(LOGICAL_OR_OPERATOR_END);
+	dfa.SetAcceptingState(LOGICAL_OR_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterLogicalNotOperator()
+void LexicalAnalyzer::RegisterLogicalNotOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, LOGICAL_NOT_OPERATOR_BODY, '!');
+	dfa.SetTransition(INITIAL_STATE, LOGICAL_NOT_OPERATOR_BODY, '!');
 	for (int i = 0; i < 256; ++i)
 	{
 		if (i == '=') continue;
-		m_dfa.SetTransition(LOGICAL_NOT_OPERATOR_BODY, LOGICAL_NOT_OPERATOR_END, i);
+		dfa.SetTransition(LOGICAL_NOT_OPERATOR_BODY, LOGICAL_NOT_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(LOGICAL_NOT_OPERATOR_END);
+	dfa.SetAcceptingState(LOGICAL_NOT_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterCompoundAssignmentOperators()
+void LexicalAnalyzer::RegisterCompoundAssignmentOperators(DFA& dfa)
 {
-	RegisterAdditionAssignmentOperator();
-	RegisterSubtractionAssignmentOperator();
-	RegisterDivisionAssignmentOperator();
-	RegisterMultiplicationAssignmentOperator();
-	RegisterModuloAssignmentOperator();
-	RegisterBitwiseAndAssignmentOperator();
-	RegisterBitwiseOrAssignmentOperator();
-	RegisterBitwiseXorAssignmentOperator();
-	RegisterBitwiseLeftShiftAssignmentOperator();
-	RegisterBitwiseRightShiftAssignmentOperator();
+	RegisterAdditionAssignmentOperator(dfa);
+	RegisterSubtractionAssignmentOperator(dfa);
+	RegisterDivisionAssignmentOperator(dfa);
+	RegisterMultiplicationAssignmentOperator(dfa);
+	RegisterModuloAssignmentOperator(dfa);
+	RegisterBitwiseAndAssignmentOperator(dfa);
+	RegisterBitwiseOrAssignmentOperator(dfa);
+	RegisterBitwiseXorAssignmentOperator(dfa);
+	RegisterBitwiseLeftShiftAssignmentOperator(dfa);
+	RegisterBitwiseRightShiftAssignmentOperator(dfa);
 }
 
-void LexicalAnalyzer::RegisterModuloAssignmentOperator()
+void LexicalAnalyzer::RegisterModuloAssignmentOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, MODULO_OPERATOR_BODY, '%');
-	m_dfa.SetTransition(MODULO_OPERATOR_BODY, MODULO_ASSIGNMENT_OPERATOR_BODY, '=');
+	dfa.SetTransition(INITIAL_STATE, MODULO_OPERATOR_BODY, '%');
+	dfa.SetTransition(MODULO_OPERATOR_BODY, MODULO_ASSIGNMENT_OPERATOR_BODY, '=');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(MODULO_ASSIGNMENT_OPERATOR_BODY, MODULO_ASSIGNMENT_OPERATOR_END, i);
+		dfa.SetTransition(MODULO_ASSIGNMENT_OPERATOR_BODY, MODULO_ASSIGNMENT_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(MODULO_ASSIGNMENT_OPERATOR_END);
+	dfa.SetAcceptingState(MODULO_ASSIGNMENT_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterBitwiseAndAssignmentOperator()
+void LexicalAnalyzer::RegisterBitwiseAndAssignmentOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, BITWISE_AND_OPERATOR_BODY, '&');
-	m_dfa.SetTransition(BITWISE_AND_OPERATOR_BODY, BITWISE_AND_ASSIGNMENT_OPERATOR_BODY, '=');
+	dfa.SetTransition(INITIAL_STATE, BITWISE_AND_OPERATOR_BODY, '&');
+	dfa.SetTransition(BITWISE_AND_OPERATOR_BODY, BITWISE_AND_ASSIGNMENT_OPERATOR_BODY, '=');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(BITWISE_AND_ASSIGNMENT_OPERATOR_BODY, BITWISE_AND_ASSIGNMENT_OPERATOR_END, i);
+		dfa.SetTransition(BITWISE_AND_ASSIGNMENT_OPERATOR_BODY, BITWISE_AND_ASSIGNMENT_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(BITWISE_AND_ASSIGNMENT_OPERATOR_END);
+	dfa.SetAcceptingState(BITWISE_AND_ASSIGNMENT_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterBitwiseOrAssignmentOperator()
+void LexicalAnalyzer::RegisterBitwiseOrAssignmentOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, BITWISE_OR_OPERATOR_BODY, '|');
-	m_dfa.SetTransition(BITWISE_OR_OPERATOR_BODY, BITWISE_OR_ASSIGNMENT_OPERATOR_BODY, '=');
+	dfa.SetTransition(INITIAL_STATE, BITWISE_OR_OPERATOR_BODY, '|');
+	dfa.SetTransition(BITWISE_OR_OPERATOR_BODY, BITWISE_OR_ASSIGNMENT_OPERATOR_BODY, '=');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(BITWISE_OR_ASSIGNMENT_OPERATOR_BODY, BITWISE_OR_ASSIGNMENT_OPERATOR_END, i);
+		dfa.SetTransition(BITWISE_OR_ASSIGNMENT_OPERATOR_BODY, BITWISE_OR_ASSIGNMENT_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(BITWISE_OR_ASSIGNMENT_OPERATOR_END);
+	dfa.SetAcceptingState(BITWISE_OR_ASSIGNMENT_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterBitwiseXorAssignmentOperator()
+void LexicalAnalyzer::RegisterBitwiseXorAssignmentOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, BITWISE_XOR_OPERATOR_BODY, '^');
-	m_dfa.SetTransition(BITWISE_XOR_OPERATOR_BODY, BITWISE_XOR_ASSIGNMENT_OPERATOR_BODY, '=');
+	dfa.SetTransition(INITIAL_STATE, BITWISE_XOR_OPERATOR_BODY, '^');
+	dfa.SetTransition(BITWISE_XOR_OPERATOR_BODY, BITWISE_XOR_ASSIGNMENT_OPERATOR_BODY, '=');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(BITWISE_XOR_ASSIGNMENT_OPERATOR_BODY, BITWISE_XOR_ASSIGNMENT_OPERATOR_END, i);
+		dfa.SetTransition(BITWISE_XOR_ASSIGNMENT_OPERATOR_BODY, BITWISE_XOR_ASSIGNMENT_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(BITWISE_XOR_ASSIGNMENT_OPERATOR_END);
+	dfa.SetAcceptingState(BITWISE_XOR_ASSIGNMENT_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterBitwiseLeftShiftAssignmentOperator()
+void LexicalAnalyzer::RegisterBitwiseLeftShiftAssignmentOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, LESS_THAN_OPERATOR_BODY, '<');
-	m_dfa.SetTransition(LESS_THAN_OPERATOR_BODY, BITWISE_LEFT_SHIFT_OPERATOR_BODY, '<');
-	m_dfa.SetTransition(BITWISE_LEFT_SHIFT_OPERATOR_BODY, BITWISE_LEFT_SHIFT_ASSIGNMENT_OPERATOR_BODY, '=');
+	dfa.SetTransition(INITIAL_STATE, LESS_THAN_OPERATOR_BODY, '<');
+	dfa.SetTransition(LESS_THAN_OPERATOR_BODY, BITWISE_LEFT_SHIFT_OPERATOR_BODY, '<');
+	dfa.SetTransition(BITWISE_LEFT_SHIFT_OPERATOR_BODY, BITWISE_LEFT_SHIFT_ASSIGNMENT_OPERATOR_BODY, '=');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(BITWISE_LEFT_SHIFT_ASSIGNMENT_OPERATOR_BODY, BITWISE_LEFT_SHIFT_ASSIGNMENT_OPERATOR_END, i);
+		dfa.SetTransition(BITWISE_LEFT_SHIFT_ASSIGNMENT_OPERATOR_BODY, BITWISE_LEFT_SHIFT_ASSIGNMENT_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(BITWISE_LEFT_SHIFT_ASSIGNMENT_OPERATOR_END);
+	dfa.SetAcceptingState(BITWISE_LEFT_SHIFT_ASSIGNMENT_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterBitwiseRightShiftAssignmentOperator()
+void LexicalAnalyzer::RegisterBitwiseRightShiftAssignmentOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, GREATER_THAN_OPERATOR_BODY, '>');
-	m_dfa.SetTransition(GREATER_THAN_OPERATOR_BODY, BITWISE_RIGHT_SHIFT_OPERATOR_BODY, '>');
-	m_dfa.SetTransition(BITWISE_RIGHT_SHIFT_OPERATOR_BODY, BITWISE_RIGHT_SHIFT_ASSIGNMENT_OPERATOR_BODY, '=');
+	dfa.SetTransition(INITIAL_STATE, GREATER_THAN_OPERATOR_BODY, '>');
+	dfa.SetTransition(GREATER_THAN_OPERATOR_BODY, BITWISE_RIGHT_SHIFT_OPERATOR_BODY, '>');
+	dfa.SetTransition(BITWISE_RIGHT_SHIFT_OPERATOR_BODY, BITWISE_RIGHT_SHIFT_ASSIGNMENT_OPERATOR_BODY, '=');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(BITWISE_RIGHT_SHIFT_ASSIGNMENT_OPERATOR_BODY, BITWISE_RIGHT_SHIFT_ASSIGNMENT_OPERATOR_END, i);
+		dfa.SetTransition(BITWISE_RIGHT_SHIFT_ASSIGNMENT_OPERATOR_BODY, BITWISE_RIGHT_SHIFT_ASSIGNMENT_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(BITWISE_RIGHT_SHIFT_ASSIGNMENT_OPERATOR_END);
+	dfa.SetAcceptingState(BITWISE_RIGHT_SHIFT_ASSIGNMENT_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterAdditionAssignmentOperator()
+void LexicalAnalyzer::RegisterAdditionAssignmentOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, ADDITION_OPERATOR_BODY, '+');
-	m_dfa.SetTransition(ADDITION_OPERATOR_BODY, ADDITION_ASSIGNMENT_OPERATOR_BODY, '=');
+	dfa.SetTransition(INITIAL_STATE, ADDITION_OPERATOR_BODY, '+');
+	dfa.SetTransition(ADDITION_OPERATOR_BODY, ADDITION_ASSIGNMENT_OPERATOR_BODY, '=');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(ADDITION_ASSIGNMENT_OPERATOR_BODY, ADDITION_ASSIGNMENT_OPERATOR_END, i);
+		dfa.SetTransition(ADDITION_ASSIGNMENT_OPERATOR_BODY, ADDITION_ASSIGNMENT_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(ADDITION_ASSIGNMENT_OPERATOR_END);
+	dfa.SetAcceptingState(ADDITION_ASSIGNMENT_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterSubtractionAndDecrementOperators()
+void LexicalAnalyzer::RegisterSubtractionAndDecrementOperators(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, SUBTRACTION_OPERATOR_BODY, '-');
-	m_dfa.SetTransition(SUBTRACTION_OPERATOR_BODY, DECREMENT_OPERATOR_BODY, '-');
+	dfa.SetTransition(INITIAL_STATE, SUBTRACTION_OPERATOR_BODY, '-');
+	dfa.SetTransition(SUBTRACTION_OPERATOR_BODY, DECREMENT_OPERATOR_BODY, '-');
 	for (int i = 0; i < 256; ++i)
 	{
 		if (i == '-') continue;
-		m_dfa.SetTransition(SUBTRACTION_OPERATOR_BODY, SUBTRACTION_OPERATOR_END, i);
-		m_dfa.SetTransition(DECREMENT_OPERATOR_BODY, DECREMENT_OPERATOR_END, i);
+		dfa.SetTransition(SUBTRACTION_OPERATOR_BODY, SUBTRACTION_OPERATOR_END, i);
+		dfa.SetTransition(DECREMENT_OPERATOR_BODY, DECREMENT_OPERATOR_END, i);
 	}
-	m_dfa.SetAcceptingState(SUBTRACTION_OPERATOR_END);
-	m_dfa.SetAcceptingState(DECREMENT_OPERATOR_END);
+	dfa.SetAcceptingState(SUBTRACTION_OPERATOR_END);
+	dfa.SetAcceptingState(DECREMENT_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterSubtractionAssignmentOperator()
+void LexicalAnalyzer::RegisterSubtractionAssignmentOperator(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, SUBTRACTION_OPERATOR_BODY, '-');
-	m_dfa.SetTransition(SUBTRACTION_OPERATOR_BODY, SUBTRACTION_ASSIGNMENT_OPERATOR_BODY, '=');
+	dfa.SetTransition(INITIAL_STATE, SUBTRACTION_OPERATOR_BODY, '-');
+	dfa.SetTransition(SUBTRACTION_OPERATOR_BODY, SUBTRACTION_ASSIGNMENT_OPERATOR_BODY, '=');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(SUBTRACTION_ASSIGNMENT_OPERATOR_BODY, SUBTRACTION_ASSIGNMENT_OPERATOR_END, i);
+		dfa.SetTransition(SUBTRACTION_ASSIGNMENT_OPERATOR_BODY, SUBTRACTION_ASSIGNMENT_OPERATOR_END, i);
 	}
 
-	m_dfa.SetAcceptingState(SUBTRACTION_ASSIGNMENT_OPERATOR_END);
+	dfa.SetAcceptingState(SUBTRACTION_ASSIGNMENT_OPERATOR_END);
 }
 
-void LexicalAnalyzer::RegisterLineComment()
+void LexicalAnalyzer::RegisterLineComment(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, COMMENT_OR_DIVISION_OPERATOR, '/');
-	m_dfa.SetTransition(COMMENT_OR_DIVISION_OPERATOR, LINE_COMMENT_BODY, '/');
-	for (int i = 1; i < 255; ++i)
+	dfa.SetTransition(INITIAL_STATE, COMMENT_OR_DIVISION_OPERATOR, '/');
+	dfa.SetTransition(COMMENT_OR_DIVISION_OPERATOR, LINE_COMMENT_BODY, '/');
+	for (int i = 1; i < 256; ++i)
 	{
-		m_dfa.SetTransition(LINE_COMMENT_BODY, LINE_COMMENT_BODY, i);
+		dfa.SetTransition(LINE_COMMENT_BODY, LINE_COMMENT_BODY, i);
 	}
-	m_dfa.SetTransition(LINE_COMMENT_BODY, LINE_COMMENT_END, '\n');
-	m_dfa.SetTransition(LINE_COMMENT_BODY, LINE_COMMENT_END, '\0');
+	dfa.SetTransition(LINE_COMMENT_BODY, LINE_COMMENT_END, '\n');
+	dfa.SetTransition(LINE_COMMENT_BODY, LINE_COMMENT_END, '\0');
 
-	m_dfa.SetAcceptingState(LINE_COMMENT_END);
+	dfa.SetAcceptingState(LINE_COMMENT_END);
 }
 
-void LexicalAnalyzer::RegisterBlockComment()
+void LexicalAnalyzer::RegisterBlockComment(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, COMMENT_OR_DIVISION_OPERATOR, '/');
+	dfa.SetTransition(INITIAL_STATE, COMMENT_OR_DIVISION_OPERATOR, '/');
 
-	m_dfa.SetTransition(COMMENT_OR_DIVISION_OPERATOR, BLOCK_COMMENT_BODY, '*');
-	for (int i = 1; i < 255; ++i)
+	dfa.SetTransition(COMMENT_OR_DIVISION_OPERATOR, BLOCK_COMMENT_BODY, '*');
+	for (int i = 1; i < 256; ++i)
 	{
-		m_dfa.SetTransition(BLOCK_COMMENT_BODY, BLOCK_COMMENT_BODY, i);
+		dfa.SetTransition(BLOCK_COMMENT_BODY, BLOCK_COMMENT_BODY, i);
 	}
-	m_dfa.SetTransition(BLOCK_COMMENT_BODY, BLOCK_COMMENT_POSSIBLE_END, '*');
-	for (int i = 1; i < 255; ++i)
+	dfa.SetTransition(BLOCK_COMMENT_BODY, BLOCK_COMMENT_POSSIBLE_END, '*');
+	for (int i = 1; i < 256; ++i)
 	{
-		m_dfa.SetTransition(BLOCK_COMMENT_POSSIBLE_END, BLOCK_COMMENT_BODY, i);
+		dfa.SetTransition(BLOCK_COMMENT_POSSIBLE_END, BLOCK_COMMENT_BODY, i);
 	}
-	m_dfa.SetTransition(BLOCK_COMMENT_POSSIBLE_END, BLOCK_COMMENT_POSSIBLE_END, '*');
-	m_dfa.SetTransition(BLOCK_COMMENT_POSSIBLE_END, BLOCK_COMMENT_NEAR_END, '/');
+	dfa.SetTransition(BLOCK_COMMENT_POSSIBLE_END, BLOCK_COMMENT_POSSIBLE_END, '*');
+	dfa.SetTransition(BLOCK_COMMENT_POSSIBLE_END, BLOCK_COMMENT_NEAR_END, '/');
 
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(BLOCK_COMMENT_NEAR_END, BLOCK_COMMENT_END, i);
+		dfa.SetTransition(BLOCK_COMMENT_NEAR_END, BLOCK_COMMENT_END, i);
 	}
 
-	m_dfa.SetAcceptingState(BLOCK_COMMENT_END);
+	dfa.SetAcceptingState(BLOCK_COMMENT_END);
 }
 
-void LexicalAnalyzer::RegisterIdentifier()
+void LexicalAnalyzer::RegisterIdentifier(DFA& dfa)
 {
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(IDENTIFIER_BODY, IDENTIFIER_END, i);
+		dfa.SetTransition(IDENTIFIER_BODY, IDENTIFIER_END, i);
 	}
 
-	m_dfa.SetTransition(INITIAL_STATE, IDENTIFIER_BODY, '_');
-	m_dfa.SetTransition(IDENTIFIER_BODY, IDENTIFIER_BODY, '_');
+	dfa.SetTransition(INITIAL_STATE, IDENTIFIER_BODY, '_');
+	dfa.SetTransition(IDENTIFIER_BODY, IDENTIFIER_BODY, '_');
 	for (int i = 'A'; i <= 'Z'; ++i)
 	{
-		m_dfa.SetTransition(INITIAL_STATE, IDENTIFIER_BODY, i);
-		m_dfa.SetTransition(INITIAL_STATE, IDENTIFIER_BODY, i + 'a' - 'A');
+		dfa.SetTransition(INITIAL_STATE, IDENTIFIER_BODY, i);
+		dfa.SetTransition(INITIAL_STATE, IDENTIFIER_BODY, i + 'a' - 'A');
 
-		m_dfa.SetTransition(IDENTIFIER_BODY, IDENTIFIER_BODY, i);
-		m_dfa.SetTransition(IDENTIFIER_BODY, IDENTIFIER_BODY, i + 'a' - 'A');
+		dfa.SetTransition(IDENTIFIER_BODY, IDENTIFIER_BODY, i);
+		dfa.SetTransition(IDENTIFIER_BODY, IDENTIFIER_BODY, i + 'a' - 'A');
 	}
 
 	for (int i = '0'; i <= '9'; ++i)
 	{
-		m_dfa.SetTransition(IDENTIFIER_BODY, IDENTIFIER_BODY, i);
+		dfa.SetTransition(IDENTIFIER_BODY, IDENTIFIER_BODY, i);
+	}
+
+	// Extended identifier characters written as UTF-8: a lead byte selects how
+	// many continuation bytes must follow before the identifier can go on.
+	for (int i = 0xC2; i <= 0xF4; ++i)
+	{
+		int tailState = i <= 0xDF ? IDENTIFIER_UTF8_TAIL_1 :
+			i <= 0xEF ? IDENTIFIER_UTF8_TAIL_2 : IDENTIFIER_UTF8_TAIL_3;
+		dfa.SetTransition(INITIAL_STATE, tailState, i);
+		dfa.SetTransition(IDENTIFIER_BODY, tailState, i);
+	}
+	for (int i = 0x80; i <= 0xBF; ++i)
+	{
+		dfa.SetTransition(IDENTIFIER_UTF8_TAIL_3, IDENTIFIER_UTF8_TAIL_2, i);
+		dfa.SetTransition(IDENTIFIER_UTF8_TAIL_2, IDENTIFIER_UTF8_TAIL_1, i);
+		dfa.SetTransition(IDENTIFIER_UTF8_TAIL_1, IDENTIFIER_BODY, i);
 	}
 
-	m_dfa.SetAcceptingState(IDENTIFIER_END);
+	dfa.SetAcceptingState(IDENTIFIER_END);
 }
 
-void LexicalAnalyzer::RegisterStringLiteral()
+void LexicalAnalyzer::RegisterStringLiteral(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, STRING_LITERAL_BODY, '"');
+	// Passing through STRING_LITERAL_BACKSLASH switches to the escaped states,
+	// so the end state tells whether the literal needs decoding.
+	dfa.SetTransition(INITIAL_STATE, STRING_LITERAL_BODY, '"');
 	for (int i = 0; i < 256; ++i)
 	{
 		if (i == '\n' || i == '\0') continue;
-		m_dfa.SetTransition(STRING_LITERAL_BODY, STRING_LITERAL_BODY, i);
+		dfa.SetTransition(STRING_LITERAL_BODY, STRING_LITERAL_BODY, i);
+		dfa.SetTransition(STRING_LITERAL_ESCAPED_BODY, STRING_LITERAL_ESCAPED_BODY, i);
 	}
-	m_dfa.SetTransition(STRING_LITERAL_BODY, STRING_LITERAL_BACKSLASH, '\\');
+	dfa.SetTransition(STRING_LITERAL_BODY, STRING_LITERAL_BACKSLASH, '\\');
+	dfa.SetTransition(STRING_LITERAL_ESCAPED_BODY, STRING_LITERAL_BACKSLASH, '\\');
 	for (int i = 0; i < 256; ++i)
 	{
 		if (i == '\0') continue;
-		m_dfa.SetTransition(STRING_LITERAL_BACKSLASH, STRING_LITERAL_BODY, i);
+		dfa.SetTransition(STRING_LITERAL_BACKSLASH, STRING_LITERAL_ESCAPED_BODY, i);
 	}
-	m_dfa.SetTransition(STRING_LITERAL_BACKSLASH, STRING_LITERAL_BACKSLASH, '\r');
-	m_dfa.SetTransition(STRING_LITERAL_BODY, STRING_LITERAL_CLOSE, '"');
+	dfa.SetTransition(STRING_LITERAL_BACKSLASH, STRING_LITERAL_BACKSLASH, '\r');
+	dfa.SetTransition(STRING_LITERAL_BODY, STRING_LITERAL_CLOSE, '"');
+	dfa.SetTransition(STRING_LITERAL_ESCAPED_BODY, STRING_LITERAL_ESCAPED_CLOSE, '"');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(STRING_LITERAL_CLOSE, STRING_LITERAL_END, i);
+		dfa.SetTransition(STRING_LITERAL_CLOSE, STRING_LITERAL_END, i);
+		dfa.SetTransition(STRING_LITERAL_ESCAPED_CLOSE, STRING_LITERAL_ESCAPED_END, i);
 	}
 
-	m_dfa.SetAcceptingState(STRING_LITERAL_END);
+	dfa.SetAcceptingState(STRING_LITERAL_END);
+	dfa.SetAcceptingState(STRING_LITERAL_ESCAPED_END);
 }
 
-void LexicalAnalyzer::RegisterCharLiteral()
+void LexicalAnalyzer::RegisterCharLiteral(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, CHAR_LITERAL_BEGIN, '\'');
-	for (int i = 'A'; i <= 'Z'; ++i)
+	dfa.SetTransition(INITIAL_STATE, CHAR_LITERAL_BEGIN, '\'');
+	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(CHAR_LITERAL_BEGIN, CHAR_LITERAL_BODY, i);
-		m_dfa.SetTransition(CHAR_LITERAL_BEGIN, CHAR_LITERAL_BODY, i + 'a' - 'A');
+		if (i == '\n' || i == '\0' || i == '\'' || i == '\\') continue;
+		dfa.SetTransition(CHAR_LITERAL_BEGIN, CHAR_LITERAL_BODY, i);
+		dfa.SetTransition(CHAR_LITERAL_BODY, CHAR_LITERAL_BODY, i);
+		dfa.SetTransition(CHAR_LITERAL_ESCAPED_BODY, CHAR_LITERAL_ESCAPED_BODY, i);
 	}
-	for (int i = '0'; i <= '9'; ++i)
+
+	dfa.SetTransition(CHAR_LITERAL_BEGIN, CHAR_LITERAL_BACKSLASH, '\\');
+	dfa.SetTransition(CHAR_LITERAL_BODY, CHAR_LITERAL_BACKSLASH, '\\');
+	dfa.SetTransition(CHAR_LITERAL_ESCAPED_BODY, CHAR_LITERAL_BACKSLASH, '\\');
+	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(CHAR_LITERAL_BEGIN, CHAR_LITERAL_BODY, i);
+		if (i == '\0') continue;
+		dfa.SetTransition(CHAR_LITERAL_BACKSLASH, CHAR_LITERAL_ESCAPED_BODY, i);
 	}
-	m_dfa.SetTransition(CHAR_LITERAL_BEGIN, CHAR_LITERAL_BODY, ' ');
+	dfa.SetTransition(CHAR_LITERAL_BODY, CHAR_LITERAL_CLOSE, '\'');
+	dfa.SetTransition(CHAR_LITERAL_ESCAPED_BODY, CHAR_LITERAL_ESCAPED_CLOSE, '\'');
 
-	m_dfa.SetTransition(CHAR_LITERAL_BEGIN, CHAR_LITERAL_BACKSLASH, '\\');
-	for (int i = 'A'; i <= 'Z'; ++i)
+	for (int i = 0; i < 256; ++i)
+	{
+		dfa.SetTransition(CHAR_LITERAL_CLOSE, CHAR_LITERAL_END, i);
+		dfa.SetTransition(CHAR_LITERAL_ESCAPED_CLOSE, CHAR_LITERAL_ESCAPED_END, i);
+	}
+
+	dfa.SetAcceptingState(CHAR_LITERAL_END);
+	dfa.SetAcceptingState(CHAR_LITERAL_ESCAPED_END);
+}
+
+void LexicalAnalyzer::RegisterIntegerLiteral(DFA& dfa)
+{
+	static const int integerStates[] = { NUMBER_LITERAL, ZERO_LITERAL, OCTAL_LITERAL, HEXADECIMAL_LITERAL,
+		BINARY_LITERAL, INTEGER_SUFFIX_U, INTEGER_SUFFIX_U_LOWER_L, INTEGER_SUFFIX_U_UPPER_L,
+		INTEGER_SUFFIX_LOWER_L, INTEGER_SUFFIX_UPPER_L, INTEGER_SUFFIX_LL, INTEGER_SUFFIX_COMPLETE };
+	static const int bodyStates[] = { NUMBER_LITERAL, ZERO_LITERAL, OCTAL_LITERAL, HEXADECIMAL_LITERAL, BINARY_LITERAL };
+
+	for (std::size_t state = 0; state < sizeof(integerStates) / sizeof(integerStates[0]); ++state)
 	{
-		m_dfa.SetTransition(CHAR_LITERAL_BACKSLASH, CHAR_LITERAL_BODY, i);
-		m_dfa.SetTransition(CHAR_LITERAL_BACKSLASH, CHAR_LITERAL_BODY, i + 'a' - 'A');
+		for (int i = 0; i < 256; ++i)
+		{
+			dfa.SetTransition(integerStates[state], INTEGER_LITERAL_END, i);
+		}
 	}
+
+	dfa.SetTransition(INITIAL_STATE, ZERO_LITERAL, '0');
 	for (int i = '0'; i <= '9'; ++i)
 	{
-		m_dfa.SetTransition(CHAR_LITERAL_BACKSLASH, CHAR_LITERAL_BODY, i);
+		if (i != '0')
+		{
+			dfa.SetTransition(INITIAL_STATE, NUMBER_LITERAL, i);
+		}
+		dfa.SetTransition(NUMBER_LITERAL, NUMBER_LITERAL, i);
+	}
+	for (int i = '0'; i <= '7'; ++i)
+	{
+		dfa.SetTransition(ZERO_LITERAL, OCTAL_LITERAL, i);
+		dfa.SetTransition(OCTAL_LITERAL, OCTAL_LITERAL, i);
 	}
-	m_dfa.SetTransition(CHAR_LITERAL_BACKSLASH, CHAR_LITERAL_BODY, '\'');
-	m_dfa.SetTransition(CHAR_LITERAL_BODY, CHAR_LITERAL_CLOSE, '\'');
 
+	dfa.SetTransition(ZERO_LITERAL, HEXADECIMAL_PREFIX, 'x');
+	dfa.SetTransition(ZERO_LITERAL, HEXADECIMAL_PREFIX, 'X');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(CHAR_LITERAL_CLOSE, CHAR_LITERAL_END, i);
+		if (std::isxdigit(i))
+		{
+			dfa.SetTransition(HEXADECIMAL_PREFIX, HEXADECIMAL_LITERAL, i);
+			dfa.SetTransition(HEXADECIMAL_LITERAL, HEXADECIMAL_LITERAL, i);
+		}
+	}
+
+	dfa.SetTransition(ZERO_LITERAL, BINARY_PREFIX, 'b');
+	dfa.SetTransition(ZERO_LITERAL, BINARY_PREFIX, 'B');
+	for (int i = '0'; i <= '1'; ++i)
+	{
+		dfa.SetTransition(BINARY_PREFIX, BINARY_LITERAL, i);
+		dfa.SetTransition(BINARY_LITERAL, BINARY_LITERAL, i);
 	}
 
-	m_dfa.SetAcceptingState(CHAR_LITERAL_END);
+	for (std::size_t state = 0; state < sizeof(bodyStates) / sizeof(bodyStates[0]); ++state)
+	{
+		dfa.SetTransition(bodyStates[state], INTEGER_SUFFIX_U, 'u');
+		dfa.SetTransition(bodyStates[state], INTEGER_SUFFIX_U, 'U');
+		dfa.SetTransition(bodyStates[state], INTEGER_SUFFIX_LOWER_L, 'l');
+		dfa.SetTransition(bodyStates[state], INTEGER_SUFFIX_UPPER_L, 'L');
+	}
+	dfa.SetTransition(INTEGER_SUFFIX_U, INTEGER_SUFFIX_U_LOWER_L, 'l');
+	dfa.SetTransition(INTEGER_SUFFIX_U, INTEGER_SUFFIX_U_UPPER_L, 'L');
+	dfa.SetTransition(INTEGER_SUFFIX_U_LOWER_L, INTEGER_SUFFIX_COMPLETE, 'l');
+	dfa.SetTransition(INTEGER_SUFFIX_U_UPPER_L, INTEGER_SUFFIX_COMPLETE, 'L');
+	dfa.SetTransition(INTEGER_SUFFIX_LOWER_L, INTEGER_SUFFIX_LL, 'l');
+	dfa.SetTransition(INTEGER_SUFFIX_UPPER_L, INTEGER_SUFFIX_LL, 'L');
+	dfa.SetTransition(INTEGER_SUFFIX_LOWER_L, INTEGER_SUFFIX_COMPLETE, 'u');
+	dfa.SetTransition(INTEGER_SUFFIX_LOWER_L, INTEGER_SUFFIX_COMPLETE, 'U');
+	dfa.SetTransition(INTEGER_SUFFIX_UPPER_L, INTEGER_SUFFIX_COMPLETE, 'u');
+	dfa.SetTransition(INTEGER_SUFFIX_UPPER_L, INTEGER_SUFFIX_COMPLETE, 'U');
+	dfa.SetTransition(INTEGER_SUFFIX_LL, INTEGER_SUFFIX_COMPLETE, 'u');
+	dfa.SetTransition(INTEGER_SUFFIX_LL, INTEGER_SUFFIX_COMPLETE, 'U');
+
+	dfa.SetAcceptingState(INTEGER_LITERAL_END);
 }
 
-void LexicalAnalyzer::RegisterIntegerLiteral()
+void LexicalAnalyzer::RegisterFloatingLiteral(DFA& dfa)
 {
+	static const int integerPartStates[] = { NUMBER_LITERAL, ZERO_LITERAL, OCTAL_LITERAL, FLOATING_LITERAL_INTEGER_PART };
+
+	for (int i = 0; i < 256; ++i)
+	{
+		dfa.SetTransition(FLOATING_LITERAL_FRACTIONAL_PART, FLOATING_LITERAL_END, i);
+		dfa.SetTransition(FLOATING_LITERAL_SCIENTIFIC_NOTATION_BODY, FLOATING_LITERAL_END, i);
+		dfa.SetTransition(FLOATING_LITERAL_SUFFIX, FLOATING_LITERAL_END, i);
+	}
+
 	for (int i = '0'; i <= '9'; ++i)
 	{
-		m_dfa.SetTransition(INITIAL_STATE, NUMBER_LITERAL, i);
-		m_dfa.SetTransition(NUMBER_LITERAL, NUMBER_LITERAL, i);
+		dfa.SetTransition(DELIMITER_DOT_BODY, FLOATING_LITERAL_FRACTIONAL_PART, i);
+		dfa.SetTransition(FLOATING_LITERAL_INTEGER_PART, FLOATING_LITERAL_INTEGER_PART, i);
+		dfa.SetTransition(FLOATING_LITERAL_FRACTIONAL_PART, FLOATING_LITERAL_FRACTIONAL_PART, i);
+		dfa.SetTransition(FLOATING_LITERAL_SCIENTIFIC_NOTATION_BEGIN, FLOATING_LITERAL_SCIENTIFIC_NOTATION_BODY, i);
+		dfa.SetTransition(FLOATING_LITERAL_SCIENTIFIC_NOTATION_SIGN, FLOATING_LITERAL_SCIENTIFIC_NOTATION_BODY, i);
+		dfa.SetTransition(FLOATING_LITERAL_SCIENTIFIC_NOTATION_BODY, FLOATING_LITERAL_SCIENTIFIC_NOTATION_BODY, i);
 	}
+	for (int i = '8'; i <= '9'; ++i)
+	{
+		dfa.SetTransition(ZERO_LITERAL, FLOATING_LITERAL_INTEGER_PART, i);
+		dfa.SetTransition(OCTAL_LITERAL, FLOATING_LITERAL_INTEGER_PART, i);
+	}
+	for (std::size_t state = 0; state < sizeof(integerPartStates) / sizeof(integerPartStates[0]); ++state)
+	{
+		dfa.SetTransition(integerPartStates[state], FLOATING_LITERAL_FRACTIONAL_PART, '.');
+		dfa.SetTransition(integerPartStates[state], FLOATING_LITERAL_SCIENTIFIC_NOTATION_BEGIN, 'e');
+		dfa.SetTransition(integerPartStates[state], FLOATING_LITERAL_SCIENTIFIC_NOTATION_BEGIN, 'E');
+	}
+	dfa.SetTransition(FLOATING_LITERAL_FRACTIONAL_PART, FLOATING_LITERAL_SCIENTIFIC_NOTATION_BEGIN, 'e');
+	dfa.SetTransition(FLOATING_LITERAL_FRACTIONAL_PART, FLOATING_LITERAL_SCIENTIFIC_NOTATION_BEGIN, 'E');
+	dfa.SetTransition(FLOATING_LITERAL_SCIENTIFIC_NOTATION_BEGIN, FLOATING_LITERAL_SCIENTIFIC_NOTATION_SIGN, '+');
+	dfa.SetTransition(FLOATING_LITERAL_SCIENTIFIC_NOTATION_BEGIN, FLOATING_LITERAL_SCIENTIFIC_NOTATION_SIGN, '-');
+
+	dfa.SetTransition(HEXADECIMAL_PREFIX, FLOATING_LITERAL_HEXADECIMAL_FRACTION_BEGIN, '.');
+	dfa.SetTransition(HEXADECIMAL_LITERAL, FLOATING_LITERAL_HEXADECIMAL_FRACTIONAL_PART, '.');
 	for (int i = 0; i < 256; ++i)
 	{
-		if (i < '0' || i > '9')
+		if (std::isxdigit(i))
 		{
-			m_dfa.SetTransition(NUMBER_LITERAL, INTEGER_LITERAL_END, i);
+			dfa.SetTransition(FLOATING_LITERAL_HEXADECIMAL_FRACTION_BEGIN, FLOATING_LITERAL_HEXADECIMAL_FRACTIONAL_PART, i);
+			dfa.SetTransition(FLOATING_LITERAL_HEXADECIMAL_FRACTIONAL_PART, FLOATING_LITERAL_HEXADECIMAL_FRACTIONAL_PART, i);
 		}
 	}
+	dfa.SetTransition(HEXADECIMAL_LITERAL, FLOATING_LITERAL_SCIENTIFIC_NOTATION_BEGIN, 'p');
+	dfa.SetTransition(HEXADECIMAL_LITERAL, FLOATING_LITERAL_SCIENTIFIC_NOTATION_BEGIN, 'P');
+	dfa.SetTransition(FLOATING_LITERAL_HEXADECIMAL_FRACTIONAL_PART, FLOATING_LITERAL_SCIENTIFIC_NOTATION_BEGIN, 'p');
+	dfa.SetTransition(FLOATING_LITERAL_HEXADECIMAL_FRACTIONAL_PART, FLOATING_LITERAL_SCIENTIFIC_NOTATION_BEGIN, 'P');
+
+	dfa.SetTransition(FLOATING_LITERAL_FRACTIONAL_PART, FLOATING_LITERAL_SUFFIX, 'f');
+	dfa.SetTransition(FLOATING_LITERAL_FRACTIONAL_PART, FLOATING_LITERAL_SUFFIX, 'F');
+	dfa.SetTransition(FLOATING_LITERAL_FRACTIONAL_PART, FLOATING_LITERAL_SUFFIX, 'l');
+	dfa.SetTransition(FLOATING_LITERAL_FRACTIONAL_PART, FLOATING_LITERAL_SUFFIX, 'L');
+	dfa.SetTransition(FLOATING_LITERAL_SCIENTIFIC_NOTATION_BODY, FLOATING_LITERAL_SUFFIX, 'f');
+	dfa.SetTransition(FLOATING_LITERAL_SCIENTIFIC_NOTATION_BODY, FLOATING_LITERAL_SUFFIX, 'F');
+	dfa.SetTransition(FLOATING_LITERAL_SCIENTIFIC_NOTATION_BODY, FLOATING_LITERAL_SUFFIX, 'l');
+	dfa.SetTransition(FLOATING_LITERAL_SCIENTIFIC_NOTATION_BODY, FLOATING_LITERAL_SUFFIX, 'L');
+
+	dfa.SetAcceptingState(FLOATING_LITERAL_END);
+}
+
+void LexicalAnalyzer::RegisterParentheses(DFA& dfa)
+{
+	dfa.SetTransition(INITIAL_STATE, LEFT_PARENTHESIS_BODY, '(');
+	dfa.SetTransition(INITIAL_STATE, RIGHT_PARENTHESIS_BODY, ')');
+	dfa.SetTransition(INITIAL_STATE, LEFT_BRACKET_BODY, '[');
+	dfa.SetTransition(INITIAL_STATE, RIGHT_BRACKET_BODY, ']');
+	dfa.SetTransition(INITIAL_STATE, LEFT_ACCOLADE_BODY, '{');
+	dfa.SetTransition(INITIAL_STATE, RIGHT_ACCOLADE_BODY, '}');
+	for (int i = 0; i < 256; ++i)
+	{
+		dfa.SetTransition(LEFT_PARENTHESIS_BODY, LEFT_PARENTHESIS_END, i);
+		dfa.SetTransition(RIGHT_PARENTHESIS_BODY, RIGHT_PARENTHESIS_END, i);
+		dfa.SetTransition(LEFT_BRACKET_BODY, LEFT_BRACKET_END, i);
+		dfa.SetTransition(RIGHT_BRACKET_BODY, RIGHT_BRACKET_END, i);
+		dfa.SetTransition(LEFT_ACCOLADE_BODY, LEFT_ACCOLADE_END, i);
+		dfa.SetTransition(RIGHT_ACCOLADE_BODY, RIGHT_ACCOLADE_END, i);
+	}
 
-	m_dfa.SetAcceptingState(INTEGER_LITERAL_END);
+	dfa.SetAcceptingState(LEFT_PARENTHESIS_END);
+	dfa.SetAcceptingState(RIGHT_PARENTHESIS_END);
+	dfa.SetAcceptingState(LEFT_BRACKET_END);
+	dfa.SetAcceptingState(RIGHT_BRACKET_END);
+	dfa.SetAcceptingState(LEFT_ACCOLADE_END);
+	dfa.SetAcceptingState(RIGHT_ACCOLADE_END);
 }
 
-void LexicalAnalyzer::RegisterFloatingLiteral()
+void LexicalAnalyzer::RegisterPreprocessorOperators(DFA& dfa)
 {
-	for (int i = '0'; i <= '9'; ++i)
+	dfa.SetTransition(INITIAL_STATE, STRINGIZING_OPERATOR_BODY, '#');
+	dfa.SetTransition(STRINGIZING_OPERATOR_BODY, TOKEN_PASTING_OPERATOR_BODY, '#');
+	for (int i = 0; i < 256; ++i)
+	{
+		dfa.SetTransition(TOKEN_PASTING_OPERATOR_BODY, TOKEN_PASTING_OPERATOR_END, i);
+		if (i == '#') continue;
+		dfa.SetTransition(STRINGIZING_OPERATOR_BODY, STRINGIZING_OPERATOR_END, i);
+	}
+
+	dfa.SetAcceptingState(STRINGIZING_OPERATOR_END);
+	dfa.SetAcceptingState(TOKEN_PASTING_OPERATOR_END);
+}
+
+void LexicalAnalyzer::RegisterDirective(DFA& dfa)
+{
+	dfa.SetTransition(LINE_START_STATE, DIRECTIVE_BEGIN, '#');
+	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(INITIAL_STATE, NUMBER_LITERAL, i);
-		m_dfa.SetTransition(NUMBER_LITERAL, NUMBER_LITERAL, i);
-		m_dfa.SetTransition(FLOATING_LITERAL_FRACTIONAL_PART, FLOATING_LITERAL_FRACTIONAL_PART, i);
+		dfa.SetTransition(DIRECTIVE_BEGIN, DIRECTIVE_END, i);
+		dfa.SetTransition(DIRECTIVE_NAME_BODY, DIRECTIVE_END, i);
 	}
-	m_dfa.SetTransition(NUMBER_LITERAL, FLOATING_LITERAL_FRACTIONAL_PART, '.');
+	dfa.SetTransition(DIRECTIVE_BEGIN, DIRECTIVE_BEGIN, ' ');
+	dfa.SetTransition(DIRECTIVE_BEGIN, DIRECTIVE_BEGIN, '\t');
+
+	// Comments between '#' and the name stand for whitespace, so they belong
+	// to the directive. A line comment ends it as a null directive.
+	dfa.SetTransition(DIRECTIVE_BEGIN, DIRECTIVE_COMMENT_BEGIN, '/');
 	for (int i = 0; i < 256; ++i)
 	{
-		if (i < '0' || i > '9')
-		{
-			m_dfa.SetTransition(FLOATING_LITERAL_FRACTIONAL_PART, FLOATING_LITERAL_END, i);
-			m_dfa.SetTransition(FLOATING_LITERAL_SCIENTIFIC_NOTATION_BODY, FLOATING_LITERAL_END, i);
-		}
+		dfa.SetTransition(DIRECTIVE_COMMENT_BEGIN, DIRECTIVE_END, i);
+	}
+	dfa.SetTransition(DIRECTIVE_COMMENT_BEGIN, DIRECTIVE_BLOCK_COMMENT_BODY, '*');
+	dfa.SetTransition(DIRECTIVE_COMMENT_BEGIN, DIRECTIVE_LINE_COMMENT_BODY, '/');
+	for (int i = 1; i < 256; ++i)
+	{
+		dfa.SetTransition(DIRECTIVE_BLOCK_COMMENT_BODY, DIRECTIVE_BLOCK_COMMENT_BODY, i);
+		dfa.SetTransition(DIRECTIVE_BLOCK_COMMENT_POSSIBLE_END, DIRECTIVE_BLOCK_COMMENT_BODY, i);
+		dfa.SetTransition(DIRECTIVE_LINE_COMMENT_BODY, DIRECTIVE_LINE_COMMENT_BODY, i);
+	}
+	dfa.SetTransition(DIRECTIVE_BLOCK_COMMENT_BODY, DIRECTIVE_BLOCK_COMMENT_POSSIBLE_END, '*');
+	dfa.SetTransition(DIRECTIVE_BLOCK_COMMENT_POSSIBLE_END, DIRECTIVE_BLOCK_COMMENT_POSSIBLE_END, '*');
+	dfa.SetTransition(DIRECTIVE_BLOCK_COMMENT_POSSIBLE_END, DIRECTIVE_BEGIN, '/');
+	dfa.SetTransition(DIRECTIVE_LINE_COMMENT_BODY, DIRECTIVE_END, '\n');
+	dfa.SetTransition(DIRECTIVE_LINE_COMMENT_BODY, DIRECTIVE_END, '\0');
+
+	dfa.SetTransition(DIRECTIVE_BEGIN, DIRECTIVE_NAME_BODY, '_');
+	dfa.SetTransition(DIRECTIVE_NAME_BODY, DIRECTIVE_NAME_BODY, '_');
+	for (int i = 'A'; i <= 'Z'; ++i)
+	{
+		dfa.SetTransition(DIRECTIVE_BEGIN, DIRECTIVE_NAME_BODY, i);
+		dfa.SetTransition(DIRECTIVE_BEGIN, DIRECTIVE_NAME_BODY, i + 'a' - 'A');
+
+		dfa.SetTransition(DIRECTIVE_NAME_BODY, DIRECTIVE_NAME_BODY, i);
+		dfa.SetTransition(DIRECTIVE_NAME_BODY, DIRECTIVE_NAME_BODY, i + 'a' - 'A');
 	}
-	m_dfa.SetTransition(NUMBER_LITERAL, FLOATING_LITERAL_SCIENTIFIC_NOTATION_BEGIN, 'e');
-	m_dfa.SetTransition(FLOATING_LITERAL_FRACTIONAL_PART, FLOATING_LITERAL_SCIENTIFIC_NOTATION_BEGIN, 'e');
-	m_dfa.SetTransition(FLOATING_LITERAL_SCIENTIFIC_NOTATION_BEGIN, FLOATING_LITERAL_SCIENTIFIC_NOTATION_BODY, '-');
 	for (int i = '0'; i <= '9'; ++i)
 	{
-		m_dfa.SetTransition(FLOATING_LITERAL_SCIENTIFIC_NOTATION_BEGIN, FLOATING_LITERAL_SCIENTIFIC_NOTATION_BODY, i);
-		m_dfa.SetTransition(FLOATING_LITERAL_SCIENTIFIC_NOTATION_BODY, FLOATING_LITERAL_SCIENTIFIC_NOTATION_BODY, i);
+		dfa.SetTransition(DIRECTIVE_NAME_BODY, DIRECTIVE_NAME_BODY, i);
 	}
 
-	m_dfa.SetAcceptingState(FLOATING_LITERAL_END);
+	dfa.SetAcceptingState(DIRECTIVE_END);
 }
 
-void LexicalAnalyzer::RegisterParentheses()
+void LexicalAnalyzer::RegisterHeaderName(DFA& dfa)
 {
-	m_dfa.SetTransition(INITIAL_STATE, LEFT_PARENTHESIS_BODY, '(');
-	m_dfa.SetTransition(INITIAL_STATE, RIGHT_PARENTHESIS_BODY, ')');
-	m_dfa.SetTransition(INITIAL_STATE, LEFT_BRACKET_BODY, '[');
-	m_dfa.SetTransition(INITIAL_STATE, RIGHT_BRACKET_BODY, ']');
-	m_dfa.SetTransition(INITIAL_STATE, LEFT_ACCOLADE_BODY, '{');
-	m_dfa.SetTransition(INITIAL_STATE, RIGHT_ACCOLADE_BODY, '}');
+	dfa.SetTransition(HEADER_NAME_INITIAL_STATE, HEADER_NAME_BODY, '<');
+	dfa.SetTransition(HEADER_NAME_INITIAL_STATE, QUOTED_HEADER_NAME_BODY, '"');
 	for (int i = 0; i < 256; ++i)
 	{
-		m_dfa.SetTransition(LEFT_PARENTHESIS_BODY, LEFT_PARENTHESIS_END, i);
-		m_dfa.SetTransition(RIGHT_PARENTHESIS_BODY, RIGHT_PARENTHESIS_END, i);
-		m_dfa.SetTransition(LEFT_BRACKET_BODY, LEFT_BRACKET_END, i);
-		m_dfa.SetTransition(RIGHT_BRACKET_BODY, RIGHT_BRACKET_END, i);
-		m_dfa.SetTransition(LEFT_ACCOLADE_BODY, LEFT_ACCOLADE_END, i);
-		m_dfa.SetTransition(RIGHT_ACCOLADE_BODY, RIGHT_ACCOLADE_END, i);
+		dfa.SetTransition(HEADER_NAME_CLOSE, HEADER_NAME_END, i);
+		if (i == '\n' || i == '\0') continue;
+		dfa.SetTransition(HEADER_NAME_BODY, HEADER_NAME_BODY, i);
+		dfa.SetTransition(QUOTED_HEADER_NAME_BODY, QUOTED_HEADER_NAME_BODY, i);
 	}
+	dfa.SetTransition(HEADER_NAME_BODY, HEADER_NAME_CLOSE, '>');
+	dfa.SetTransition(QUOTED_HEADER_NAME_BODY, HEADER_NAME_CLOSE, '"');
+
+	dfa.SetAcceptingState(HEADER_NAME_END);
+}
 
-	m_dfa.SetAcceptingState(LEFT_PARENTHESIS_END);
-	m_dfa.SetAcceptingState(RIGHT_PARENTHESIS_END);
-	m_dfa.SetAcceptingState(LEFT_BRACKET_END);
-	m_dfa.SetAcceptingState(RIGHT_BRACKET_END);
-	m_dfa.SetAcceptingState(LEFT_ACCOLADE_END);
-	m_dfa.SetAcceptingState(RIGHT_ACCOLADE_END);
+void LexicalAnalyzer::RegisterStartConditions(DFA& dfa)
+{
+	// At the start of a line and after an include directive, every symbol
+	// without a dedicated transition behaves as in the initial state.
+	for (int i = 0; i < 256; ++i)
+	{
+		int destinationState = dfa.GetTransition(INITIAL_STATE, i);
+		if (destinationState == -1) continue;
+		if (dfa.GetTransition(LINE_START_STATE, i) == -1)
+		{
+			dfa.SetTransition(LINE_START_STATE, destinationState, i);
+		}
+		if (dfa.GetTransition(HEADER_NAME_INITIAL_STATE, i) == -1)
+		{
+			dfa.SetTransition(HEADER_NAME_INITIAL_STATE, destinationState, i);
+		}
+	}
 }
 
 LexicalAnalyzer::Lexemes LexicalAnalyzer::GetLexemes()
@@ -773,13 +2938,13 @@ LexicalAnalyzer::Lexemes LexicalAnalyzer::GetLexemes()
 void LexicalAnalyzer::DisplayLexemes()
 {
 	for (
-		std::vector<Lexemes::iterator>::iterator it = m_lexemes.begin();
+		Tokens::iterator it = m_lexemes.begin();
 		it != m_lexemes.end();
 		++it
 		)
 	{
-		std::cout << StringForLexemeType((*it)->second.first) << ": " << (*it)->first <<
-				", " << (*it)->second.second << '\n';
+		std::cout << StringForLexemeType(it->lexeme->second.first) << ": " << it->lexeme->first <<
+				", " << it->lexeme->second.second << '\n';
 	}
 }
 
@@ -792,16 +2957,33 @@ void LexicalAnalyzer::DisplayLexemeDictionary()
 	}
 }
 
+void LexicalAnalyzer::DisplayErrors()
+{
+	for (
+		std::vector<LexicalError>::iterator it = m_errors.begin();
+		it != m_errors.end();
+		++it
+		)
+	{
+		std::size_t line;
+		std::size_t column;
+		GetSourcePosition(it->offset, line, column);
+		std::cout << "Lexical error at line " << line << ", column " << column <<
+				", length " << it->length << '\n';
+	}
+	std::cout << m_errors.size() << " lexical error(s)\n";
+}
+
 LexicalAnalyzer::LexemeType LexicalAnalyzer::GetLexemeTypeForState(int state, const std::string& lexeme)
 {
-	if (m_dfa.IsValidState(state))
+	if (m_dfa->IsValidState(state))
 	{
 		if (state == LINE_COMMENT_END) return LINE_COMMENT;
 		if (state == BLOCK_COMMENT_END) return BLOCK_COMMENT;
 		if (state == IDENTIFIER_END) return GetIdentifierType(lexeme);
 		if (state == DELIMITER_END) return DELIMITER;
-		if (state == STRING_LITERAL_END) return STRING_LITERAL;
-		if (state == CHAR_LITERAL_END) return CHAR_LITERAL;
+		if (state == STRING_LITERAL_END || state == STRING_LITERAL_ESCAPED_END) return STRING_LITERAL;
+		if (state == CHAR_LITERAL_END || state == CHAR_LITERAL_ESCAPED_END) return CHAR_LITERAL;
 		if (state == INTEGER_LITERAL_END) return INTEGER_LITERAL;
 		if (state == FLOATING_LITERAL_END) return FLOATING_LITERAL;
 		if (state == LEFT_PARENTHESIS_END) return LEFT_PARENTHESIS;
@@ -843,6 +3025,10 @@ LexicalAnalyzer::LexemeType LexicalAnalyzer::GetLexemeTypeForState(int state, co
 		if (state == BITWISE_XOR_OPERATOR_END) return BITWISE_XOR_OPERATOR;
 		if (state == BITWISE_LEFT_SHIFT_OPERATOR_END) return BITWISE_LEFT_SHIFT_OPERATOR;
 		if (state == BITWISE_RIGHT_SHIFT_OPERATOR_END) return BITWISE_RIGHT_SHIFT_OPERATOR;
+		if (state == DIRECTIVE_END) return DIRECTIVE;
+		if (state == HEADER_NAME_END) return HEADER_NAME;
+		if (state == STRINGIZING_OPERATOR_END) return STRINGIZING_OPERATOR;
+		if (state == TOKEN_PASTING_OPERATOR_END) return TOKEN_PASTING_OPERATOR;
 	}
 }
 
@@ -855,6 +3041,45 @@ LexicalAnalyzer::LexemeType LexicalAnalyzer::GetIdentifierType(const std::string
 	return IDENTIFIER;
 }
 
+bool LexicalAnalyzer::IsIncludeDirective(const std::string& lexeme)
+{
+	std::string name = GetDirectiveName(lexeme.data(), lexeme.length());
+	return name == "include" || name == "include_next" || name == "import";
+}
+
+// Skips the '#' and the whitespace and comments after it. A null directive
+// has an empty name.
+std::string LexicalAnalyzer::GetDirectiveName(const char* lexeme, std::size_t lexemeLength)
+{
+	std::size_t position = 1;
+	while (position < lexemeLength)
+	{
+		if (lexeme[position] == ' ' || lexeme[position] == '\t')
+		{
+			++position;
+		}
+		else if (lexeme[position] == '/' && position + 1 < lexemeLength && lexeme[position + 1] == '*')
+		{
+			std::string_view::size_type commentEnd =
+				std::string_view(lexeme, lexemeLength).find("*/", position + 2);
+			if (commentEnd == std::string_view::npos)
+			{
+				return std::string();
+			}
+			position = commentEnd + 2;
+		}
+		else if (lexeme[position] == '/' && position + 1 < lexemeLength && lexeme[position + 1] == '/')
+		{
+			return std::string();
+		}
+		else
+		{
+			break;
+		}
+	}
+	return std::string(lexeme + position, lexemeLength - position);
+}
+
 std::string LexicalAnalyzer::StringForLexemeType(int lexemeType)
 {
 	if (lexemeType == LINE_COMMENT) return "Line comment";
@@ -905,4 +3130,9 @@ std::string LexicalAnalyzer::StringForLexemeType(int lexemeType)
 	if (lexemeType == BITWISE_XOR_OPERATOR) return "Bitwise xor operator";
 	if (lexemeType == BITWISE_LEFT_SHIFT_OPERATOR) return "Bitwise left shift operator";
 	if (lexemeType == BITWISE_RIGHT_SHIFT_OPERATOR) return "Bitwise right shift operator";
+	if (lexemeType == DIRECTIVE) return "Directive";
+	if (lexemeType == HEADER_NAME) return "Header name";
+	if (lexemeType == STRINGIZING_OPERATOR) return "Stringizing operator";
+	if (lexemeType == TOKEN_PASTING_OPERATOR) return "Token pasting operator";
+	if (lexemeType == ERROR) return "Error";
 }
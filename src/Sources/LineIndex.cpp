@@ -0,0 +1,79 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/LineIndex.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+LineIndex::LineIndex()
+{
+}
+
+void LineIndex::Build(const char* text, std::size_t length)
+{
+	m_lineStarts.clear();
+	m_lineStarts.reserve(length / 32 + 1);
+	m_lineStarts.push_back(0);
+
+	std::size_t i = 0;
+#if defined(__SSE2__)
+	const __m128i newline = _mm_set1_epi8('\n');
+	for (; i + 16 <= length; i += 16)
+	{
+		__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+		unsigned int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, newline));
+		while (mask != 0)
+		{
+			m_lineStarts.push_back(i + __builtin_ctz(mask) + 1);
+			mask &= mask - 1;
+		}
+	}
+#endif
+	AddLineStarts(text, i, length);
+}
+
+void LineIndex::AddLineStarts(const char* text, std::size_t begin, std::size_t end)
+{
+	while (begin < end)
+	{
+		const char* newline = static_cast<const char*>(std::memchr(text + begin, '\n', end - begin));
+		if (newline == NULL)
+		{
+			return;
+		}
+		begin = newline - text + 1;
+		m_lineStarts.push_back(begin);
+	}
+}
+
+void LineIndex::Clear()
+{
+	m_lineStarts.clear();
+}
+
+bool LineIndex::IsBuilt() const
+{
+	return !m_lineStarts.empty();
+}
+
+std::size_t LineIndex::GetNumberOfLines() const
+{
+	return m_lineStarts.size();
+}
+
+void LineIndex::GetPosition(std::size_t offset, std::size_t& line, std::size_t& column) const
+{
+	std::vector<std::size_t>::const_iterator it =
+		std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), offset);
+	std::size_t lineIndex = it - m_lineStarts.begin() - 1;
+
+	line = lineIndex + 1;
+	column = offset - m_lineStarts[lineIndex] + 1;
+}
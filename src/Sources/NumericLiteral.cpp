@@ -0,0 +1,93 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/NumericLiteral.hpp"
+
+#include <charconv>
+#include <system_error>
+
+bool DecodeNumericLiteral(const char* text, std::size_t length, NumericLiteral& literal)
+{
+	literal.isFloating = false;
+	literal.radix = 10;
+	literal.flags = 0;
+	literal.integerValue = 0;
+	literal.floatingValue = 0;
+
+	const char* begin = text;
+	const char* end = text + length;
+	if (length > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
+	{
+		literal.radix = 16;
+		begin += 2;
+	}
+	else if (length > 2 && text[0] == '0' && (text[1] == 'b' || text[1] == 'B'))
+	{
+		literal.radix = 2;
+		begin += 2;
+	}
+	for (const char* current = begin; current != end; ++current)
+	{
+		if (*current == '.' ||
+			(literal.radix == 10 && (*current == 'e' || *current == 'E')) ||
+			(literal.radix == 16 && (*current == 'p' || *current == 'P')))
+		{
+			literal.isFloating = true;
+			break;
+		}
+	}
+
+	if (literal.isFloating)
+	{
+		if (end != begin && (end[-1] == 'f' || end[-1] == 'F'))
+		{
+			literal.flags |= NumericLiteral::FLOAT_SUFFIX;
+			--end;
+		}
+		else if (end != begin && (end[-1] == 'l' || end[-1] == 'L'))
+		{
+			literal.flags |= NumericLiteral::LONG_SUFFIX;
+			--end;
+		}
+		std::from_chars_result result = std::from_chars(begin, end, literal.floatingValue,
+			literal.radix == 16 ? std::chars_format::hex : std::chars_format::general);
+		if (result.ec == std::errc::result_out_of_range)
+		{
+			literal.flags |= NumericLiteral::OUT_OF_RANGE;
+			return true;
+		}
+		return result.ec == std::errc() && result.ptr == end;
+	}
+
+	while (end != begin && (end[-1] == 'u' || end[-1] == 'U' || end[-1] == 'l' || end[-1] == 'L'))
+	{
+		if (end[-1] == 'u' || end[-1] == 'U')
+		{
+			literal.flags |= NumericLiteral::UNSIGNED_SUFFIX;
+		}
+		else if (literal.flags & NumericLiteral::LONG_SUFFIX)
+		{
+			literal.flags = (literal.flags & ~NumericLiteral::LONG_SUFFIX) | NumericLiteral::LONG_LONG_SUFFIX;
+		}
+		else
+		{
+			literal.flags |= NumericLiteral::LONG_SUFFIX;
+		}
+		--end;
+	}
+	if (literal.radix == 10 && end - begin > 1 && *begin == '0')
+	{
+		literal.radix = 8;
+		++begin;
+	}
+	std::from_chars_result result = std::from_chars(begin, end, literal.integerValue, literal.radix);
+	if (result.ec == std::errc::result_out_of_range)
+	{
+		literal.flags |= NumericLiteral::OUT_OF_RANGE;
+		literal.integerValue = ~0ULL;
+		return true;
+	}
+	return result.ec == std::errc() && result.ptr == end;
+}
@@ -0,0 +1,166 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/SourceView.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+SourceView::SourceView(const char* text, std::size_t length)
+	: m_text(text)
+	, m_length(length)
+	, m_logicalEnd(length)
+{
+	Assign(text, length);
+}
+
+void SourceView::Assign(const char* text, std::size_t length)
+{
+	m_text = text;
+	m_length = length;
+	m_splices.clear();
+	FindSplices();
+
+	m_logicalEnd = m_length;
+	for (std::size_t i = m_splices.size(); i > 0 && m_splices[i - 1].end == m_logicalEnd; --i)
+	{
+		m_logicalEnd = m_splices[i - 1].begin;
+	}
+}
+
+void SourceView::FindSplices()
+{
+	const char* current = m_text;
+	const char* end = m_text + m_length;
+	while (current < end)
+	{
+		const char* backslash = static_cast<const char*>(std::memchr(current, '\\', end - current));
+		if (backslash == NULL)
+		{
+			return;
+		}
+		const char* next = backslash + 1;
+		if (next < end && *next == '\r' && next + 1 < end && next[1] == '\n')
+		{
+			++next;
+		}
+		if (next < end && *next == '\n')
+		{
+			Splice splice = { static_cast<std::size_t>(backslash - m_text), static_cast<std::size_t>(next + 1 - m_text) };
+			m_splices.push_back(splice);
+			current = next + 1;
+		}
+		else
+		{
+			current = backslash + 1;
+		}
+	}
+}
+
+const char* SourceView::GetText() const
+{
+	return m_text;
+}
+
+std::size_t SourceView::GetLength() const
+{
+	return m_length;
+}
+
+// Start of the run of splices that ends the buffer; no lexeme begins there.
+std::size_t SourceView::GetLogicalEnd() const
+{
+	return m_logicalEnd;
+}
+
+bool SourceView::HasSplices() const
+{
+	return !m_splices.empty();
+}
+
+std::size_t SourceView::GetNextSplice(std::size_t position, std::size_t& spliceIndex) const
+{
+	while (spliceIndex < m_splices.size() && m_splices[spliceIndex].begin < position)
+	{
+		++spliceIndex;
+	}
+	if (spliceIndex == m_splices.size())
+	{
+		return m_length;
+	}
+	return m_splices[spliceIndex].begin;
+}
+
+std::size_t SourceView::FindSpliceIndex(std::size_t position) const
+{
+	std::size_t low = 0;
+	std::size_t high = m_splices.size();
+	while (low < high)
+	{
+		std::size_t middle = low + (high - low) / 2;
+		if (m_splices[middle].begin < position)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+	return low;
+}
+
+std::size_t SourceView::GetSpliceEnd(std::size_t spliceIndex) const
+{
+	return m_splices[spliceIndex].end;
+}
+
+std::string SourceView::GetLogicalText(std::size_t begin, std::size_t end) const
+{
+	std::string text;
+	GetLogicalText(begin, end, text);
+	return text;
+}
+
+void SourceView::GetLogicalText(std::size_t begin, std::size_t end, std::string& text) const
+{
+	text.clear();
+	text.reserve(end - begin);
+
+	std::size_t spliceIndex = FindSpliceIndex(begin);
+	std::size_t nextSplice = GetNextSplice(begin, spliceIndex);
+	while (begin < end)
+	{
+		if (begin == nextSplice)
+		{
+			begin = m_splices[spliceIndex].end;
+			nextSplice = GetNextSplice(begin, spliceIndex);
+			continue;
+		}
+		std::size_t chunkEnd = std::min(end, nextSplice);
+		text.append(m_text + begin, chunkEnd - begin);
+		begin = chunkEnd;
+	}
+}
+
+bool SourceView::ContainsNewline(std::size_t begin, std::size_t end) const
+{
+	while (begin < end)
+	{
+		const char* newline = static_cast<const char*>(std::memchr(m_text + begin, '\n', end - begin));
+		if (newline == NULL)
+		{
+			return false;
+		}
+		std::size_t newlineOffset = newline - m_text;
+		std::size_t spliceIndex = FindSpliceIndex(newlineOffset > 2 ? newlineOffset - 2 : 0);
+		if (spliceIndex == m_splices.size() || m_splices[spliceIndex].end != newlineOffset + 1)
+		{
+			return true;
+		}
+		begin = newlineOffset + 1;
+	}
+	return false;
+}
@@ -0,0 +1,101 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/SpillFile.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+SpillFile::SpillFile()
+	: m_fileDescriptor(-1)
+	, m_length(0)
+{
+}
+
+SpillFile::~SpillFile()
+{
+	Close();
+}
+
+bool SpillFile::Open(const std::string& directory)
+{
+	Close();
+
+	std::string pathTemplate = directory + "/lexer-spill-XXXXXX";
+	std::vector<char> path(pathTemplate.begin(), pathTemplate.end());
+	path.push_back('\0');
+	m_fileDescriptor = mkstemp(&path[0]);
+	if (m_fileDescriptor == -1)
+	{
+		return false;
+	}
+	unlink(&path[0]);
+	return true;
+}
+
+bool SpillFile::IsOpen() const
+{
+	return m_fileDescriptor != -1;
+}
+
+void SpillFile::Close()
+{
+	if (m_fileDescriptor != -1)
+	{
+		close(m_fileDescriptor);
+		m_fileDescriptor = -1;
+	}
+	m_length = 0;
+}
+
+bool SpillFile::Append(const char* data, std::size_t length)
+{
+	std::size_t written = 0;
+	while (written < length)
+	{
+		ssize_t result = pwrite(m_fileDescriptor, data + written, length - written, m_length + written);
+		if (result <= 0)
+		{
+			return false;
+		}
+		written += result;
+	}
+	m_length += length;
+	return true;
+}
+
+bool SpillFile::Read(unsigned long long offset, char* data, std::size_t length) const
+{
+	std::size_t read = 0;
+	while (read < length)
+	{
+		ssize_t result = pread(m_fileDescriptor, data + read, length - read, offset + read);
+		if (result <= 0)
+		{
+			return false;
+		}
+		read += result;
+	}
+	return true;
+}
+
+unsigned long long SpillFile::GetLength() const
+{
+	return m_length;
+}
+
+void SpillFile::Truncate()
+{
+	if (m_fileDescriptor != -1 && m_length != 0)
+	{
+		if (ftruncate(m_fileDescriptor, 0) == 0)
+		{
+			m_length = 0;
+		}
+	}
+}
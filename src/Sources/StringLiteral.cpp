@@ -0,0 +1,125 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/StringLiteral.hpp"
+
+static int HexadecimalDigitValue(char digit)
+{
+	if (digit >= '0' && digit <= '9') return digit - '0';
+	if (digit >= 'a' && digit <= 'f') return digit - 'a' + 10;
+	if (digit >= 'A' && digit <= 'F') return digit - 'A' + 10;
+	return -1;
+}
+
+static std::size_t EncodeUtf8(unsigned long codePoint, char* output)
+{
+	if (codePoint < 0x80)
+	{
+		output[0] = static_cast<char>(codePoint);
+		return 1;
+	}
+	if (codePoint < 0x800)
+	{
+		output[0] = static_cast<char>(0xC0 | (codePoint >> 6));
+		output[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+		return 2;
+	}
+	if (codePoint < 0x10000)
+	{
+		output[0] = static_cast<char>(0xE0 | (codePoint >> 12));
+		output[1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		output[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+		return 3;
+	}
+	output[0] = static_cast<char>(0xF0 | ((codePoint >> 18) & 0x07));
+	output[1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+	output[2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+	output[3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+	return 4;
+}
+
+std::size_t DecodeEscapeSequences(const char* text, std::size_t length, char* output)
+{
+	std::size_t outputLength = 0;
+	std::size_t i = 0;
+	while (i < length)
+	{
+		if (text[i] != '\\' || i + 1 == length)
+		{
+			output[outputLength++] = text[i++];
+			continue;
+		}
+
+		char escape = text[i + 1];
+		i += 2;
+		switch (escape)
+		{
+		case 'n': output[outputLength++] = '\n'; break;
+		case 't': output[outputLength++] = '\t'; break;
+		case 'r': output[outputLength++] = '\r'; break;
+		case 'a': output[outputLength++] = '\a'; break;
+		case 'b': output[outputLength++] = '\b'; break;
+		case 'f': output[outputLength++] = '\f'; break;
+		case 'v': output[outputLength++] = '\v'; break;
+		case 'e': output[outputLength++] = '\x1B'; break;
+		case 'x':
+		{
+			unsigned int value = 0;
+			std::size_t digits = 0;
+			while (i < length && HexadecimalDigitValue(text[i]) != -1)
+			{
+				value = (value << 4) | HexadecimalDigitValue(text[i]);
+				++i;
+				++digits;
+			}
+			if (digits == 0)
+			{
+				output[outputLength++] = 'x';
+				break;
+			}
+			output[outputLength++] = static_cast<char>(value);
+			break;
+		}
+		case 'u':
+		case 'U':
+		{
+			std::size_t digits = escape == 'u' ? 4 : 8;
+			unsigned long codePoint = 0;
+			std::size_t j = 0;
+			for (; j < digits && i + j < length && HexadecimalDigitValue(text[i + j]) != -1; ++j)
+			{
+				codePoint = (codePoint << 4) | HexadecimalDigitValue(text[i + j]);
+			}
+			// Surrogates and code points past U+10FFFF have no UTF-8 form;
+			// like an incomplete name, they are left undecoded.
+			if (j != digits || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+			{
+				output[outputLength++] = escape;
+				break;
+			}
+			i += digits;
+			outputLength += EncodeUtf8(codePoint, output + outputLength);
+			break;
+		}
+		default:
+			if (escape >= '0' && escape <= '7')
+			{
+				unsigned int value = escape - '0';
+				for (int digits = 1; digits < 3 && i < length && text[i] >= '0' && text[i] <= '7'; ++digits)
+				{
+					value = (value << 3) | (text[i] - '0');
+					++i;
+				}
+				output[outputLength++] = static_cast<char>(value);
+			}
+			else
+			{
+				output[outputLength++] = escape;
+			}
+			break;
+		}
+	}
+	return outputLength;
+}
@@ -0,0 +1,126 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 19.10.2026
+**************************************************************************/
+
+#include "../Headers/StructuralIndex.hpp"
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+StructuralIndex::StructuralIndex()
+	: m_text(NULL)
+	, m_length(0)
+	, m_blockIndex(static_cast<std::size_t>(-1))
+{
+}
+
+void StructuralIndex::Assign(const char* text, std::size_t length)
+{
+	m_text = text;
+	m_length = length;
+	m_blockIndex = static_cast<std::size_t>(-1);
+}
+
+void StructuralIndex::LoadBlock(std::size_t blockIndex)
+{
+	std::size_t blockStart = blockIndex * BLOCK_SIZE;
+	char next = blockStart + BLOCK_SIZE < m_length ? m_text[blockStart + BLOCK_SIZE] : '\0';
+	if (blockStart + BLOCK_SIZE <= m_length)
+	{
+		ClassifyBlock(m_text + blockStart, next, m_block);
+	}
+	else
+	{
+		// The tail is padded with NUL bytes, which only ever stop a search;
+		// Find clamps such positions to the input length.
+		char block[BLOCK_SIZE] = { 0 };
+		std::memcpy(block, m_text + blockStart, m_length - blockStart);
+		ClassifyBlock(block, next, m_block);
+	}
+	m_blockIndex = blockIndex;
+}
+
+#if defined(__SSE2__)
+
+static unsigned long long MatchByte(const __m128i* chunks, char value)
+{
+	const __m128i pattern = _mm_set1_epi8(value);
+	unsigned long long mask = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		mask |= static_cast<unsigned long long>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunks[i], pattern))) << (16 * i);
+	}
+	return mask;
+}
+
+static unsigned long long MatchRange(const __m128i* chunks, char first, char last, char orMask)
+{
+	// Signed compares, so bytes above 0x7F never fall inside an ASCII range.
+	const __m128i lower = _mm_set1_epi8(first - 1);
+	const __m128i upper = _mm_set1_epi8(last + 1);
+	const __m128i fold = _mm_set1_epi8(orMask);
+	unsigned long long mask = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		__m128i folded = _mm_or_si128(chunks[i], fold);
+		__m128i inside = _mm_and_si128(_mm_cmpgt_epi8(folded, lower), _mm_cmplt_epi8(folded, upper));
+		mask |= static_cast<unsigned long long>(_mm_movemask_epi8(inside)) << (16 * i);
+	}
+	return mask;
+}
+
+void StructuralIndex::ClassifyBlock(const char* block, char next, StructuralBlock& classification)
+{
+	__m128i chunks[4];
+	for (int i = 0; i < 4; ++i)
+	{
+		chunks[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+	}
+	unsigned long long newlines = MatchByte(chunks, '\n');
+	unsigned long long nuls = MatchByte(chunks, '\0');
+	unsigned long long doubleQuotes = MatchByte(chunks, '"');
+	unsigned long long slashes = MatchByte(chunks, '/');
+	unsigned long long stars = MatchByte(chunks, '*');
+	unsigned long long backslashes = MatchByte(chunks, '\\');
+
+	classification.whitespace = MatchByte(chunks, ' ') | newlines | MatchByte(chunks, '\t') |
+		MatchByte(chunks, '\r') | MatchByte(chunks, '\b');
+	classification.identifier = MatchRange(chunks, 'a', 'z', 0x20) | MatchRange(chunks, '0', '9', 0) |
+		MatchByte(chunks, '_');
+	classification.quotes = doubleQuotes | MatchByte(chunks, '\'');
+	classification.operators = MatchRange(chunks, '!', '~', 0) & ~classification.identifier & ~classification.quotes;
+	unsigned long long nextOpensComment = next == '/' || next == '*' ? 1ULL << 63 : 0;
+	classification.commentOpeners = slashes & (((slashes | stars) >> 1) | nextOpensComment);
+	classification.stringStops = doubleQuotes | backslashes | newlines | nuls;
+	classification.lineEnds = newlines | nuls;
+	classification.blockCommentStops = stars | nuls;
+}
+
+#else
+
+void StructuralIndex::ClassifyBlock(const char* block, char next, StructuralBlock& classification)
+{
+	std::memset(&classification, 0, sizeof(classification));
+	for (std::size_t i = 0; i < BLOCK_SIZE; ++i)
+	{
+		unsigned char c = static_cast<unsigned char>(block[i]);
+		unsigned char following = static_cast<unsigned char>(i + 1 < BLOCK_SIZE ? block[i + 1] : next);
+		unsigned long long bit = 1ULL << i;
+		bool identifier = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+		bool quote = c == '"' || c == '\'';
+		if (c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\b') classification.whitespace |= bit;
+		if (identifier) classification.identifier |= bit;
+		if (quote) classification.quotes |= bit;
+		if (c >= '!' && c <= '~' && !identifier && !quote) classification.operators |= bit;
+		if (c == '/' && (following == '/' || following == '*')) classification.commentOpeners |= bit;
+		if (c == '"' || c == '\\' || c == '\n' || c == '\0') classification.stringStops |= bit;
+		if (c == '\n' || c == '\0') classification.lineEnds |= bit;
+		if (c == '*' || c == '\0') classification.blockCommentStops |= bit;
+	}
+}
+
+#endif
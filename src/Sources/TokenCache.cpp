@@ -0,0 +1,248 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 18.10.2026
+**************************************************************************/
+
+#include "../Headers/TokenCache.hpp"
+#include "../Headers/Hash.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const unsigned long long EVICTION_INTERVAL = 64;
+static const std::chrono::hours STALE_TEMPORARY_FILE_AGE(1);
+
+TokenCache::TokenCache(const std::string& directory, unsigned long long maximumSize)
+	: m_directory(directory)
+	, m_maximumSize(maximumSize)
+	, m_hits(0)
+	, m_misses(0)
+	, m_writes(0)
+	, m_evictions(0)
+	, m_temporaryFileCounter(0)
+{
+	std::error_code error;
+	std::filesystem::create_directories(m_directory, error);
+}
+
+std::string TokenCache::GetEntryPath(const LexicalAnalyzer& lex, const MappedFile& inputFile) const
+{
+	char entryName[64];
+	std::snprintf(entryName, sizeof(entryName), "%016llx-%016llx.tokens",
+		ComputeHash64(inputFile.GetData(), inputFile.GetLength()), lex.GetConfigurationHash());
+	return m_directory + "/" + entryName;
+}
+
+bool TokenCache::AnalyzeFile(LexicalAnalyzer& lex, const std::string& fileName)
+{
+	MappedFile inputFile;
+	if (!inputFile.Open(fileName))
+	{
+		return false;
+	}
+	std::string entryPath = GetEntryPath(lex, inputFile);
+
+	MappedFile entryFile;
+	if (entryFile.Open(entryPath) &&
+		lex.DeserializeTokens(entryFile.GetData(), entryFile.GetLength(), inputFile.GetData(), inputFile.GetLength()))
+	{
+		// The modification time doubles as the last use time for eviction.
+		utimensat(AT_FDCWD, entryPath.c_str(), NULL, 0);
+		++m_hits;
+		return true;
+	}
+	++m_misses;
+
+	std::size_t firstToken = lex.GetTokens().size();
+	std::size_t firstError = lex.GetErrorCount();
+	if (!lex.AnalyzeBuffer(inputFile.GetData(), inputFile.GetLength()))
+	{
+		return false;
+	}
+	std::string data;
+	lex.SerializeTokens(firstToken, firstError, data);
+	// The first write of a run also evicts, which clears what earlier runs
+	// left behind.
+	if (StoreEntry(entryPath, data) && ++m_writes % EVICTION_INTERVAL == 1)
+	{
+		Evict();
+	}
+	return true;
+}
+
+// The input is lexed again by a separate analyzer configured like `lex`, so
+// verification leaves `lex` untouched.
+bool TokenCache::VerifyFile(const LexicalAnalyzer& lex, const std::string& fileName)
+{
+	MappedFile inputFile;
+	MappedFile entryFile;
+	if (!inputFile.Open(fileName) || !entryFile.Open(GetEntryPath(lex, inputFile)))
+	{
+		return false;
+	}
+
+	LexicalAnalyzer cached;
+	if (!cached.DeserializeTokens(entryFile.GetData(), entryFile.GetLength(), inputFile.GetData(), inputFile.GetLength()))
+	{
+		return false;
+	}
+	LexicalAnalyzer relexed(lex.GetAutomaton());
+	relexed.CopyConfiguration(lex);
+	if (!relexed.AnalyzeBuffer(inputFile.GetData(), inputFile.GetLength()))
+	{
+		return false;
+	}
+
+	const LexicalAnalyzer::Tokens& tokens = relexed.GetTokens();
+	const LexicalAnalyzer::Tokens& cachedTokens = cached.GetTokens();
+	if (tokens.size() != cachedTokens.size() || relexed.GetErrorCount() != cached.GetErrorCount())
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < cachedTokens.size(); ++i)
+	{
+		const LexicalAnalyzer::Token& token = tokens[i];
+		const LexicalAnalyzer::Token& cachedToken = cachedTokens[i];
+		if (token.offset != cachedToken.offset ||
+			token.lexeme->first != cachedToken.lexeme->first ||
+			token.lexeme->second.first != cachedToken.lexeme->second.first)
+		{
+			return false;
+		}
+	}
+	for (std::size_t i = 0; i < cached.GetErrorCount(); ++i)
+	{
+		const LexicalAnalyzer::LexicalError& error = relexed.GetErrors()[i];
+		const LexicalAnalyzer::LexicalError& cachedError = cached.GetErrors()[i];
+		if (error.offset != cachedError.offset || error.length != cachedError.length)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool TokenCache::StoreEntry(const std::string& entryPath, const std::string& data)
+{
+	char temporaryName[96];
+	std::snprintf(temporaryName, sizeof(temporaryName), "/.tmp-%ld-%llu",
+		static_cast<long>(getpid()), static_cast<unsigned long long>(m_temporaryFileCounter++));
+	std::string temporaryPath = m_directory + temporaryName;
+
+	int fileDescriptor = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+	if (fileDescriptor == -1)
+	{
+		return false;
+	}
+	std::size_t written = 0;
+	while (written < data.length())
+	{
+		ssize_t result = write(fileDescriptor, data.data() + written, data.length() - written);
+		if (result <= 0)
+		{
+			close(fileDescriptor);
+			unlink(temporaryPath.c_str());
+			return false;
+		}
+		written += result;
+	}
+	// The data must be on disk before the rename makes the entry visible, or
+	// a crash can leave a published entry with missing contents.
+	if (fsync(fileDescriptor) != 0 || close(fileDescriptor) != 0)
+	{
+		unlink(temporaryPath.c_str());
+		return false;
+	}
+
+	if (rename(temporaryPath.c_str(), entryPath.c_str()) != 0)
+	{
+		unlink(temporaryPath.c_str());
+		return false;
+	}
+	return true;
+}
+
+void TokenCache::Evict()
+{
+	std::vector<std::tuple<std::filesystem::file_time_type, unsigned long long, std::string> > entries;
+	unsigned long long totalSize = 0;
+	std::filesystem::file_time_type staleTime = std::filesystem::file_time_type::clock::now() - STALE_TEMPORARY_FILE_AGE;
+	std::error_code error;
+	for (
+		std::filesystem::directory_iterator it(m_directory, error);
+		it != std::filesystem::directory_iterator();
+		it.increment(error)
+		)
+	{
+		if (error)
+		{
+			break;
+		}
+		if (it->path().filename().string().compare(0, 5, ".tmp-") == 0)
+		{
+			// Left behind by a writer that died before renaming it; live
+			// writers rename theirs well within the age limit.
+			std::filesystem::file_time_type lastWrite = it->last_write_time(error);
+			if (!error && lastWrite < staleTime)
+			{
+				unlink(it->path().c_str());
+			}
+			error.clear();
+			continue;
+		}
+		if (it->path().extension() != ".tokens")
+		{
+			continue;
+		}
+		unsigned long long size = it->file_size(error);
+		std::filesystem::file_time_type lastUse = it->last_write_time(error);
+		if (error)
+		{
+			// Removed concurrently by another process.
+			error.clear();
+			continue;
+		}
+		entries.push_back(std::make_tuple(lastUse, size, it->path().string()));
+		totalSize += size;
+	}
+	if (totalSize <= m_maximumSize)
+	{
+		return;
+	}
+
+	std::sort(entries.begin(), entries.end());
+	unsigned long long targetSize = m_maximumSize - m_maximumSize / 10;
+	for (std::size_t i = 0; i < entries.size() && totalSize > targetSize; ++i)
+	{
+		if (unlink(std::get<2>(entries[i]).c_str()) == 0)
+		{
+			++m_evictions;
+		}
+		totalSize -= std::get<1>(entries[i]);
+	}
+}
+
+unsigned long long TokenCache::GetHits() const
+{
+	return m_hits;
+}
+
+unsigned long long TokenCache::GetMisses() const
+{
+	return m_misses;
+}
+
+void TokenCache::DisplayStatistics()
+{
+	std::cout << "Cache hits: " << m_hits << ", misses: " << m_misses <<
+			", writes: " << m_writes << ", evictions: " << m_evictions << '\n';
+}
@@ -0,0 +1,138 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 19.10.2026
+**************************************************************************/
+
+#include "../Headers/TraceRecorder.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+static void AppendJsonString(std::string& output, const std::string& text)
+{
+	output += '"';
+	for (std::string::const_iterator it = text.begin(); it != text.end(); ++it)
+	{
+		unsigned char character = static_cast<unsigned char>(*it);
+		if (character == '"' || character == '\\')
+		{
+			output += '\\';
+			output += *it;
+		}
+		else if (character < 0x20)
+		{
+			char escape[8];
+			std::snprintf(escape, sizeof(escape), "\\u%04x", character);
+			output += escape;
+		}
+		else
+		{
+			output += *it;
+		}
+	}
+	output += '"';
+}
+
+static void AppendMicroseconds(std::string& output, long long nanoseconds)
+{
+	char number[32];
+	std::snprintf(number, sizeof(number), "%.3f", nanoseconds / 1000.0);
+	output += number;
+}
+
+TraceRecorder::TraceRecorder()
+	: m_threadId(0)
+{
+}
+
+void TraceRecorder::SetThread(unsigned int threadId, const std::string& threadName)
+{
+	m_threadId = threadId;
+	m_threadName = threadName;
+}
+
+void TraceRecorder::AddSpan(const char* name, long long begin, long long end, std::size_t fileIndex)
+{
+	TraceEvent event = { name, begin, end, fileIndex, false };
+	m_events.push_back(event);
+}
+
+void TraceRecorder::AddOverlappingSpan(const char* name, long long begin, long long end, std::size_t fileIndex)
+{
+	TraceEvent event = { name, begin, end, fileIndex, true };
+	m_events.push_back(event);
+}
+
+void TraceRecorder::Clear()
+{
+	m_events.clear();
+}
+
+bool TraceRecorder::Write(
+	const std::vector<const TraceRecorder*>& recorders,
+	const std::vector<std::string>& fileNames,
+	long long origin,
+	const std::string& traceFileName
+	)
+{
+	std::ofstream output(traceFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!output)
+	{
+		return false;
+	}
+
+	std::string buffer = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	for (std::vector<const TraceRecorder*>::const_iterator it = recorders.begin(); it != recorders.end(); ++it)
+	{
+		const TraceRecorder* recorder = *it;
+		std::string threadId = std::to_string(recorder->m_threadId);
+		buffer += first ? "\n" : ",\n";
+		first = false;
+		buffer += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + threadId + ",\"args\":{\"name\":";
+		AppendJsonString(buffer, recorder->m_threadName);
+		buffer += "}}";
+
+		for (std::vector<TraceEvent>::const_iterator event = recorder->m_events.begin(); event != recorder->m_events.end(); ++event)
+		{
+			std::string arguments;
+			if (event->fileIndex != NO_FILE && event->fileIndex < fileNames.size())
+			{
+				arguments = ",\"args\":{\"file\":";
+				AppendJsonString(arguments, fileNames[event->fileIndex]);
+				arguments += '}';
+			}
+			std::string common = "{\"name\":";
+			AppendJsonString(common, event->name);
+			common += ",\"cat\":\"batch\",\"pid\":1,\"tid\":" + threadId;
+
+			if (event->overlapping)
+			{
+				// Async begin and end events pair up by id.
+				std::string id = ",\"id\":" + std::to_string(event->fileIndex);
+				buffer += ",\n" + common + id + ",\"ph\":\"b\",\"ts\":";
+				AppendMicroseconds(buffer, event->begin - origin);
+				buffer += arguments + "},\n" + common + id + ",\"ph\":\"e\",\"ts\":";
+				AppendMicroseconds(buffer, event->end - origin);
+				buffer += '}';
+			}
+			else
+			{
+				buffer += ",\n" + common + ",\"ph\":\"X\",\"ts\":";
+				AppendMicroseconds(buffer, event->begin - origin);
+				buffer += ",\"dur\":";
+				AppendMicroseconds(buffer, event->end - event->begin);
+				buffer += arguments + '}';
+			}
+
+			if (buffer.length() >= 1 << 16)
+			{
+				output.write(buffer.data(), buffer.length());
+				buffer.clear();
+			}
+		}
+	}
+	buffer += "\n]}\n";
+	output.write(buffer.data(), buffer.length());
+	return static_cast<bool>(output.flush());
+}
@@ -0,0 +1,227 @@
+/**************************************************************************
+Author: Stefan Rapeanu-Andreescu
+Creation date: 19.10.2026
+**************************************************************************/
+
+#include "../Headers/Utf8.hpp"
+
+#include <cstring>
+
+// The SSSE3 kernel is compiled for its own target and chosen at run time,
+// so the default x86-64 build (SSE2 only) still uses it where available.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define UTF8_SSSE3_KERNEL
+#define SSSE3_TARGET __attribute__((target("ssse3")))
+#include <tmmintrin.h>
+#endif
+
+std::size_t GetUtf8SequenceLength(const char* text, std::size_t length, std::size_t position)
+{
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text) + position;
+	std::size_t remaining = length - position;
+	unsigned char lead = bytes[0];
+	if (lead < 0x80)
+	{
+		return 1;
+	}
+
+	std::size_t sequenceLength;
+	unsigned char secondMinimum = 0x80;
+	unsigned char secondMaximum = 0xBF;
+	if (lead >= 0xC2 && lead <= 0xDF)
+	{
+		sequenceLength = 2;
+	}
+	else if (lead >= 0xE0 && lead <= 0xEF)
+	{
+		sequenceLength = 3;
+		if (lead == 0xE0) secondMinimum = 0xA0;
+		if (lead == 0xED) secondMaximum = 0x9F;
+	}
+	else if (lead >= 0xF0 && lead <= 0xF4)
+	{
+		sequenceLength = 4;
+		if (lead == 0xF0) secondMinimum = 0x90;
+		if (lead == 0xF4) secondMaximum = 0x8F;
+	}
+	else
+	{
+		return 0;
+	}
+
+	if (remaining < sequenceLength || bytes[1] < secondMinimum || bytes[1] > secondMaximum)
+	{
+		return 0;
+	}
+	for (std::size_t i = 2; i < sequenceLength; ++i)
+	{
+		if ((bytes[i] & 0xC0) != 0x80)
+		{
+			return 0;
+		}
+	}
+	return sequenceLength;
+}
+
+static std::size_t FindInvalidUtf8Scalar(const char* text, std::size_t position, std::size_t length)
+{
+	while (position < length)
+	{
+		std::size_t sequenceLength = GetUtf8SequenceLength(text, length, position);
+		if (sequenceLength == 0)
+		{
+			return position;
+		}
+		position += sequenceLength;
+	}
+	return length;
+}
+
+#if defined(UTF8_SSSE3_KERNEL)
+
+// Lookup-table validation over 16-byte blocks: every byte pair is classified
+// by three table lookups (high and low nibble of the previous byte, high
+// nibble of the current one) whose intersection flags the invalid
+// combinations, and the positions that must be third or fourth continuation
+// bytes are checked against the previous two and three bytes.
+static const unsigned char TOO_SHORT = 1 << 0;
+static const unsigned char TOO_LONG = 1 << 1;
+static const unsigned char OVERLONG_3 = 1 << 2;
+static const unsigned char TOO_LARGE = 1 << 3;
+static const unsigned char SURROGATE = 1 << 4;
+static const unsigned char OVERLONG_2 = 1 << 5;
+static const unsigned char TOO_LARGE_1000 = 1 << 6;
+static const unsigned char OVERLONG_4 = 1 << 6;
+static const unsigned char TWO_CONTINUATIONS = 1 << 7;
+static const unsigned char CARRY = TOO_SHORT | TOO_LONG | TWO_CONTINUATIONS;
+
+SSSE3_TARGET static __m128i ClassifyBlock(__m128i input, __m128i previousInput)
+{
+	const __m128i firstHighTable = _mm_setr_epi8(
+		TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+		TWO_CONTINUATIONS, TWO_CONTINUATIONS, TWO_CONTINUATIONS, TWO_CONTINUATIONS,
+		TOO_SHORT | OVERLONG_2,
+		TOO_SHORT,
+		TOO_SHORT | OVERLONG_3 | SURROGATE,
+		TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+	const __m128i firstLowTable = _mm_setr_epi8(
+		CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+		CARRY | OVERLONG_2,
+		CARRY,
+		CARRY,
+		CARRY | TOO_LARGE,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000);
+	const __m128i secondHighTable = _mm_setr_epi8(
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+		TOO_LONG | OVERLONG_2 | TWO_CONTINUATIONS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+		TOO_LONG | OVERLONG_2 | TWO_CONTINUATIONS | OVERLONG_3 | TOO_LARGE,
+		TOO_LONG | OVERLONG_2 | TWO_CONTINUATIONS | SURROGATE | TOO_LARGE,
+		TOO_LONG | OVERLONG_2 | TWO_CONTINUATIONS | SURROGATE | TOO_LARGE,
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+	const __m128i lowNibble = _mm_set1_epi8(0x0F);
+
+	__m128i previous1 = _mm_alignr_epi8(input, previousInput, 15);
+	__m128i firstHigh = _mm_shuffle_epi8(firstHighTable, _mm_and_si128(_mm_srli_epi16(previous1, 4), lowNibble));
+	__m128i firstLow = _mm_shuffle_epi8(firstLowTable, _mm_and_si128(previous1, lowNibble));
+	__m128i secondHigh = _mm_shuffle_epi8(secondHighTable, _mm_and_si128(_mm_srli_epi16(input, 4), lowNibble));
+	__m128i special = _mm_and_si128(_mm_and_si128(firstHigh, firstLow), secondHigh);
+
+	__m128i previous2 = _mm_alignr_epi8(input, previousInput, 14);
+	__m128i previous3 = _mm_alignr_epi8(input, previousInput, 13);
+	__m128i thirdByte = _mm_subs_epu8(previous2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+	__m128i fourthByte = _mm_subs_epu8(previous3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+	__m128i mustBeContinuation = _mm_and_si128(_mm_or_si128(thirdByte, fourthByte), _mm_set1_epi8(static_cast<char>(0x80)));
+	return _mm_xor_si128(mustBeContinuation, special);
+}
+
+SSSE3_TARGET static __m128i GetIncompleteTail(__m128i input)
+{
+	// Non-zero where a lead byte in the last three positions still expects
+	// continuation bytes from the next block.
+	const __m128i maximumComplete = _mm_setr_epi8(
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+	return _mm_subs_epu8(input, maximumComplete);
+}
+
+// Everything before position is known to be valid except possibly a
+// sequence cut short at the end, which starts at most three bytes earlier.
+static std::size_t FindSequenceStart(const char* text, std::size_t position)
+{
+	std::size_t sequenceStart = position >= 3 ? position - 3 : 0;
+	while (sequenceStart < position && (static_cast<unsigned char>(text[sequenceStart]) & 0xC0) == 0x80)
+	{
+		++sequenceStart;
+	}
+	return sequenceStart;
+}
+
+SSSE3_TARGET static std::size_t FindInvalidUtf8Ssse3(const char* text, std::size_t length)
+{
+	__m128i previousInput = _mm_setzero_si128();
+	__m128i previousIncomplete = _mm_setzero_si128();
+	std::size_t position = 0;
+	while (position < length)
+	{
+		__m128i input;
+		if (position + 16 <= length)
+		{
+			input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + position));
+		}
+		else
+		{
+			// Zero padding is ASCII, so a sequence cut by the end of the text
+			// is reported like any other truncated sequence.
+			char block[16] = { 0 };
+			std::memcpy(block, text + position, length - position);
+			input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+		}
+
+		__m128i error;
+		if (_mm_movemask_epi8(input) == 0)
+		{
+			error = previousIncomplete;
+			previousIncomplete = _mm_setzero_si128();
+		}
+		else
+		{
+			error = ClassifyBlock(input, previousInput);
+			previousIncomplete = GetIncompleteTail(input);
+		}
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF)
+		{
+			return FindInvalidUtf8Scalar(text, FindSequenceStart(text, position), length);
+		}
+		previousInput = input;
+		position += 16;
+	}
+	if (_mm_movemask_epi8(_mm_cmpeq_epi8(previousIncomplete, _mm_setzero_si128())) != 0xFFFF)
+	{
+		return FindInvalidUtf8Scalar(text, FindSequenceStart(text, length), length);
+	}
+	return length;
+}
+
+#endif
+
+std::size_t FindInvalidUtf8(const char* text, std::size_t length)
+{
+#if defined(UTF8_SSSE3_KERNEL)
+	static const bool hasSsse3 = __builtin_cpu_supports("ssse3");
+	if (hasSsse3)
+	{
+		return FindInvalidUtf8Ssse3(text, length);
+	}
+#endif
+	return FindInvalidUtf8Scalar(text, 0, length);
+}